@@ -89,7 +89,10 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 		MutexLock lock(ResourceCache::lock);
 
 		if (!path_cache.is_empty()) {
-			ResourceCache::resources.erase(path_cache);
+			// Once unlisted, lookups must not see this resource anymore when it gets deleted.
+			if (ResourceCache::resources.erase(path_cache)) {
+				ResourceCache::resources.synchronize(path_cache);
+			}
 		}
 
 		path_cache = "";
@@ -100,6 +103,7 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 			if (p_take_over) {
 				existing->path_cache = String();
 				ResourceCache::resources.erase(p_path);
+				ResourceCache::resources.synchronize(p_path);
 			} else {
 				ERR_FAIL_MSG(vformat("Another resource is loaded from path '%s' (possible cyclic resource inclusion).", p_path));
 			}
@@ -108,7 +112,7 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 		path_cache = p_path;
 
 		if (!path_cache.is_empty()) {
-			ResourceCache::resources[path_cache] = this;
+			ResourceCache::resources.insert(path_cache, this);
 		}
 	}
 
@@ -792,16 +796,20 @@ Resource::~Resource() {
 		return;
 	}
 
-	MutexLock lock(ResourceCache::lock);
-	// Only unregister from the cache if this is the actual resource listed there.
-	// (Other resources can have the same value in `path_cache` if loaded with `CACHE_IGNORE`.)
-	HashMap<String, Resource *>::Iterator E = ResourceCache::resources.find(path_cache);
-	if (likely(E && E->value == this)) {
-		ResourceCache::resources.remove(E);
+	bool was_cached = false;
+	{
+		MutexLock lock(ResourceCache::lock);
+		// Only unregister from the cache if this is the actual resource listed there.
+		// (Other resources can have the same value in `path_cache` if loaded with `CACHE_IGNORE`.)
+		was_cached = ResourceCache::resources.erase_if(path_cache, [this](Resource *p_resource) { return p_resource == this; });
+	}
+	if (was_cached) {
+		// Lookups which found this resource before it was unlisted may still be trying to reference it.
+		ResourceCache::resources.synchronize(path_cache);
 	}
 }
 
-HashMap<String, Resource *> ResourceCache::resources;
+ConcurrentHashMap<String, Resource *> ResourceCache::resources;
 #ifdef TOOLS_ENABLED
 HashMap<String, HashMap<String, String>> ResourceCache::resource_path_cache;
 #endif
@@ -815,9 +823,9 @@ void ResourceCache::clear() {
 	if (!resources.is_empty()) {
 		if (OS::get_singleton()->is_stdout_verbose()) {
 			ERR_PRINT(vformat("%d resources still in use at exit.", resources.size()));
-			for (const KeyValue<String, Resource *> &E : resources) {
-				print_line(vformat("Resource still in use: %s (%s)", E.key, E.value->get_class()));
-			}
+			resources.for_each([](const String &p_path, Resource *p_resource) {
+				print_line(vformat("Resource still in use: %s (%s)", p_path, p_resource->get_class()));
+			});
 		} else {
 			ERR_PRINT(vformat("%d resources still in use at exit (run with --verbose for details).", resources.size()));
 		}
@@ -826,74 +834,35 @@ void ResourceCache::clear() {
 	resources.clear();
 }
 
-bool ResourceCache::has(const String &p_path) {
-	Resource **res = nullptr;
-
-	{
-		MutexLock mutex_lock(lock);
-
-		res = resources.getptr(p_path);
-
-		if (res && (*res)->get_reference_count() == 0) {
-			// This resource is in the process of being deleted, ignore its existence.
-			(*res)->path_cache = String();
-			resources.erase(p_path);
-			res = nullptr;
-		}
-	}
-
-	if (!res) {
-		return false;
-	}
+// Lookups don't lock. A resource whose destructor is running can still be listed
+// until it unregisters itself; it can't be referenced anymore, so it's ignored.
+// Its memory stays valid meanwhile, as the destructor synchronizes with lookups.
 
-	return true;
+bool ResourceCache::has(const String &p_path) {
+	return resources.read(p_path, [](Resource *p_resource) {
+		return p_resource->get_reference_count() > 0;
+	});
 }
 
 Ref<Resource> ResourceCache::get_ref(const String &p_path) {
 	Ref<Resource> ref;
-	{
-		MutexLock mutex_lock(lock);
-		Resource **res = resources.getptr(p_path);
-
-		if (res) {
-			ref = Ref<Resource>(*res);
-		}
-
-		if (res && ref.is_null()) {
-			// This resource is in the process of being deleted, ignore its existence
-			(*res)->path_cache = String();
-			resources.erase(p_path);
-			res = nullptr;
-		}
-	}
-
+	resources.read(p_path, [&ref](Resource *p_resource) {
+		ref = Ref<Resource>(p_resource);
+		return ref.is_valid();
+	});
 	return ref;
 }
 
 void ResourceCache::get_cached_resources(List<Ref<Resource>> *p_resources) {
-	MutexLock mutex_lock(lock);
-
-	LocalVector<String> to_remove;
-
-	for (KeyValue<String, Resource *> &E : resources) {
-		Ref<Resource> ref = Ref<Resource>(E.value);
-
-		if (ref.is_null()) {
-			// This resource is in the process of being deleted, ignore its existence
-			E.value->path_cache = String();
-			to_remove.push_back(E.key);
-			continue;
+	// Resources can't finish unregistering while their shard is being iterated.
+	resources.for_each([p_resources](const String &p_path, Resource *p_resource) {
+		Ref<Resource> ref = Ref<Resource>(p_resource);
+		if (ref.is_valid()) {
+			p_resources->push_back(ref);
 		}
-
-		p_resources->push_back(ref);
-	}
-
-	for (const String &E : to_remove) {
-		resources.erase(E);
-	}
+	});
 }
 
 int ResourceCache::get_cached_resource_count() {
-	MutexLock mutex_lock(lock);
 	return resources.size();
 }
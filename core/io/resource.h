@@ -33,6 +33,7 @@
 #include "core/io/resource_uid.h" // IWYU pragma: export. Make available to all resources.
 #include "core/object/gdvirtual.gen.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/concurrent_hash_map.h"
 #include "core/templates/self_list.h"
 
 class Node;
@@ -197,8 +198,8 @@ VARIANT_ENUM_CAST(Resource::DeepDuplicateMode);
 class ResourceCache {
 	friend class Resource;
 	friend class ResourceLoader; // Need the lock.
-	static Mutex lock;
-	static HashMap<String, Resource *> resources;
+	static Mutex lock; // Serializes changes to the cache. Lookups don't need it.
+	static ConcurrentHashMap<String, Resource *> resources;
 #ifdef TOOLS_ENABLED
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
@@ -76,6 +76,71 @@ public:
 	virtual uint32_t hash() const;
 };
 
+// Typed calls are available when every parameter (and the return value) has a
+// ptrcall encoding that Variant storage can be passed as, see PtrToArgVariantType.
+template <typename R, typename... P>
+constexpr bool callable_mp_supports_ptrcall() {
+	return (std::is_void_v<R> || PtrToArgVariantType<R>::VARIANT_TYPE != Variant::VARIANT_MAX) && ((PtrToArgVariantType<P>::VARIANT_TYPE != Variant::VARIANT_MAX) && ...);
+}
+
+template <typename... P>
+bool callable_mp_get_ptrcall_arguments(const Variant **p_arguments, int p_argcount, const void **r_pointers) {
+	static constexpr Variant::Type types[sizeof...(P) + 1] = { PtrToArgVariantType<P>::VARIANT_TYPE..., Variant::NIL };
+	if (p_argcount != (int)sizeof...(P)) {
+		return false;
+	}
+	for (int i = 0; i < p_argcount; i++) {
+		if (types[i] == Variant::NIL) {
+			r_pointers[i] = p_arguments[i];
+		} else if (p_arguments[i]->get_type() == types[i]) {
+			r_pointers[i] = VariantInternal::get_opaque_pointer(p_arguments[i]);
+		} else {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Arguments encoded for CallableCustom::ptrcall() by a caller whose native types match
+// the target's signature, see Callable::call_typed().
+template <typename... P>
+struct CallablePtrcallArguments;
+
+template <>
+struct CallablePtrcallArguments<> {
+	void get_pointers(const void **r_pointers) const {}
+};
+
+template <typename P, typename... Rest>
+struct CallablePtrcallArguments<P, Rest...> {
+	typename PtrToArg<P>::EncodeT value;
+	CallablePtrcallArguments<Rest...> rest;
+
+	void get_pointers(const void **r_pointers) const {
+		r_pointers[0] = &value;
+		rest.get_pointers(r_pointers + 1);
+	}
+
+	CallablePtrcallArguments(const P &p_arg, const Rest &...p_rest) :
+			rest(p_rest...) {
+		PtrToArg<P>::encode(p_arg, &value);
+	}
+};
+
+template <typename... Args>
+void Callable::call_typed(const Args &...p_args) const {
+	if constexpr (callable_mp_supports_ptrcall<void, Args...>()) {
+		if (get_ptrcall_signature() == CallablePtrcallSignature<std::decay_t<Args>...>::get() && is_valid()) {
+			const CallablePtrcallArguments<std::decay_t<Args>...> arguments(p_args...);
+			const void *argptrs[sizeof...(Args) + 1];
+			arguments.get_pointers(argptrs);
+			ptrcallp(argptrs, nullptr);
+			return;
+		}
+	}
+	call(p_args...);
+}
+
 template <typename T, typename R, typename... P>
 class CallableCustomMethodPointer : public CallableCustomMethodPointerBase {
 	struct Data {
@@ -106,6 +171,39 @@ public:
 		}
 	}
 
+	virtual bool get_ptrcall_arguments(const Variant **p_arguments, int p_argcount, const void **r_pointers) const {
+		if constexpr (callable_mp_supports_ptrcall<R, P...>()) {
+			return callable_mp_get_ptrcall_arguments<P...>(p_arguments, p_argcount, r_pointers);
+		} else {
+			return false;
+		}
+	}
+
+	virtual const void *get_ptrcall_signature() const {
+		if constexpr (callable_mp_supports_ptrcall<R, P...>()) {
+			return CallablePtrcallSignature<std::decay_t<P>...>::get();
+		} else {
+			return nullptr;
+		}
+	}
+
+	virtual void ptrcall(const void **p_arguments, void *r_return_value) const {
+		if constexpr (!callable_mp_supports_ptrcall<R, P...>()) {
+			CallableCustom::ptrcall(p_arguments, r_return_value);
+		} else if constexpr (std::is_void_v<R>) {
+			ERR_FAIL_NULL_MSG(ObjectDB::get_instance(ObjectID(data.object_id)), "Invalid Object id '" + uitos(data.object_id) + "', can't call method.");
+			call_with_ptr_args(data.instance, data.method, p_arguments);
+		} else {
+			ERR_FAIL_NULL_MSG(ObjectDB::get_instance(ObjectID(data.object_id)), "Invalid Object id '" + uitos(data.object_id) + "', can't call method.");
+			if (r_return_value) {
+				call_with_ptr_args_ret(data.instance, data.method, p_arguments, r_return_value);
+			} else {
+				typename PtrToArg<R>::EncodeT ret;
+				call_with_ptr_args_ret(data.instance, data.method, p_arguments, &ret);
+			}
+		}
+	}
+
 	CallableCustomMethodPointer(T *p_instance, R (T::*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -175,6 +273,39 @@ public:
 		}
 	}
 
+	virtual bool get_ptrcall_arguments(const Variant **p_arguments, int p_argcount, const void **r_pointers) const override {
+		if constexpr (callable_mp_supports_ptrcall<R, P...>()) {
+			return callable_mp_get_ptrcall_arguments<P...>(p_arguments, p_argcount, r_pointers);
+		} else {
+			return false;
+		}
+	}
+
+	virtual const void *get_ptrcall_signature() const override {
+		if constexpr (callable_mp_supports_ptrcall<R, P...>()) {
+			return CallablePtrcallSignature<std::decay_t<P>...>::get();
+		} else {
+			return nullptr;
+		}
+	}
+
+	virtual void ptrcall(const void **p_arguments, void *r_return_value) const override {
+		if constexpr (!callable_mp_supports_ptrcall<R, P...>()) {
+			CallableCustom::ptrcall(p_arguments, r_return_value);
+		} else if constexpr (std::is_void_v<R>) {
+			ERR_FAIL_NULL_MSG(ObjectDB::get_instance(ObjectID(data.object_id)), "Invalid Object id '" + uitos(data.object_id) + "', can't call method.");
+			call_with_ptr_argsc(data.instance, data.method, p_arguments);
+		} else {
+			ERR_FAIL_NULL_MSG(ObjectDB::get_instance(ObjectID(data.object_id)), "Invalid Object id '" + uitos(data.object_id) + "', can't call method.");
+			if (r_return_value) {
+				call_with_ptr_args_retc(data.instance, data.method, p_arguments, r_return_value);
+			} else {
+				typename PtrToArg<R>::EncodeT ret;
+				call_with_ptr_args_retc(data.instance, data.method, p_arguments, &ret);
+			}
+		}
+	}
+
 	CallableCustomMethodPointerC(T *p_instance, R (T::*p_method)(P...) const) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -248,6 +379,37 @@ public:
 		}
 	}
 
+	virtual bool get_ptrcall_arguments(const Variant **p_arguments, int p_argcount, const void **r_pointers) const override {
+		if constexpr (callable_mp_supports_ptrcall<R, P...>()) {
+			return callable_mp_get_ptrcall_arguments<P...>(p_arguments, p_argcount, r_pointers);
+		} else {
+			return false;
+		}
+	}
+
+	virtual const void *get_ptrcall_signature() const override {
+		if constexpr (callable_mp_supports_ptrcall<R, P...>()) {
+			return CallablePtrcallSignature<std::decay_t<P>...>::get();
+		} else {
+			return nullptr;
+		}
+	}
+
+	virtual void ptrcall(const void **p_arguments, void *r_return_value) const override {
+		if constexpr (!callable_mp_supports_ptrcall<R, P...>()) {
+			CallableCustom::ptrcall(p_arguments, r_return_value);
+		} else if constexpr (std::is_void_v<R>) {
+			call_with_ptr_args_static_method(data.method, p_arguments);
+		} else {
+			if (r_return_value) {
+				call_with_ptr_args_static_method_ret(data.method, p_arguments, r_return_value);
+			} else {
+				typename PtrToArg<R>::EncodeT ret;
+				call_with_ptr_args_static_method_ret(data.method, p_arguments, &ret);
+			}
+		}
+	}
+
 	CallableCustomStaticMethodPointer(R (*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.method = p_method;
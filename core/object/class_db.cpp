@@ -952,6 +952,8 @@ void ClassDB::_add_class(GDType &p_class, const GDType *p_inherits) {
 	} else {
 		ti.inherits_ptr = nullptr;
 	}
+
+	_invalidate_resolution_cache();
 }
 
 static MethodInfo info_from_bind(const MethodBind *p_method) {
@@ -1117,37 +1119,60 @@ Vector<uint32_t> ClassDB::get_method_compatibility_hashes(const StringName &p_cl
 	return Vector<uint32_t>();
 }
 
-const MethodBind *ClassDB::get_method_with_compatibility(const StringName &p_class, const StringName &p_name, uint64_t p_hash, bool *r_method_exists, bool *r_is_deprecated) {
-	Locker::Lock lock(Locker::STATE_READ);
+const LocalVector<ClassDB::ClassInfo::ResolvedMethod> *ClassDB::_get_resolved_methods(ClassInfo *p_type, const StringName &p_name) {
+	// Called with the ClassDB read lock held, so concurrent readers may be filling the cache.
+	MutexLock lock(resolution_cache_mutex);
 
-	ClassInfo *type = classes.getptr(p_class);
+	const uint32_t version = resolution_version.get();
+	if (p_type->resolved_methods_version != version) {
+		p_type->resolved_methods.clear();
+		p_type->resolved_methods_version = version;
+	}
 
-	while (type) {
+	HashMap<StringName, LocalVector<ClassInfo::ResolvedMethod>>::Iterator E = p_type->resolved_methods.find(p_name);
+	if (E) {
+		return &E->value;
+	}
+
+	LocalVector<ClassInfo::ResolvedMethod> resolved;
+	for (ClassInfo *type = p_type; type; type = type->inherits_ptr) {
 		const MethodBind *const *method = type->gdtype->get_method_map(true).getptr(p_name);
 		if (method) {
-			if (r_method_exists) {
-				*r_method_exists = true;
-			}
-			if ((*method)->get_hash() == p_hash) {
-				return *method;
-			}
+			resolved.push_back({ *method, false });
 		}
 
-		LocalVector<MethodBind *> *compat = type->method_map_compatibility.getptr(p_name);
+		const LocalVector<MethodBind *> *compat = type->method_map_compatibility.getptr(p_name);
 		if (compat) {
-			if (r_method_exists) {
-				*r_method_exists = true;
+			for (const MethodBind *compat_method : *compat) {
+				resolved.push_back({ compat_method, true });
 			}
-			for (uint32_t i = 0; i < compat->size(); i++) {
-				if ((*compat)[i]->get_hash() == p_hash) {
-					if (r_is_deprecated) {
-						*r_is_deprecated = true;
-					}
-					return (*compat)[i];
-				}
+		}
+	}
+
+	// HashMap elements are never moved, so the pointer stays valid until the cache is invalidated.
+	return &p_type->resolved_methods.insert(p_name, resolved)->value;
+}
+
+const MethodBind *ClassDB::get_method_with_compatibility(const StringName &p_class, const StringName &p_name, uint64_t p_hash, bool *r_method_exists, bool *r_is_deprecated) {
+	Locker::Lock lock(Locker::STATE_READ);
+
+	ClassInfo *type = classes.getptr(p_class);
+	if (!type) {
+		return nullptr;
+	}
+
+	const LocalVector<ClassInfo::ResolvedMethod> *resolved = _get_resolved_methods(type, p_name);
+	if (r_method_exists && !resolved->is_empty()) {
+		*r_method_exists = true;
+	}
+
+	for (const ClassInfo::ResolvedMethod &candidate : *resolved) {
+		if (candidate.method->get_hash() == p_hash) {
+			if (r_is_deprecated && candidate.is_compatibility) {
+				*r_is_deprecated = true;
 			}
+			return candidate.method;
 		}
-		type = type->inherits_ptr;
 	}
 	return nullptr;
 }
@@ -1380,6 +1405,7 @@ void ClassDB::add_property(const StringName &p_class, const PropertyInfo &p_pinf
 	ClassInfo *type = classes.getptr(p_class);
 	ERR_FAIL_NO_CLASS(type, p_class);
 	type->gdtype->add_property(p_pinfo, p_setter, p_getter, p_index);
+	_invalidate_resolution_cache();
 }
 
 void ClassDB::set_property_default_value(const StringName &p_class, const StringName &p_name, const Variant &p_default) {
@@ -1482,6 +1508,58 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
 	return p_object->get_native(p_property, r_value);
 }
 
+ClassDB::PropertyAccessor ClassDB::prepare_property(const StringName &p_class, const StringName &p_property) {
+	Locker::Lock lock(Locker::STATE_READ);
+
+	PropertyAccessor accessor;
+	ClassInfo *class_info = classes.getptr(p_class);
+	ERR_FAIL_NULL_V_MSG(class_info, accessor, vformat("Cannot get class \"%s\".", p_class));
+
+	const GDType::Property *property = class_info->gdtype->get_property_map().getptr(p_property);
+	ERR_FAIL_NULL_V_MSG(property, accessor, vformat("Class '%s' has no native property '%s'.", p_class, p_property));
+
+	accessor.gdtype = class_info->gdtype;
+	accessor.name = p_property;
+	accessor.property = *property;
+	accessor.version = resolution_version.get();
+	return accessor;
+}
+
+bool ClassDB::PropertyAccessor::_is_instance(const Object *p_object) const {
+	for (const GDType *type = &p_object->get_gdtype(); type; type = type->get_super_type()) {
+		if (type == gdtype) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ClassDB::PropertyAccessor::set(Object *p_object, const Variant &p_value) const {
+	ERR_FAIL_NULL_V(p_object, false);
+	ERR_FAIL_COND_V_MSG(!is_valid(), false, vformat("Property accessor for '%s' is not valid; prepare it again after registering classes.", name));
+	ERR_FAIL_COND_V_MSG(!_is_instance(p_object), false, vformat("Property accessor for '%s::%s' used on an instance of '%s'.", gdtype->get_name(), name, p_object->get_class_name()));
+
+	bool valid = false;
+	p_object->set_native_property(property, p_value, &valid);
+	return valid;
+}
+
+bool ClassDB::PropertyAccessor::get(const Object *p_object, Variant &r_value) const {
+	ERR_FAIL_NULL_V(p_object, false);
+	ERR_FAIL_COND_V_MSG(!is_valid(), false, vformat("Property accessor for '%s' is not valid; prepare it again after registering classes.", name));
+	ERR_FAIL_COND_V_MSG(!_is_instance(p_object), false, vformat("Property accessor for '%s::%s' used on an instance of '%s'.", gdtype->get_name(), name, p_object->get_class_name()));
+
+	bool valid = false;
+	p_object->get_native_property(property, name, r_value, &valid);
+	return valid;
+}
+
+Variant ClassDB::PropertyAccessor::get(const Object *p_object) const {
+	Variant ret;
+	get(p_object, ret);
+	return ret;
+}
+
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
 	ClassInfo *class_info = classes.getptr(p_class);
 	if (class_info) {
@@ -1619,6 +1697,8 @@ void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_metho
 		ERR_FAIL_MSG(vformat("Couldn't bind custom method '%s' for instance '%s'.", method_name, p_class));
 	}
 
+	_invalidate_resolution_cache();
+
 	if (p_compatibility) {
 		_bind_compatibility(type, p_method);
 		return;
@@ -1640,6 +1720,8 @@ MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p
 		ERR_FAIL_NULL_V(type, nullptr);
 	}
 
+	_invalidate_resolution_cache();
+
 	if (p_compatibility) {
 		_bind_compatibility(type, bind);
 		return bind;
@@ -1688,6 +1770,8 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, bool p_
 	p_bind->set_argument_names(p_method_name.args);
 #endif // DEBUG_ENABLED
 
+	_invalidate_resolution_cache();
+
 	if (p_compatibility) {
 		_bind_compatibility(type, p_bind);
 	} else {
@@ -2040,6 +2124,7 @@ void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 	p_extension->gdtype = c.gdtype;
 
 	classes[p_extension->class_name] = c;
+	_invalidate_resolution_cache();
 }
 
 static LocalVector<GDType *> gdtype_leaked_autorelease_pool;
@@ -2050,6 +2135,7 @@ void ClassDB::unregister_extension_class(const StringName &p_class) {
 	// Leak the GDType until exit so potential consumers don't have dangling pointers.
 	gdtype_leaked_autorelease_pool.push_back(c->gdtype);
 	classes.erase(p_class);
+	_invalidate_resolution_cache();
 	default_values_cached.erase(p_class);
 	default_values.erase(p_class);
 #ifdef TOOLS_ENABLED
@@ -2110,6 +2196,7 @@ void ClassDB::cleanup() {
 	}
 
 	classes.clear();
+	_invalidate_resolution_cache();
 	resource_base_extensions.clear();
 	compat_classes.clear();
 	native_structs.clear();
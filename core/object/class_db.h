@@ -33,10 +33,12 @@
 #include "core/object/method_bind.h"
 #include "core/object/method_bind_common.h"
 #include "core/object/object.h"
+#include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
 #include "core/string/print_string.h"
 #include "core/templates/a_hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/safe_refcount.h"
 
 #include <type_traits>
 
@@ -118,6 +120,16 @@ public:
 
 		HashMap<StringName, LocalVector<MethodBind *>> method_map_compatibility;
 
+		// Flattened candidates for get_method_with_compatibility(), in lookup order
+		// (own method, then own compatibility methods, then the same for each parent).
+		// Filled lazily and discarded when `resolution_version` changes.
+		struct ResolvedMethod {
+			const MethodBind *method = nullptr;
+			bool is_compatibility = false;
+		};
+		HashMap<StringName, LocalVector<ResolvedMethod>> resolved_methods;
+		uint32_t resolved_methods_version = 0;
+
 #ifdef DEBUG_ENABLED
 		List<MethodInfo> virtual_methods;
 		HashMap<StringName, MethodInfo> virtual_methods_map;
@@ -176,6 +188,13 @@ public:
 	};
 
 	static HashMap<StringName, ClassInfo> classes;
+
+	// Bumped whenever classes, methods or properties are added or removed, so that
+	// resolved lookups (see ClassInfo::resolved_methods and PropertyAccessor) can tell they are stale.
+	inline static SafeNumeric<uint32_t> resolution_version{ 1 };
+	inline static Mutex resolution_cache_mutex;
+	static void _invalidate_resolution_cache() { resolution_version.increment(); }
+	static const LocalVector<ClassInfo::ResolvedMethod> *_get_resolved_methods(ClassInfo *p_type, const StringName &p_name);
 	static HashMap<StringName, StringName> resource_base_extensions;
 	static HashMap<StringName, StringName> compat_classes;
 
@@ -225,6 +244,29 @@ private:
 	static bool _can_instantiate(ClassInfo *p_class_info, bool p_exposed_only = true);
 
 public:
+	// A native property resolved once by prepare_property(), which can then be
+	// read and written on any instance of the class without further lookups.
+	// Script properties and `_set`/`_get` overrides are not considered.
+	class PropertyAccessor {
+		friend class ClassDB;
+
+		const GDType *gdtype = nullptr;
+		StringName name;
+		GDType::Property property = GDType::Property(GDType::Property::Type::SETGET);
+		uint32_t version = 0;
+
+		bool _is_instance(const Object *p_object) const;
+
+	public:
+		bool is_valid() const { return gdtype != nullptr && version == resolution_version.get(); }
+		const StringName &get_name() const { return name; }
+		bool is_settable() const { return property.type == GDType::Property::Type::SETGET && property.payload.setget.setter != nullptr; }
+
+		bool set(Object *p_object, const Variant &p_value) const;
+		bool get(const Object *p_object, Variant &r_value) const;
+		Variant get(const Object *p_object) const;
+	};
+
 	template <typename T>
 	static void register_class(bool p_virtual = false) {
 		Locker::Lock lock(Locker::STATE_WRITE);
@@ -458,6 +500,7 @@ public:
 	static void get_linked_properties_info(const StringName &p_class, const StringName &p_property, List<StringName> *r_properties, bool p_no_inheritance = false);
 	static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = nullptr);
 	static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value);
+	static PropertyAccessor prepare_property(const StringName &p_class, const StringName &p_property);
 	static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
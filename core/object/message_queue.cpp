@@ -34,35 +34,172 @@
 
 #include <cstdio>
 
-#ifdef DEV_ENABLED
-// Includes safety checks to ensure that a queue set as a thread singleton override
-// is only ever called from the thread it was set for.
-#define LOCK_MUTEX \
-	if (this != MessageQueue::thread_singleton) { \
-		DEV_ASSERT(!is_current_thread_override); \
-		mutex.lock(); \
-	} else { \
-		DEV_ASSERT(is_current_thread_override); \
+namespace {
+// Buffers recently used by this thread, by queue ID.
+struct ThreadBufferCacheEntry {
+	uint64_t queue_id = 0;
+	void *buffer = nullptr;
+};
+
+constexpr uint32_t THREAD_BUFFER_CACHE_SIZE = 4;
+thread_local ThreadBufferCacheEntry thread_buffer_cache[THREAD_BUFFER_CACHE_SIZE];
+thread_local uint32_t thread_buffer_cache_next = 0;
+
+SafeNumeric<uint64_t> last_queue_id;
+} // namespace
+
+CallQueue::ThreadLifetime *CallQueue::_get_thread_lifetime() {
+	struct Holder {
+		ThreadLifetime *lifetime = nullptr;
+
+		~Holder() {
+			if (lifetime) {
+				lifetime->exited.store(true, std::memory_order_release);
+				_unref_thread_lifetime(lifetime);
+			}
+		}
+	};
+	static thread_local Holder holder;
+
+	if (!holder.lifetime) {
+		holder.lifetime = memnew(ThreadLifetime);
+		holder.lifetime->refcount.init();
+	}
+	return holder.lifetime;
+}
+
+void CallQueue::_unref_thread_lifetime(ThreadLifetime *p_lifetime) {
+	if (p_lifetime->refcount.unref()) {
+		memdelete(p_lifetime);
+	}
+}
+
+CallQueue::ThreadBuffer *CallQueue::_get_thread_buffer() {
+	for (const ThreadBufferCacheEntry &entry : thread_buffer_cache) {
+		if (entry.queue_id == id) {
+			return (ThreadBuffer *)entry.buffer;
+		}
+	}
+
+	const Thread::ID thread_id = Thread::get_caller_id();
+	ThreadBuffer *buffer = nullptr;
+	{
+		MutexLock lock(mutex);
+		for (ThreadBuffer *E : buffers) {
+			if (E->thread_id == thread_id) {
+				buffer = E;
+				break;
+			}
+		}
+		if (!buffer) {
+			buffer = memnew(ThreadBuffer);
+			buffer->thread_id = thread_id;
+			buffer->owner = _get_thread_lifetime();
+			buffer->owner->refcount.ref();
+			buffer->tail = _alloc_page();
+			buffer->head = buffer->tail;
+			buffers.push_back(buffer);
+		}
+	}
+
+	ThreadBufferCacheEntry &entry = thread_buffer_cache[thread_buffer_cache_next++ % THREAD_BUFFER_CACHE_SIZE];
+	entry.queue_id = id;
+	entry.buffer = buffer;
+	return buffer;
+}
+
+void CallQueue::_free_thread_buffer(ThreadBuffer *p_buffer) {
+	Page *page = p_buffer->head;
+	while (page) {
+		Page *next = page->next.load(std::memory_order_relaxed);
+		_free_page(page);
+		page = next;
 	}
-#else
-#define LOCK_MUTEX \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.lock(); \
+	_unref_thread_lifetime(p_buffer->owner);
+	memdelete(p_buffer);
+}
+
+// Thread IDs are never reused, so without this every short-lived thread that
+// ever pushed would keep a buffer and a page until the queue is destroyed.
+// Must be called while holding `flush_mutex`.
+void CallQueue::_reclaim_exited_buffers() {
+	MutexLock lock(mutex);
+	for (uint32_t i = 0; i < buffers.size(); i++) {
+		ThreadBuffer *buffer = buffers[i];
+		// The owner stores `exited` after its last push, so `pushed` is final once it is seen.
+		if (!buffer->owner->exited.load(std::memory_order_acquire)) {
+			continue;
+		}
+		if (buffer->pushed.load(std::memory_order_acquire) != buffer->consumed.load(std::memory_order_relaxed)) {
+			continue; // Drained by the next flush.
+		}
+		_free_thread_buffer(buffer);
+		buffers.remove_at_unordered(i);
+		i--;
 	}
-#endif
+}
+
+CallQueue::Page *CallQueue::_alloc_page() {
+	max_pages_used.exchange_if_greater(pages_used.increment());
+	return allocator->alloc();
+}
+
+void CallQueue::_free_page(Page *p_page) {
+	allocator->free(p_page);
+	pages_used.decrement();
+}
+
+uint8_t *CallQueue::_reserve(ThreadBuffer *p_buffer, uint32_t p_size) {
+	if (p_buffer->tail_bytes + p_size > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() >= max_pages) {
+			return nullptr;
+		}
+		Page *page = _alloc_page();
+		// Everything in the previous page is committed already, so flush() can
+		// move on to the new page as soon as it sees it.
+		p_buffer->tail->next.store(page, std::memory_order_release);
+		p_buffer->tail = page;
+		p_buffer->tail_bytes = 0;
+	}
+	return &p_buffer->tail->data[p_buffer->tail_bytes];
+}
+
+void CallQueue::_commit(ThreadBuffer *p_buffer, uint32_t p_size) {
+	p_buffer->tail_bytes += p_size;
+	p_buffer->tail->committed.store(p_buffer->tail_bytes, std::memory_order_release);
+	p_buffer->pushed.store(p_buffer->pushed.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
 
-#define UNLOCK_MUTEX \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.unlock(); \
+CallQueue::Message *CallQueue::_read_message(ThreadBuffer *p_buffer) {
+	while (true) {
+		Page *page = p_buffer->head;
+		if (p_buffer->read_offset < page->committed.load(std::memory_order_acquire)) {
+			Message *message = (Message *)&page->data[p_buffer->read_offset];
+			// Advance before calling so flush() can be entered again.
+			p_buffer->read_offset += _get_message_size(message);
+			p_buffer->consumed.store(p_buffer->consumed.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			return message;
+		}
+
+		Page *next = page->next.load(std::memory_order_acquire);
+		if (!next) {
+			return nullptr;
+		}
+		if (p_buffer->read_offset < page->committed.load(std::memory_order_acquire)) {
+			continue; // Committed right before moving on.
+		}
+		p_buffer->head = next;
+		p_buffer->read_offset = 0;
+		_free_page(page);
 	}
+}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+void CallQueue::_get_buffers(LocalVector<ThreadBuffer *> &r_buffers) const {
+	MutexLock lock(mutex);
+	r_buffers.resize(buffers.size());
+	for (uint32_t i = 0; i < buffers.size(); i++) {
+		r_buffers[i] = buffers[i];
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -86,24 +223,14 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadBuffer *buffer = _get_thread_buffer();
+	uint8_t *buffer_end = _reserve(buffer, room_needed);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -124,37 +251,58 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
+	_commit(buffer, room_needed);
+
+	return OK;
+}
+
+Error CallQueue::_push_typed_callp(const Callable &p_callable, const TypedCallFuncs *p_funcs, void *p_arguments, uint32_t p_size) {
+	// Keep the next message aligned.
+	const uint32_t typed_call_size = (sizeof(const TypedCallFuncs *) + p_size + alignof(Message) - 1) & ~uint32_t(alignof(Message) - 1);
+	uint32_t room_needed = sizeof(Message) + typed_call_size;
+
+	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
+
+	ThreadBuffer *buffer = _get_thread_buffer();
+	uint8_t *buffer_end = _reserve(buffer, room_needed);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	Message *msg = memnew_placement(buffer_end, Message);
+	msg->typed_call_size = typed_call_size;
+	msg->callable = p_callable;
+	msg->type = TYPE_TYPED_CALL;
+	if (p_callable.get_object_id().is_null() && p_callable.is_valid()) {
+		msg->type |= FLAG_NULL_IS_OK;
+	}
+
+	buffer_end += sizeof(Message);
+	*(const TypedCallFuncs **)buffer_end = p_funcs;
+	p_funcs->move(buffer_end + sizeof(const TypedCallFuncs *), p_arguments);
 
-	UNLOCK_MUTEX;
+	_commit(buffer, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	ThreadBuffer *buffer = _get_thread_buffer();
+	uint8_t *buffer_end = _reserve(buffer, room_needed);
+	if (!buffer_end) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -165,32 +313,23 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_commit(buffer, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadBuffer *buffer = _get_thread_buffer();
+	uint8_t *buffer_end = _reserve(buffer, room_needed);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -198,12 +337,41 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_commit(buffer, room_needed);
 
 	return OK;
 }
 
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_NOTIFICATION:
+			return sizeof(Message);
+		case TYPE_TYPED_CALL:
+			return sizeof(Message) + p_message->typed_call_size;
+		default:
+			return sizeof(Message) + sizeof(Variant) * p_message->args;
+	}
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_NOTIFICATION:
+			break;
+		case TYPE_TYPED_CALL: {
+			uint8_t *data = (uint8_t *)(p_message + 1);
+			(*(const TypedCallFuncs **)data)->destroy(data + sizeof(const TypedCallFuncs *));
+		} break;
+		default: {
+			Variant *args = (Variant *)(p_message + 1);
+			for (int k = 0; k < p_message->args; k++) {
+				args[k].~Variant();
+			}
+		} break;
+	}
+
+	p_message->~Message();
+}
+
 void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error) {
 	const Variant **argptrs = nullptr;
 	if (p_argcount) {
@@ -213,6 +381,10 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 		}
 	}
 
+	if (p_callable.try_ptrcallp(argptrs, p_argcount)) {
+		return;
+	}
+
 	Callable::CallError ce;
 	Variant ret;
 	p_callable.callp(argptrs, p_argcount, ret, ce);
@@ -222,206 +394,148 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 }
 
 Error CallQueue::flush() {
-	LOCK_MUTEX;
-
-	if (pages.is_empty()) {
-		// Never allocated
-		UNLOCK_MUTEX;
-		return OK; // Do nothing.
+	if (!flush_mutex.try_lock()) {
+		return ERR_BUSY;
 	}
 
 	if (flushing) {
-		UNLOCK_MUTEX;
+		flush_mutex.unlock();
 		return ERR_BUSY;
 	}
 
 	flushing = true;
 
-	uint32_t i = 0;
-	uint32_t offset = 0;
-
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
-
-		//lock on each iteration, so a call can re-add itself to the message queue
-
-		Message *message = (Message *)&page->data[offset];
-
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
-
-		//pre-advance so this function is reentrant
-		offset += advance;
-
-		Object *target = message->callable.get_object();
-
-		UNLOCK_MUTEX;
-
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
+	// Drain every thread's buffer in turn, until calls stop adding messages.
+	bool called = true;
+	while (called) {
+		called = false;
+		_get_buffers(flush_buffers);
+
+		for (ThreadBuffer *buffer : flush_buffers) {
+			while (Message *message = _read_message(buffer)) {
+				called = true;
+				Object *target = message->callable.get_object();
+
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							Variant *args = (Variant *)(message + 1);
+							_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+						}
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							target->notification(message->notification);
+						}
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							Variant *arg = (Variant *)(message + 1);
+							target->set(message->callable.get_method(), *arg);
+						}
+					} break;
+					case TYPE_TYPED_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							const uint8_t *data = (const uint8_t *)(message + 1);
+							(*(const TypedCallFuncs **)data)->call(message->callable, data + sizeof(const TypedCallFuncs *));
+						}
+					} break;
 				}
-			} break;
-		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+				_destroy_message(message);
 			}
 		}
-
-		message->~Message();
-
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
-		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	_reclaim_exited_buffers();
 
 	flushing = false;
-	UNLOCK_MUTEX;
+	flush_mutex.unlock();
 	return OK;
 }
 
 void CallQueue::clear() {
-	LOCK_MUTEX;
-
-	if (pages.is_empty()) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
+	MutexLock flush_lock(flush_mutex);
 
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+	LocalVector<ThreadBuffer *> to_clear;
+	_get_buffers(to_clear);
+	for (ThreadBuffer *buffer : to_clear) {
+		while (Message *message = _read_message(buffer)) {
+			_destroy_message(message);
 		}
 	}
-
-	pages_used = 1;
-	page_bytes[0] = 0;
-
-	UNLOCK_MUTEX;
+	_reclaim_exited_buffers();
 }
 
 void CallQueue::statistics() {
-	LOCK_MUTEX;
+	MutexLock flush_lock(flush_mutex);
 	HashMap<StringName, int> set_count;
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			Object *target = message->callable.get_object();
-
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
+	LocalVector<ThreadBuffer *> to_count;
+	_get_buffers(to_count);
+	for (const ThreadBuffer *buffer : to_count) {
+		// Pages can't be released while `flush_mutex` is held, only new messages can show up.
+		const Page *page = buffer->head;
+		uint32_t offset = buffer->read_offset;
+		while (page) {
+			const uint32_t committed = page->committed.load(std::memory_order_acquire);
+			while (offset < committed) {
+				const Message *message = (const Message *)&page->data[offset];
+				offset += _get_message_size(message);
+
+				Object *target = message->callable.get_object();
+
+				bool null_target = true;
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL:
+					case TYPE_TYPED_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
+
+							call_count[message->callable]++;
+							null_target = false;
 						}
-
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
+
+							notify_count[message->notification]++;
+							null_target = false;
 						}
-
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
+
+							set_count[t]++;
+							null_target = false;
 						}
+					} break;
+				}
+				if (null_target) {
+					// Object was deleted.
+					fprintf(stdout, "Object was deleted while awaiting a callback.\n");
 
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				// Object was deleted.
-				fprintf(stdout, "Object was deleted while awaiting a callback.\n");
-
-				null_count++;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+					null_count++;
 				}
 			}
-
-			message->~Message();
+			page = page->next.load(std::memory_order_acquire);
+			offset = 0;
 		}
 	}
 
-	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used.get(), pages_used.get() * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -435,8 +549,6 @@ void CallQueue::statistics() {
 	for (const KeyValue<int, int> &E : notify_count) {
 		fprintf(stdout, "NOTIFY %d: %d.\n", E.key, E.value);
 	}
-
-	UNLOCK_MUTEX;
 }
 
 bool CallQueue::is_flushing() const {
@@ -444,18 +556,17 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
+	MutexLock lock(mutex);
+	for (const ThreadBuffer *buffer : buffers) {
+		if (buffer->pushed.load(std::memory_order_acquire) != buffer->consumed.load(std::memory_order_acquire)) {
+			return true;
+		}
 	}
-
-	return true;
+	return false;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return max_pages_used.get() * PAGE_SIZE_BYTES;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -466,6 +577,7 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 		allocator = memnew(Allocator(16)); // 16 elements per allocator page, 64kb per allocator page. Anything small will do, though.
 		allocator_is_custom = false;
 	}
+	id = last_queue_id.increment();
 	max_pages = p_max_pages;
 	error_text = p_error_text;
 }
@@ -473,13 +585,12 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 CallQueue::~CallQueue() {
 	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	for (ThreadBuffer *buffer : buffers) {
+		_free_thread_buffer(buffer);
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
 	}
-	DEV_ASSERT(!is_current_thread_override);
 }
 
 //////////////////////
@@ -488,17 +599,7 @@ CallQueue *MessageQueue::main_singleton = nullptr;
 thread_local CallQueue *MessageQueue::thread_singleton = nullptr;
 
 void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton) {
-#ifdef DEV_ENABLED
-	if (thread_singleton) {
-		thread_singleton->is_current_thread_override = false;
-	}
-#endif
 	thread_singleton = p_thread_singleton;
-#ifdef DEV_ENABLED
-	if (thread_singleton) {
-		thread_singleton->is_current_thread_override = true;
-	}
-#endif
 }
 
 MessageQueue::MessageQueue() :
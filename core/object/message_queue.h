@@ -30,12 +30,17 @@
 
 #pragma once
 
+#include "core/object/callable_mp.h"
 #include "core/object/object_id.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class Object;
 
 class CallQueue {
@@ -47,7 +52,11 @@ public:
 	};
 
 	struct Page {
-		uint8_t data[PAGE_SIZE_BYTES];
+		// Set by the pushing thread once it moved on to the next page.
+		std::atomic<Page *> next{ nullptr };
+		// Bytes of fully written messages, published to flush().
+		std::atomic<uint32_t> committed{ 0 };
+		alignas(8) uint8_t data[PAGE_SIZE_BYTES];
 	};
 
 	// Needs to be public to be able to define it outside the class.
@@ -59,47 +68,105 @@ private:
 		TYPE_CALL,
 		TYPE_NOTIFICATION,
 		TYPE_SET,
+		TYPE_TYPED_CALL,
 		TYPE_END, // End marker.
 		FLAG_NULL_IS_OK = 1 << 13,
 		FLAG_SHOW_ERROR = 1 << 14,
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
-	Mutex mutex;
+	// Shared by a thread and its buffers in every queue, so flush() can tell
+	// when the thread has exited and its buffers can be reclaimed.
+	struct ThreadLifetime {
+		SafeRefCount refcount; // One for the thread, one per buffer.
+		std::atomic<bool> exited{ false };
+	};
+
+	// Every thread pushing to the queue gets its own list of pages, which it
+	// appends to without locking. flush() drains them from the head, so calls
+	// pushed by the same thread keep their order.
+	struct ThreadBuffer {
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		ThreadLifetime *owner = nullptr;
+		// Only used by the owning thread.
+		Page *tail = nullptr;
+		uint32_t tail_bytes = 0;
+		// Only used while holding `flush_mutex`.
+		Page *head = nullptr;
+		uint32_t read_offset = 0;
+		// Written by a single thread each, compared by has_messages().
+		std::atomic<uint64_t> pushed{ 0 };
+		std::atomic<uint64_t> consumed{ 0 };
+	};
+
+	uint64_t id = 0; // Unique per queue, used to cache thread buffers.
+	mutable Mutex mutex; // Guards `buffers`.
+	Mutex flush_mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	LocalVector<ThreadBuffer *> buffers;
+	LocalVector<ThreadBuffer *> flush_buffers;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
+	SafeNumeric<uint32_t> pages_used;
+	SafeNumeric<uint32_t> max_pages_used;
 	bool flushing = false;
 
-#ifdef DEV_ENABLED
-	bool is_current_thread_override = false;
-#endif
-
 	struct Message {
 		Callable callable;
 		int16_t type;
 		union {
 			int16_t notification;
 			int16_t args;
+			int16_t typed_call_size; // Bytes following the message.
 		};
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
+	// Typed calls store their arguments already encoded for ptrcall(), so they are
+	// neither converted to Variants when pushed nor unpacked when flushed.
+	// The message is followed by a pointer to these functions, then the arguments.
+	struct TypedCallFuncs {
+		void (*move)(void *p_dest, void *p_source);
+		void (*call)(const Callable &p_callable, const void *p_arguments);
+		void (*destroy)(void *p_arguments);
+	};
+
+	template <typename... P>
+	struct TypedCall {
+		typedef CallablePtrcallArguments<P...> Arguments;
+
+		static void move(void *p_dest, void *p_source) {
+			memnew_placement(p_dest, Arguments(std::move(*(Arguments *)p_source)));
+		}
+		static void call(const Callable &p_callable, const void *p_arguments) {
+			const void *argptrs[sizeof...(P) + 1];
+			((const Arguments *)p_arguments)->get_pointers(argptrs);
+			p_callable.ptrcallp(argptrs, nullptr);
+		}
+		static void destroy(void *p_arguments) {
+			((Arguments *)p_arguments)->~Arguments();
 		}
-	}
 
-	void _add_page();
+		static inline const TypedCallFuncs funcs = { &move, &call, &destroy };
+	};
+
+	static ThreadLifetime *_get_thread_lifetime();
+	static void _unref_thread_lifetime(ThreadLifetime *p_lifetime);
+	ThreadBuffer *_get_thread_buffer();
+	void _free_thread_buffer(ThreadBuffer *p_buffer);
+	void _reclaim_exited_buffers();
+	Page *_alloc_page();
+	void _free_page(Page *p_page);
+	uint8_t *_reserve(ThreadBuffer *p_buffer, uint32_t p_size);
+	void _commit(ThreadBuffer *p_buffer, uint32_t p_size);
+	Message *_read_message(ThreadBuffer *p_buffer);
+	void _get_buffers(LocalVector<ThreadBuffer *> &r_buffers) const;
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
+	Error _push_typed_callp(const Callable &p_callable, const TypedCallFuncs *p_funcs, void *p_arguments, uint32_t p_size);
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _destroy_message(Message *p_message);
 
 	String error_text;
 
@@ -121,6 +188,15 @@ public:
 
 	template <typename... VarArgs>
 	Error push_callable(const Callable &p_callable, VarArgs... p_args) {
+		if constexpr (sizeof...(p_args) > 0 && callable_mp_supports_ptrcall<void, VarArgs...>()) {
+			typedef TypedCall<std::decay_t<VarArgs>...> TC;
+			if (alignof(typename TC::Arguments) <= alignof(Message) && p_callable.get_ptrcall_signature() == CallablePtrcallSignature<std::decay_t<VarArgs>...>::get()) {
+				// The target takes these exact types, keep them native.
+				typename TC::Arguments arguments(p_args...);
+				return _push_typed_callp(p_callable, &TC::funcs, &arguments, sizeof(arguments));
+			}
+		}
+
 		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
 		const Variant *argptrs[sizeof...(p_args) + 1];
 		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
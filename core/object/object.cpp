@@ -349,101 +349,105 @@ Variant Object::get(const StringName &p_name, bool *r_valid) const {
 bool Object::set_native(const StringName &p_name, const Variant &p_value, bool *r_valid) {
 	const GDType::Property *property = get_gdtype().get_property_map().getptr(p_name);
 	if (property) {
-		switch (property->type) {
-			case GDType::Property::Type::SETGET: {
-				const GDType::Property::SetGet &psg = property->payload.setget;
-				if (!psg.setter) {
-					if (r_valid) {
-						*r_valid = false;
-					}
-					return true;
-				}
-
-				Callable::CallError ce;
+		set_native_property(*property, p_value, r_valid);
+		return true;
+	}
 
-				if (psg.index >= 0) {
-					Variant index = psg.index;
-					const Variant *arg[2] = { &index, &p_value };
-					//p_object->call(psg->setter,arg,2,ce);
-					psg.setter->call(this, arg, 2, ce);
-				} else {
-					const Variant *arg[1] = { &p_value };
-					psg.setter->call(this, arg, 1, ce);
-				}
+	return false;
+}
 
-				if (r_valid) {
-					*r_valid = ce.error == Callable::CallError::CALL_OK;
-				}
-				return true;
-			}
-			default: {
-				// All other properties are unsettable.
+void Object::set_native_property(const GDType::Property &p_property, const Variant &p_value, bool *r_valid) {
+	switch (p_property.type) {
+		case GDType::Property::Type::SETGET: {
+			const GDType::Property::SetGet &psg = p_property.payload.setget;
+			if (!psg.setter) {
 				if (r_valid) {
 					*r_valid = false;
 				}
-				return true;
+				return;
 			}
-		}
-	}
-
-	return false;
-}
 
-bool Object::get_native(const StringName &p_name, Variant &r_value, bool *r_valid) const {
-	const GDType::Property *property = get_gdtype().get_property_map().getptr(p_name);
-	if (property) {
-		switch (property->type) {
-			case GDType::Property::Type::SETGET: {
-				const GDType::Property::SetGet &psg = property->payload.setget;
-				if (!psg.getter) {
-					if (r_valid) {
-						*r_valid = true; // Set to true for compat reasons.
-					}
-					r_value = Variant();
-					return true;
-				}
+			Callable::CallError ce;
 
-				Callable::CallError ce;
-				if (psg.index >= 0) {
-					Variant index = psg.index;
-					const Variant *arg[1] = { &index };
-					r_value = psg.getter->call(const_cast<Object *>(this), arg, 1, ce);
-				} else {
-					r_value = psg.getter->call(const_cast<Object *>(this), nullptr, 0, ce);
-				}
+			if (psg.index >= 0) {
+				Variant index = psg.index;
+				const Variant *arg[2] = { &index, &p_value };
+				//p_object->call(psg->setter,arg,2,ce);
+				psg.setter->call(this, arg, 2, ce);
+			} else {
+				const Variant *arg[1] = { &p_value };
+				psg.setter->call(this, arg, 1, ce);
+			}
 
-				if (ce.error != Callable::CallError::CALL_OK) {
-					if (r_valid) {
-						*r_valid = false;
-					}
-					r_value = Variant();
-				} else if (r_valid) {
-					*r_valid = true;
-				}
-				return true;
+			if (r_valid) {
+				*r_valid = ce.error == Callable::CallError::CALL_OK;
 			}
-			case GDType::Property::Type::INTEGER_CONSTANT: {
-				if (r_valid) {
-					*r_valid = true;
-				}
-				r_value = property->payload.integer;
-				return true;
+		} break;
+		default: {
+			// All other properties are unsettable.
+			if (r_valid) {
+				*r_valid = false;
 			}
-			case GDType::Property::Type::METHOD: {
+		} break;
+	}
+}
+
+void Object::get_native_property(const GDType::Property &p_property, const StringName &p_name, Variant &r_value, bool *r_valid) const {
+	switch (p_property.type) {
+		case GDType::Property::Type::SETGET: {
+			const GDType::Property::SetGet &psg = p_property.payload.setget;
+			if (!psg.getter) {
 				if (r_valid) {
-					*r_valid = true;
+					*r_valid = true; // Set to true for compat reasons.
 				}
-				r_value = Callable(this, p_name);
-				return true;
+				r_value = Variant();
+				return;
 			}
-			case GDType::Property::Type::SIGNAL: {
+
+			Callable::CallError ce;
+			if (psg.index >= 0) {
+				Variant index = psg.index;
+				const Variant *arg[1] = { &index };
+				r_value = psg.getter->call(const_cast<Object *>(this), arg, 1, ce);
+			} else {
+				r_value = psg.getter->call(const_cast<Object *>(this), nullptr, 0, ce);
+			}
+
+			if (ce.error != Callable::CallError::CALL_OK) {
 				if (r_valid) {
-					*r_valid = true;
+					*r_valid = false;
 				}
-				r_value = Signal(this, p_name);
-				return true;
+				r_value = Variant();
+			} else if (r_valid) {
+				*r_valid = true;
 			}
-		}
+		} break;
+		case GDType::Property::Type::INTEGER_CONSTANT: {
+			if (r_valid) {
+				*r_valid = true;
+			}
+			r_value = p_property.payload.integer;
+		} break;
+		case GDType::Property::Type::METHOD: {
+			if (r_valid) {
+				*r_valid = true;
+			}
+			r_value = Callable(this, p_name);
+		} break;
+		case GDType::Property::Type::SIGNAL: {
+			if (r_valid) {
+				*r_valid = true;
+			}
+			r_value = Signal(this, p_name);
+		} break;
+	}
+}
+
+bool Object::get_native(const StringName &p_name, Variant &r_value, bool *r_valid) const {
+	const GDType::Property *property = get_gdtype().get_property_map().getptr(p_name);
+	if (property) {
+		get_native_property(*property, p_name, r_value, r_valid);
+		return true;
 	}
 
 	// The "free()" method is special, so we assume it exists and return a Callable.
@@ -1249,14 +1253,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	Vector<SignalData::EmitSlot> emit_slots;
 
 	{
 		ObjectSignalLock signal_lock(this);
@@ -1272,33 +1269,40 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
+		if (s->emit_slots_version != s->slot_version) {
+			// Connections changed since the last emission, take a new snapshot.
+			Vector<SignalData::EmitSlot> snapshot;
+			snapshot.resize(s->slot_map.size());
+			SignalData::EmitSlot *w = snapshot.ptrw();
+			for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
+				w->callable = slot_kv.value.conn.callable;
+				w->flags = slot_kv.value.conn.flags;
+				++w;
+			}
+			s->emit_slots = snapshot;
+			s->emit_slots_version = s->slot_version;
 		}
 
 		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		// will not affect the signal calling. Only a reference is taken here,
+		// changes to the connections replace the snapshot instead of writing to it.
+		emit_slots = s->emit_slots;
 	}
 
+	const SignalData::EmitSlot *slots = emit_slots.ptr();
+	const uint32_t slot_count = emit_slots.size();
+
 	// Disconnect all one-shot connections before emitting to prevent recursion.
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		bool disconnect = slots[i].flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+		if (disconnect && (slots[i].flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
 			disconnect = false;
 		}
 #endif
 		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			_disconnect(p_name, slots[i].callable);
 		}
 	}
 
@@ -1312,8 +1316,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Variant source = this;
 
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+		const Callable &callable = slots[i].callable;
+		const uint32_t flags = slots[i].flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1351,8 +1355,13 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		if (flags & CONNECT_DEFERRED) {
 			MessageQueue::get_singleton()->push_callablep(callable, args, argc, true);
 		} else {
-			Callable::CallError ce;
 			_emitting = true;
+			if (callable.try_ptrcallp(args, argc)) {
+				// Native target taking these exact argument types, no Variant conversion needed.
+				_emitting = false;
+				continue;
+			}
+			Callable::CallError ce;
 			Variant ret;
 			callable.callp(args, argc, ret, ce);
 			_emitting = false;
@@ -1378,15 +1387,6 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
-
 	(void)source; // Ensure it's scoped to the function so it lives up to the end.
 
 	return err;
@@ -1635,6 +1635,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->slots_changed();
 
 	return OK;
 }
@@ -1713,6 +1714,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->slots_changed();
 
 	if (s->slot_map.is_empty() && get_gdtype().get_signal_map(false).has(p_signal)) {
 		//not user signal, delete
@@ -2438,8 +2440,9 @@ void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
 	spin_lock.lock();
 
 	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
+		ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.get_validator()) {
+			p_func(object_slot.object.load(std::memory_order_relaxed), p_user_data);
 			count--;
 		}
 	}
@@ -2495,7 +2498,7 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
 uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::object_slot_pages[OBJECTDB_SLOT_PAGE_COUNT] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
@@ -2507,29 +2510,34 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 	if (unlikely(slot_count == slot_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		ObjectSlot *page = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SLOT_PAGE_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_PAGE_SIZE; i++) {
+			memnew_placement(&page[i].data, std::atomic<uint64_t>(uint64_t(slot_max + i) << OBJECTDB_VALIDATOR_BITS));
+			memnew_placement(&page[i].object, std::atomic<Object *>(nullptr));
 		}
-		slot_max = new_slot_max;
+		object_slot_pages[slot_max >> OBJECTDB_SLOT_PAGE_BITS].store(page, std::memory_order_release);
+		slot_max += OBJECTDB_SLOT_PAGE_SIZE;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	uint32_t slot = _get_slot(slot_count).get_next_free();
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+
+	uint64_t data = validator_counter | (uint64_t(object_slot.get_next_free()) << OBJECTDB_VALIDATOR_BITS);
+	if (p_object->is_ref_counted()) {
+		data |= OBJECTDB_REFERENCE_BIT;
+	}
+	// Both are published with release semantics, pairing with the acquire loads in `get_instance()`:
+	// lookups which see the new validator or the new object must see the fully constructed slot.
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.data.store(data, std::memory_order_release);
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2552,17 +2560,19 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &object_slot = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if (object_slot.get_validator() != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND(object_slot.get_validator() != validator);
 		}
 	}
 
@@ -2570,11 +2580,11 @@ void ObjectDB::remove_instance(Object *p_object) {
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
-	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	_get_slot(slot_count).set_next_free(slot);
+	//invalidate, so checks against it fail, and lookups which still see the object see that too
+	object_slot.data.store(object_slot.data.load(std::memory_order_relaxed) & ~(OBJECTDB_VALIDATOR_MASK | OBJECTDB_REFERENCE_BIT), std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	object_slot.object.store(nullptr, std::memory_order_relaxed);
 
 	spin_lock.unlock();
 }
@@ -2597,8 +2607,9 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+				ObjectSlot &object_slot = _get_slot(i);
+				if (object_slot.get_validator()) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2611,7 +2622,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (object_slot.get_validator() << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slot.is_ref_counted() ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2622,9 +2633,11 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < slot_max; i += OBJECTDB_SLOT_PAGE_SIZE) {
+		memfree(object_slot_pages[i >> OBJECTDB_SLOT_PAGE_BITS].load(std::memory_order_relaxed));
+		object_slot_pages[i >> OBJECTDB_SLOT_PAGE_BITS].store(nullptr, std::memory_order_relaxed);
 	}
+	slot_max = 0;
 
 	spin_lock.unlock();
 }
@@ -418,9 +418,25 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		struct EmitSlot {
+			Callable callable;
+			uint32_t flags = 0;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		// Bumped on every change to slot_map. Emission shares `emit_slots` (copy-on-write)
+		// instead of copying the connections, and only rebuilds it when the version changed.
+		uint32_t slot_version = 0;
+		uint32_t emit_slots_version = 0;
+		Vector<EmitSlot> emit_slots;
 		bool removable = false;
+
+		void slots_changed() {
+			slot_version++;
+			// Drop the stale snapshot now so its callables (and their binds) are released.
+			emit_slots.clear();
+		}
 	};
 	mutable Mutex *signal_mutex = nullptr;
 	HashMap<StringName, SignalData> signal_map;
@@ -592,6 +608,7 @@ protected:
 
 	friend class ::ClassDB;
 	friend class PlaceholderExtensionInstance;
+	friend class PropertyPath;
 
 	static void _add_class_to_classdb(GDType &p_class, const GDType *p_inherits);
 	static void _get_property_list_from_classdb(const StringName &p_class, List<PropertyInfo> *p_list, bool p_no_inheritance, const Object *p_validator);
@@ -693,6 +710,9 @@ public:
 	/// Like set/get but only uses the internal path. Used from ClassDB::set_property and for GDScript optimization.
 	bool set_native(const StringName &p_name, const Variant &p_value, bool *r_valid = nullptr);
 	bool get_native(const StringName &p_name, Variant &r_value, bool *r_valid = nullptr) const;
+	/// Like set_native/get_native with the property already resolved from this object's GDType (or one of its super types).
+	void set_native_property(const GDType::Property &p_property, const Variant &p_value, bool *r_valid = nullptr);
+	void get_native_property(const GDType::Property &p_property, const StringName &p_name, Variant &r_value, bool *r_valid = nullptr) const;
 
 	void set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid = nullptr);
 	Variant get_indexed(const Vector<StringName> &p_names, bool *r_valid = nullptr) const;
@@ -884,24 +904,41 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
+// Slots are allocated in pages, which never move so that they can be read without locking.
+#define OBJECTDB_SLOT_PAGE_BITS 12
+#define OBJECTDB_SLOT_PAGE_SIZE (uint32_t(1) << OBJECTDB_SLOT_PAGE_BITS)
+#define OBJECTDB_SLOT_PAGE_MASK (OBJECTDB_SLOT_PAGE_SIZE - 1)
+#define OBJECTDB_SLOT_PAGE_COUNT (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_PAGE_BITS))
 
 	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+		// Validator in the low OBJECTDB_VALIDATOR_BITS, then next_free, then is_ref_counted.
+		// Only written with spin_lock held. The validator is 0 while the slot is free.
+		std::atomic<uint64_t> data;
+		std::atomic<Object *> object;
+
+		_FORCE_INLINE_ uint32_t get_next_free() const { return (data.load(std::memory_order_relaxed) >> OBJECTDB_VALIDATOR_BITS) & OBJECTDB_SLOT_MAX_COUNT_MASK; }
+		_FORCE_INLINE_ uint64_t get_validator() const { return data.load(std::memory_order_relaxed) & OBJECTDB_VALIDATOR_MASK; }
+		_FORCE_INLINE_ bool is_ref_counted() const { return data.load(std::memory_order_relaxed) & OBJECTDB_REFERENCE_BIT; }
+		_FORCE_INLINE_ void set_next_free(uint32_t p_next_free) {
+			const uint64_t next_free_mask = OBJECTDB_SLOT_MAX_COUNT_MASK << OBJECTDB_VALIDATOR_BITS;
+			data.store((data.load(std::memory_order_relaxed) & ~next_free_mask) | (uint64_t(p_next_free) << OBJECTDB_VALIDATOR_BITS), std::memory_order_relaxed);
+		}
 	};
 
 	static SpinLock spin_lock;
 	static uint32_t slot_count;
 	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
+	static std::atomic<ObjectSlot *> object_slot_pages[OBJECTDB_SLOT_PAGE_COUNT];
 	static uint64_t validator_counter;
 
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
 
+	_FORCE_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_slot_pages[p_slot >> OBJECTDB_SLOT_PAGE_BITS].load(std::memory_order_relaxed)[p_slot & OBJECTDB_SLOT_PAGE_MASK];
+	}
+
 	static ObjectID add_instance(Object *p_object);
 	static void remove_instance(Object *p_object);
 
@@ -911,24 +948,28 @@ class ObjectDB {
 public:
 	typedef void (*DebugFunc)(Object *p_obj, void *p_user_data);
 
+	// Lock-free. The validator is checked again after reading the object,
+	// in case the slot was freed and reused in between.
 	_ALWAYS_INLINE_ static Object *get_instance(ObjectID p_instance_id) {
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		ObjectSlot *page = object_slot_pages[slot >> OBJECTDB_SLOT_PAGE_BITS].load(std::memory_order_acquire);
+		ERR_FAIL_NULL_V(page, nullptr); // This should never happen unless RID is corrupted.
+		ObjectSlot &object_slot = page[slot & OBJECTDB_SLOT_PAGE_MASK];
 
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely((object_slot.data.load(std::memory_order_acquire) & OBJECTDB_VALIDATOR_MASK) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		// Pairs with the release store in `add_instance()`, and keeps the validator check below after it.
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		if (unlikely((object_slot.data.load(std::memory_order_relaxed) & OBJECTDB_VALIDATOR_MASK) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
@@ -0,0 +1,201 @@
+/**************************************************************************/
+/*  property_path.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#include "property_path.h"
+
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/variant/variant_internal.h"
+
+bool PropertyPath::_is_root_native(const Object *p_object) {
+	// Scripts and extensions get the first chance to handle a property (see Object::set()),
+	// so only plain native objects can skip straight to the resolved property.
+	if (p_object->get_script_instance() || (p_object->_extension && (p_object->_extension->set || p_object->_extension->get))) {
+		return false;
+	}
+
+	const GDType *gdtype = &p_object->get_gdtype();
+	const uint32_t version = ClassDB::resolution_version.get();
+	if (gdtype != root_gdtype || version != root_version) {
+		root_gdtype = gdtype;
+		root_version = version;
+		const GDType::Property *property = gdtype->get_property_map().getptr(names[0]);
+		root_native = property != nullptr;
+		if (property) {
+			root_property = *property;
+		}
+	}
+	return root_native;
+}
+
+Variant PropertyPath::_get_root(const Object *p_object, bool &r_valid) {
+	if (!_is_root_native(p_object)) {
+		return p_object->get(names[0], &r_valid);
+	}
+
+	Variant value;
+	p_object->get_native_property(root_property, names[0], value, &r_valid);
+	return value;
+}
+
+void PropertyPath::_set_root(Object *p_object, const Variant &p_value, bool &r_valid) {
+	if (!_is_root_native(p_object)) {
+		p_object->set(names[0], p_value, &r_valid);
+		return;
+	}
+
+#ifdef TOOLS_ENABLED
+	p_object->set_edited(true);
+#endif
+	p_object->set_native_property(root_property, p_value, &r_valid);
+}
+
+void PropertyPath::_resolve_member(Member &r_member, Variant::Type p_base_type) {
+	r_member.base_type = p_base_type;
+	r_member.type = Variant::get_member_type(p_base_type, r_member.name);
+	r_member.getter = Variant::get_member_validated_getter(p_base_type, r_member.name);
+	r_member.setter = Variant::get_member_validated_setter(p_base_type, r_member.name);
+}
+
+bool PropertyPath::_get_member(Member &r_member, const Variant &p_base, Variant &r_value) {
+	if (p_base.get_type() != r_member.base_type) {
+		_resolve_member(r_member, p_base.get_type());
+	}
+
+	if (r_member.getter) {
+		// Validated getters expect the result to already hold the member type.
+		if (r_value.get_type() != r_member.type) {
+			VariantInternal::initialize(&r_value, r_member.type);
+		}
+		r_member.getter(&p_base, &r_value);
+		return true;
+	}
+
+	bool valid = false;
+	r_value = p_base.get_named(r_member.name, valid);
+	return valid;
+}
+
+bool PropertyPath::_set_member(Member &r_member, Variant &r_base, const Variant &p_value) {
+	if (r_base.get_type() != r_member.base_type) {
+		_resolve_member(r_member, r_base.get_type());
+	}
+
+	// Validated setters don't convert, so other value types go through set_named().
+	if (r_member.setter && p_value.get_type() == r_member.type) {
+		r_member.setter(&r_base, &p_value);
+		return true;
+	}
+
+	bool valid = false;
+	r_base.set_named(r_member.name, p_value, valid);
+	return valid;
+}
+
+void PropertyPath::set(Object *p_object, const Variant &p_value, bool *r_valid) {
+	bool valid = false;
+	if (unlikely(!p_object || names.is_empty())) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		ERR_FAIL_NULL(p_object);
+		return;
+	}
+
+	if (members.is_empty()) {
+		_set_root(p_object, p_value, valid);
+		if (r_valid) {
+			*r_valid = valid;
+		}
+		return;
+	}
+
+	// Read the intermediate values down to the parent of the last name,
+	// then write the modified values back up to the root.
+	value_stack.resize(members.size());
+	value_stack[0] = _get_root(p_object, valid);
+	for (uint32_t i = 1; valid && i < members.size(); i++) {
+		valid = _get_member(members[i - 1], value_stack[i - 1], value_stack[i]);
+	}
+
+	if (valid) {
+		valid = _set_member(members[members.size() - 1], value_stack[members.size() - 1], p_value);
+		for (uint32_t i = members.size() - 1; valid && i > 0; i--) {
+			valid = _set_member(members[i - 1], value_stack[i - 1], value_stack[i]);
+		}
+	}
+
+	if (valid) {
+		_set_root(p_object, value_stack[0], valid);
+	}
+
+	// Don't keep references to resources or other shared values alive.
+	for (Variant &value : value_stack) {
+		value = Variant();
+	}
+
+	if (r_valid) {
+		*r_valid = valid;
+	}
+}
+
+Variant PropertyPath::get(const Object *p_object, bool *r_valid) {
+	bool valid = false;
+	if (unlikely(!p_object || names.is_empty())) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		ERR_FAIL_NULL_V(p_object, Variant());
+		return Variant();
+	}
+
+	Variant value = _get_root(p_object, valid);
+	for (uint32_t i = 0; valid && i < members.size(); i++) {
+		Variant member_value;
+		valid = _get_member(members[i], value, member_value);
+		value = std::move(member_value);
+	}
+
+	if (r_valid) {
+		*r_valid = valid;
+	}
+	return value;
+}
+
+PropertyPath::PropertyPath(const Vector<StringName> &p_names) {
+	names = p_names;
+	if (names.size() > 1) {
+		members.resize(names.size() - 1);
+		for (int i = 1; i < names.size(); i++) {
+			members[i - 1].name = names[i];
+		}
+	}
+}
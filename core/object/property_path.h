@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  property_path.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/object/gdtype.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+class Object;
+
+// A property path as used by Object::set_indexed() and Object::get_indexed(),
+// which remembers how each of its names was resolved the last time it was used.
+// Repeated reads and writes on objects of the same class then skip the name lookups:
+// the first name goes straight to the native setter or getter when the object has
+// no script or extension accessors, and the remaining names use the validated
+// member accessors of the built-in type found at that level.
+// Results are the same as set_indexed()/get_indexed(); anything that can't be
+// resolved ahead of time falls back to the generic path.
+class PropertyPath {
+	struct Member {
+		StringName name;
+		// Built-in type the accessors below were resolved for.
+		Variant::Type base_type = Variant::VARIANT_MAX;
+		Variant::Type type = Variant::NIL;
+		Variant::ValidatedGetter getter = nullptr;
+		Variant::ValidatedSetter setter = nullptr;
+	};
+
+	Vector<StringName> names;
+	LocalVector<Member> members;
+
+	const GDType *root_gdtype = nullptr;
+	uint32_t root_version = 0;
+	bool root_native = false;
+	GDType::Property root_property = GDType::Property(GDType::Property::Type::SETGET);
+
+	LocalVector<Variant> value_stack;
+
+	bool _is_root_native(const Object *p_object);
+	Variant _get_root(const Object *p_object, bool &r_valid);
+	void _set_root(Object *p_object, const Variant &p_value, bool &r_valid);
+
+	static void _resolve_member(Member &r_member, Variant::Type p_base_type);
+	static bool _get_member(Member &r_member, const Variant &p_base, Variant &r_value);
+	static bool _set_member(Member &r_member, Variant &r_base, const Variant &p_value);
+
+public:
+	_FORCE_INLINE_ bool is_empty() const { return names.is_empty(); }
+	_FORCE_INLINE_ const Vector<StringName> &get_names() const { return names; }
+
+	void set(Object *p_object, const Variant &p_value, bool *r_valid = nullptr);
+	Variant get(const Object *p_object, bool *r_valid = nullptr);
+
+	PropertyPath() {}
+	PropertyPath(const Vector<StringName> &p_names);
+};
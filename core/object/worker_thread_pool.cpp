@@ -148,17 +148,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		task_mutex.lock();
-		p_task->completed = true;
-		p_task->pool_thread_index = -1;
-		if (p_task->waiting_user) {
-			p_task->done_semaphore.post(p_task->waiting_user);
-		}
-		// Let awaiters know.
-		for (uint32_t i = 0; i < threads.size(); i++) {
-			if (threads[i].awaited_task == p_task) {
-				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
-			}
+		if (p_task->is_detached) {
+			// Nobody can await it, so it can go right away.
+			task_allocator.free(p_task);
+		} else {
+			_notify_task_completed(p_task);
 		}
 	}
 
@@ -183,13 +177,30 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #endif
 }
 
+void WorkerThreadPool::_notify_task_completed(Task *p_task) {
+	p_task->completed = true;
+	p_task->pool_thread_index = -1;
+	if (p_task->waiting_user) {
+		p_task->done_semaphore.post(p_task->waiting_user);
+	}
+	// Let awaiters know.
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (threads[i].awaited_task == p_task) {
+			threads[i].cond_var.notify_one();
+			threads[i].signaled = true;
+		}
+	}
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+
+		// Tasks this thread posted itself can be taken without locking.
+		if (!thread_data->local_queue.pop(task_to_process)) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -202,17 +213,22 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				task_to_process = thread_data->pool->_try_steal_task_before_waiting(thread_data);
+				if (task_to_process) {
+					break;
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
+				thread_data->pool->num_waiting_threads.decrement();
 			}
 		}
 
@@ -246,7 +262,32 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
-	for (uint32_t i = 0; i < p_count; i++) {
+	// High-priority tasks posted from a pool thread stay in its local queue, from where it can take them
+	// back without locking, while idle threads steal them. Threads running pump tasks may never get back
+	// to them, so they keep using the shared queue.
+	bool use_local_queue = caller_pool_thread && p_high_priority && !p_pump_task && !caller_pool_thread->has_pump_task;
+
+	uint32_t first_shared = 0;
+	if (use_local_queue) {
+		// Only this thread pushes to its local queue, so the lock is not needed for that.
+		// It is left unlocked if every task fits, since the callers are done with it.
+		p_lock.temp_unlock();
+		while (first_shared < p_count) {
+			p_tasks[first_shared]->low_priority = false;
+			if (!caller_pool_thread->local_queue.push(p_tasks[first_shared])) {
+				break;
+			}
+			first_shared++;
+		}
+		_notify_local_tasks(caller_pool_thread, first_shared);
+		if (first_shared == p_count) {
+			return;
+		}
+		// The local queue is full, the rest goes to the shared queue.
+		p_lock.temp_relock();
+	}
+
+	for (uint32_t i = first_shared; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
@@ -328,6 +369,60 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+// Called without holding `task_mutex`, right after pushing to the local queue of the current thread.
+void WorkerThreadPool::_notify_local_tasks(const ThreadData *p_current_thread_data, uint32_t p_count) {
+	if (p_count == 0) {
+		return;
+	}
+	// Pairs with the fence in _try_steal_task_before_waiting(). Either this thread sees the waiting one,
+	// or the waiting one sees the new tasks. Busy threads check the local queues before waiting anyway.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (num_waiting_threads.get() == 0) {
+		return;
+	}
+	MutexLock lock(task_mutex);
+	_notify_threads(p_current_thread_data, p_count, 0);
+}
+
+// Must be called with `task_mutex` held, right before waiting on the condition variable.
+// If nothing is found, the caller must wait and then decrement `num_waiting_threads`.
+WorkerThreadPool::Task *WorkerThreadPool::_try_steal_task_before_waiting(const ThreadData *p_thief_thread_data) {
+	// Local queues are pushed to without the lock, so announce the wait first.
+	// A thread pushing after this sees it, and has to take the lock to notify,
+	// which it can only get once this thread is waiting.
+	num_waiting_threads.increment();
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	Task *task = _try_steal_task(p_thief_thread_data);
+	if (task) {
+		num_waiting_threads.decrement();
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_try_steal_task(const ThreadData *p_thief_thread_data) {
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thief_thread_data->index + i) % thread_count];
+		// A failed steal means another thread took a task, so keep trying while there's something left.
+		while (!victim.local_queue.is_empty()) {
+			Task *task = nullptr;
+			if (victim.local_queue.steal(task)) {
+				return task;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].local_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -518,7 +613,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !p_caller_pool_thread->local_queue.is_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -536,7 +631,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			// Own tasks first, since the awaited one is likely among them.
+			if (!p_caller_pool_thread->local_queue.pop(task_to_process) && p_caller_pool_thread->pool->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -546,6 +642,10 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
+			if (!task_to_process) {
+				task_to_process = _try_steal_task_before_waiting(p_caller_pool_thread);
+			}
+
 			if (!task_to_process) {
 				p_caller_pool_thread->awaited_task = p_task;
 
@@ -555,6 +655,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				relock_unlockables = true;
 
 				p_caller_pool_thread->cond_var.wait(lock);
+				num_waiting_threads.decrement();
 
 				p_caller_pool_thread->awaited_task = nullptr;
 			}
@@ -589,7 +690,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -705,6 +806,247 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+void WorkerThreadPool::_add_detached_tasks(void (*p_func)(void *), void *p_userdata, uint32_t p_count, bool p_high_priority, const String &p_description) {
+	MutexLock<BinaryMutex> lock(task_mutex);
+
+	Task **tasks_posted = (Task **)alloca(sizeof(Task *) * p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		Task *task = task_allocator.alloc();
+		task->self = last_task++; // Not registered, but still needed for deadlock prevention.
+		task->native_func = p_func;
+		task->native_func_userdata = p_userdata;
+		task->description = p_description;
+		task->is_detached = true;
+		tasks_posted[i] = task;
+	}
+
+	_post_tasks(tasks_posted, p_count, p_high_priority, lock, false);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::_add_node(void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_is_group, int p_elements, int p_tasks, const String &p_description) {
+	if (unlikely(is_running() || p_elements < 0)) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_V_MSG(-1, is_running() ? "Can't add nodes to a task graph while it's running." : "Invalid element count.");
+	}
+
+	Node *node = memnew(Node);
+	node->graph = this;
+	node->native_func = p_func;
+	node->native_group_func = p_group_func;
+	node->native_func_userdata = p_userdata;
+	node->template_userdata = p_template_userdata;
+	node->description = p_description;
+	node->is_group = p_is_group;
+	node->elements = p_elements;
+	node->tasks = p_tasks;
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_task(void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	return _add_node(p_func, nullptr, p_userdata, nullptr, false, 0, 1, p_description);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, const String &p_description) {
+	return _add_node(nullptr, p_func, p_userdata, nullptr, true, p_elements, p_tasks, p_description);
+}
+
+void WorkerThreadPool::TaskGraph::add_dependency(NodeID p_node, NodeID p_runs_after) {
+	ERR_FAIL_COND_MSG(is_running(), "Can't add dependencies to a task graph while it's running.");
+	ERR_FAIL_INDEX(p_node, (int)nodes.size());
+	ERR_FAIL_INDEX(p_runs_after, (int)nodes.size());
+	ERR_FAIL_COND_MSG(p_node == p_runs_after, "A task graph node can't depend on itself.");
+
+	nodes[p_runs_after]->successors.push_back(nodes[p_node]);
+	nodes[p_node]->dependency_count++;
+}
+
+void WorkerThreadPool::TaskGraph::clear() {
+	ERR_FAIL_COND_MSG(is_running(), "Can't clear a task graph while it's running.");
+
+	for (Node *node : nodes) {
+		if (node->template_userdata) {
+			memdelete(node->template_userdata);
+		}
+		memdelete(node);
+	}
+	nodes.clear();
+}
+
+WorkerThreadPool::TaskGraph::~TaskGraph() {
+	CRASH_COND_MSG(is_running(), "A task graph was destroyed while running.");
+	clear();
+}
+
+void WorkerThreadPool::_task_graph_node_process(void *p_node) {
+	TaskGraph::Node *node = (TaskGraph::Node *)p_node;
+
+	if (node->is_group) {
+		while (true) {
+			uint32_t work_index = node->index.postincrement();
+			if (work_index >= node->elements) {
+				break;
+			}
+			if (node->native_group_func) {
+				node->native_group_func(node->native_func_userdata, work_index);
+			} else {
+				node->template_userdata->callback_indexed(work_index);
+			}
+		}
+	} else {
+		if (node->native_func) {
+			node->native_func(node->native_func_userdata);
+		} else {
+			node->template_userdata->callback();
+		}
+	}
+
+	// The last task to leave the node is the one to finish it, so none of the others can touch it afterwards.
+	uint32_t tasks_used = node->tasks_used; // Read before, since the graph may be gone after the increment.
+	if (node->finished_tasks.increment() == tasks_used) {
+		node->graph->pool->_task_graph_node_finished(node);
+	}
+}
+
+void WorkerThreadPool::_post_task_graph_node(TaskGraph::Node *p_node) {
+	if (p_node->tasks_used == 0) {
+		// Empty group.
+		_task_graph_node_finished(p_node);
+		return;
+	}
+	_add_detached_tasks(&WorkerThreadPool::_task_graph_node_process, p_node, p_node->tasks_used, p_node->graph->high_priority, p_node->description);
+}
+
+void WorkerThreadPool::_task_graph_node_finished(TaskGraph::Node *p_node) {
+	TaskGraph *graph = p_node->graph;
+
+	for (TaskGraph::Node *successor : p_node->successors) {
+		if (successor->pending_dependencies.decrement() == 0) {
+			_post_task_graph_node(successor);
+		}
+	}
+
+	// Until this reaches zero, the graph is guaranteed to be alive.
+	// Once it does, is_running() returns false and the owner may clear or free the graph,
+	// so nothing may be read from it afterwards.
+	Task *completion_task = graph->completion_task;
+	if (graph->pending_nodes.decrement() == 0) {
+		MutexLock task_lock(task_mutex);
+		_notify_task_completed(completion_task);
+	}
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::submit_task_graph(TaskGraph *p_graph, bool p_high_priority) {
+	ERR_FAIL_NULL_V(p_graph, INVALID_TASK_ID);
+	ERR_FAIL_COND_V_MSG(p_graph->is_running(), INVALID_TASK_ID, "Task graph is already running.");
+
+	// Check there are no cycles, which would keep the graph from ever completing.
+	// The pending dependency counters aren't in use yet, so they serve for the traversal.
+	LocalVector<TaskGraph::Node *> roots;
+	{
+		LocalVector<TaskGraph::Node *> ready;
+		for (TaskGraph::Node *node : p_graph->nodes) {
+			node->pending_dependencies.set(node->dependency_count);
+			if (node->dependency_count == 0) {
+				ready.push_back(node);
+				roots.push_back(node);
+			}
+		}
+		uint32_t visited = 0;
+		while (!ready.is_empty()) {
+			TaskGraph::Node *node = ready[ready.size() - 1];
+			ready.remove_at(ready.size() - 1);
+			visited++;
+			for (TaskGraph::Node *successor : node->successors) {
+				if (successor->pending_dependencies.decrement() == 0) {
+					ready.push_back(successor);
+				}
+			}
+		}
+		ERR_FAIL_COND_V_MSG(visited != p_graph->nodes.size(), INVALID_TASK_ID, "Task graph has a dependency cycle.");
+	}
+
+	uint32_t thread_count = MAX(1u, threads.size());
+	for (TaskGraph::Node *node : p_graph->nodes) {
+		node->pending_dependencies.set(node->dependency_count);
+		node->index.set(0);
+		node->finished_tasks.set(0);
+		if (node->is_group) {
+			uint32_t task_count = node->tasks < 0 ? thread_count : MAX(1, node->tasks);
+			node->tasks_used = MIN(task_count, node->elements);
+		} else {
+			node->tasks_used = 1;
+		}
+	}
+	p_graph->pool = this;
+	p_graph->high_priority = p_high_priority;
+
+	TaskID id;
+	{
+		MutexLock task_lock(task_mutex);
+
+		// Never posted; it only stands for the completion of the whole graph.
+		Task *task = task_allocator.alloc();
+		id = last_task++;
+		task->self = id;
+		task->description = "TaskGraph";
+		tasks.insert(id, task);
+		p_graph->completion_task = task;
+
+		if (p_graph->nodes.is_empty()) {
+			_notify_task_completed(task);
+			return id;
+		}
+		p_graph->pending_nodes.set(p_graph->nodes.size());
+	}
+
+	for (TaskGraph::Node *root : roots) {
+		_post_task_graph_node(root);
+	}
+
+	return id;
+}
+
+uint32_t WorkerThreadPool::get_parallel_for_chunk_count(uint32_t p_elements, uint32_t p_grain_size) const {
+	if (p_elements == 0) {
+		return 0;
+	}
+	uint32_t grain_size = MAX(1u, p_grain_size);
+	uint32_t chunk_count = MAX(1u, p_elements / grain_size); // Rounding down keeps every chunk at least as big as the grain.
+	return MIN(chunk_count, get_parallel_for_max_chunk_count());
+}
+
+void WorkerThreadPool::_parallel_for_process(ParallelForData *p_data) {
+	while (true) {
+		uint32_t chunk = p_data->next_chunk.postincrement();
+		if (chunk >= p_data->chunk_count) {
+			break;
+		}
+		uint32_t from = (uint64_t)chunk * p_data->elements / p_data->chunk_count;
+		uint32_t to = (uint64_t)(chunk + 1) * p_data->elements / p_data->chunk_count;
+		p_data->body_func(p_data->body, from, to, chunk);
+	}
+}
+
+void WorkerThreadPool::_parallel_for_task(void *p_data, uint32_t p_index) {
+	_parallel_for_process((ParallelForData *)p_data);
+}
+
+void WorkerThreadPool::_parallel_for(ParallelForData &p_data, bool p_high_priority, const String &p_description) {
+	if (p_data.chunk_count <= 1 || threads.is_empty()) {
+		_parallel_for_process(&p_data);
+		return;
+	}
+
+	// The calling thread takes one share of the work, instead of just waiting.
+	uint32_t task_count = MIN(p_data.chunk_count - 1, threads.size());
+	GroupID group = add_native_group_task(&WorkerThreadPool::_parallel_for_task, &p_data, task_count, task_count, p_high_priority, p_description);
+	_parallel_for_process(&p_data);
+	wait_for_group_task_completion(group);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
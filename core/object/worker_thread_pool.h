@@ -39,6 +39,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/work_stealing_deque.h"
 #include "core/variant/callable.h"
 
 class WorkerThreadPool : public Object {
@@ -82,6 +83,7 @@ private:
 		bool completed : 1;
 		bool pending_notify_yield_over : 1;
 		bool is_pump_task : 1;
+		bool is_detached : 1; // Not tracked by ID; frees itself when done.
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
 		uint32_t waiting_pool = 0;
@@ -95,11 +97,13 @@ private:
 				completed(false),
 				pending_notify_yield_over(false),
 				is_pump_task(false),
+				is_detached(false),
 				task_elem(this) {}
 	};
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -123,6 +127,9 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		// High-priority tasks posted from this thread. Only this thread pushes and pops,
+		// without holding `task_mutex`; other threads steal from it when they run out of work.
+		WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE> local_queue;
 
 		ThreadData() :
 				signaled(false),
@@ -133,6 +140,9 @@ private:
 	};
 
 	TightLocalVector<ThreadData> threads;
+	// Pool threads about to block on their condition variable. Posting to a local queue
+	// only takes `task_mutex` to notify them when this isn't zero.
+	SafeNumeric<uint32_t> num_waiting_threads;
 	enum Runlevel {
 		RUNLEVEL_NORMAL,
 		RUNLEVEL_PRE_EXIT_LANGUAGES, // Block adding new tasks
@@ -180,9 +190,14 @@ private:
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
+	void _notify_local_tasks(const ThreadData *p_current_thread_data, uint32_t p_count);
+	Task *_try_steal_task_before_waiting(const ThreadData *p_thief_thread_data);
 
 	bool _try_promote_low_priority_task();
 
+	Task *_try_steal_task(const ThreadData *p_thief_thread_data);
+	bool _has_local_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -217,6 +232,112 @@ private:
 		}
 	};
 
+public:
+	// A set of tasks with "runs after" dependencies among them, submitted all at once.
+	// Each node is scheduled as soon as every node it depends on has finished, so independent
+	// chains of work overlap instead of being serialized by waits on the submitting thread.
+	// Nodes can be single tasks or groups, which are processed in parallel like group tasks.
+	// The graph must not be modified or destroyed while running. Once its completion has been
+	// awaited, it can be submitted again.
+	class TaskGraph {
+		friend class WorkerThreadPool;
+
+	public:
+		typedef int32_t NodeID;
+
+	private:
+		struct Node {
+			TaskGraph *graph = nullptr;
+			void (*native_func)(void *) = nullptr;
+			void (*native_group_func)(void *, uint32_t) = nullptr;
+			void *native_func_userdata = nullptr;
+			BaseTemplateUserdata *template_userdata = nullptr;
+			String description;
+			bool is_group = false;
+			uint32_t elements = 0;
+			int tasks = 1;
+			uint32_t tasks_used = 0;
+			LocalVector<Node *> successors;
+			uint32_t dependency_count = 0;
+			SafeNumeric<uint32_t> pending_dependencies;
+			SafeNumeric<uint32_t> index;
+			SafeNumeric<uint32_t> finished_tasks;
+		};
+
+		LocalVector<Node *> nodes;
+		WorkerThreadPool *pool = nullptr;
+		bool high_priority = false;
+		SafeNumeric<uint32_t> pending_nodes;
+		Task *completion_task = nullptr;
+
+		NodeID _add_node(void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_is_group, int p_elements, int p_tasks, const String &p_description);
+
+	public:
+		template <typename C, typename M, typename U>
+		NodeID add_template_task(C *p_instance, M p_method, U p_userdata, const String &p_description = String()) {
+			typedef TaskUserData<C, M, U> TUD;
+			TUD *ud = memnew(TUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			return _add_node(nullptr, nullptr, nullptr, ud, false, 0, 1, p_description);
+		}
+		NodeID add_native_task(void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+
+		template <typename C, typename M, typename U>
+		NodeID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String()) {
+			typedef GroupUserData<C, M, U> GroupUD;
+			GroupUD *ud = memnew(GroupUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			return _add_node(nullptr, nullptr, nullptr, ud, true, p_elements, p_tasks, p_description);
+		}
+		NodeID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String());
+
+		// Makes p_node run after p_runs_after has finished.
+		void add_dependency(NodeID p_node, NodeID p_runs_after);
+
+		uint32_t get_node_count() const { return nodes.size(); }
+		bool is_running() const { return pending_nodes.get() > 0; }
+		void clear();
+
+		TaskGraph() {}
+		~TaskGraph();
+	};
+
+private:
+	void _add_detached_tasks(void (*p_func)(void *), void *p_userdata, uint32_t p_count, bool p_high_priority, const String &p_description);
+	void _notify_task_completed(Task *p_task);
+
+	static void _task_graph_node_process(void *p_node);
+	void _post_task_graph_node(TaskGraph::Node *p_node);
+	void _task_graph_node_finished(TaskGraph::Node *p_node);
+
+	struct ParallelForData {
+		SafeNumeric<uint32_t> next_chunk;
+		uint32_t chunk_count = 0;
+		uint32_t elements = 0;
+		const void *body = nullptr;
+		void (*body_func)(const void *p_body, uint32_t p_from, uint32_t p_to, uint32_t p_chunk) = nullptr;
+	};
+
+	static void _parallel_for_process(ParallelForData *p_data);
+	static void _parallel_for_task(void *p_data, uint32_t p_index);
+	void _parallel_for(ParallelForData &p_data, bool p_high_priority, const String &p_description);
+
+	template <typename F>
+	void _parallel_for_chunks(uint32_t p_elements, uint32_t p_chunk_count, const F &p_body, bool p_high_priority, const String &p_description) {
+		ParallelForData data;
+		data.chunk_count = p_chunk_count;
+		data.elements = p_elements;
+		data.body = &p_body;
+		data.body_func = [](const void *p_body_ptr, uint32_t p_from, uint32_t p_to, uint32_t p_chunk) {
+			(*(const F *)p_body_ptr)(p_from, p_to, p_chunk);
+		};
+		_parallel_for(data, p_high_priority, p_description);
+	}
+
 	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task);
 
 	void _switch_runlevel(Runlevel p_runlevel);
@@ -267,6 +388,51 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Chunk boundaries only depend on the element count, the grain size and the thread count,
+	// so results stored per chunk can be merged in a deterministic order.
+	static const uint32_t PARALLEL_FOR_CHUNKS_PER_THREAD = 4;
+	uint32_t get_parallel_for_chunk_count(uint32_t p_elements, uint32_t p_grain_size) const;
+	uint32_t get_parallel_for_max_chunk_count() const { return MAX(1, get_thread_count()) * PARALLEL_FOR_CHUNKS_PER_THREAD; }
+
+	// Calls p_body(from, to, chunk) over contiguous chunks covering [0, p_elements), each at least p_grain_size
+	// elements long (unless there are fewer elements than that in total). Chunks are claimed dynamically, so uneven workloads
+	// balance out. The calling thread takes part too, and this returns once all chunks are processed.
+	template <typename F>
+	void parallel_for(uint32_t p_elements, uint32_t p_grain_size, const F &p_body, bool p_high_priority = true, const String &p_description = String()) {
+		_parallel_for_chunks(p_elements, get_parallel_for_chunk_count(p_elements, p_grain_size), p_body, p_high_priority, p_description);
+	}
+
+	// Like parallel_for(), but p_body(from, to, r_partial) accumulates into storage of its own for each chunk,
+	// starting from p_identity. Partial results are then merged in chunk order with p_join(r_into, partial),
+	// so the result is the same on every run (for a given thread count) even for non-associative operations.
+	// Partial results of small types may share cache lines, so p_body should rather accumulate locally and
+	// write the partial result once.
+	template <typename T, typename F, typename J>
+	T parallel_reduce(uint32_t p_elements, uint32_t p_grain_size, const T &p_identity, const F &p_body, const J &p_join, bool p_high_priority = true, const String &p_description = String()) {
+		uint32_t chunk_count = get_parallel_for_chunk_count(p_elements, p_grain_size);
+		LocalVector<T> partials;
+		partials.reserve(chunk_count);
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			partials.push_back(p_identity);
+		}
+
+		_parallel_for_chunks(
+				p_elements, chunk_count, [&](uint32_t p_from, uint32_t p_to, uint32_t p_chunk) {
+					p_body(p_from, p_to, partials[p_chunk]);
+				},
+				p_high_priority, p_description);
+
+		T result = p_identity;
+		for (const T &partial : partials) {
+			p_join(result, partial);
+		}
+		return result;
+	}
+
+	// Returns a task ID that completes when every node in the graph has finished.
+	// As with any other task, its completion must be awaited with wait_for_task_completion().
+	TaskID submit_task_graph(TaskGraph *p_graph, bool p_high_priority = false);
+
 	_FORCE_INLINE_ int get_thread_count() const {
 #ifdef THREADS_ENABLED
 		return threads.size();
@@ -0,0 +1,280 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/error/error_macros.h"
+#include "core/templates/safe_refcount.h"
+
+#include <cstring>
+
+namespace {
+
+struct Block {
+	Block *next = nullptr;
+	size_t capacity = 0;
+};
+
+struct AllocationHeader {
+	void *arena = nullptr;
+	size_t size = 0;
+};
+
+constexpr size_t BLOCK_HEADER_SIZE = Memory::get_aligned_address(sizeof(Block), Memory::MAX_ALIGN);
+constexpr size_t ALLOCATION_HEADER_SIZE = Memory::get_aligned_address(sizeof(AllocationHeader), Memory::MAX_ALIGN);
+
+SafeNumeric<uint64_t> reserved_memory;
+SafeNumeric<uint64_t> current_frame_high_water;
+SafeNumeric<uint64_t> last_frame_high_water;
+SafeNumeric<uint64_t> max_high_water;
+
+_FORCE_INLINE_ size_t padded_size(size_t p_bytes) {
+	return Memory::get_aligned_address(p_bytes, Memory::MAX_ALIGN);
+}
+
+_FORCE_INLINE_ AllocationHeader *get_header(void *p_memory) {
+	return reinterpret_cast<AllocationHeader *>(static_cast<uint8_t *>(p_memory) - ALLOCATION_HEADER_SIZE);
+}
+
+} // namespace
+
+struct FrameArena::ThreadArena {
+	Block *first = nullptr;
+	Block *current = nullptr;
+	size_t offset = 0; // Into the data of the current block.
+	size_t used = 0; // Handed out since the last rewind, across all blocks.
+	size_t peak = 0; // Highest `used` since the last rewind.
+	uint8_t *last_allocation = nullptr;
+	SafeNumeric<uint32_t> live_allocations;
+};
+
+// Releases the arena when the thread exits. If allocations are still alive (e.g. moved to another thread),
+// the arena is leaked on purpose so that freeing them later stays valid.
+struct FrameArena::ThreadArenaOwner {
+	ThreadArena *arena = nullptr;
+
+	~ThreadArenaOwner();
+};
+
+thread_local FrameArena::ThreadArenaOwner FrameArena::thread_arena_owner;
+
+FrameArena::ThreadArenaOwner::~ThreadArenaOwner() {
+	if (!arena || arena->live_allocations.get() != 0) {
+		return;
+	}
+	Block *block = arena->first;
+	while (block) {
+		Block *next = block->next;
+		reserved_memory.sub(block->capacity);
+		Memory::free_static(block);
+		block = next;
+	}
+	memdelete(arena);
+	arena = nullptr;
+}
+
+FrameArena::ThreadArena *FrameArena::_get_thread_arena() {
+	if (unlikely(!thread_arena_owner.arena)) {
+		thread_arena_owner.arena = memnew(ThreadArena);
+	}
+	return thread_arena_owner.arena;
+}
+
+void FrameArena::_rewind(ThreadArena *p_arena) {
+	current_frame_high_water.exchange_if_greater(p_arena->peak);
+
+	if (p_arena->first && p_arena->first->next) {
+		// The working set spilled over several blocks; replace them with a single one that fits it all.
+		size_t capacity = 0;
+		Block *block = p_arena->first;
+		while (block) {
+			Block *next = block->next;
+			capacity += block->capacity;
+			reserved_memory.sub(block->capacity);
+			Memory::free_static(block);
+			block = next;
+		}
+		block = static_cast<Block *>(Memory::alloc_static(BLOCK_HEADER_SIZE + capacity));
+		CRASH_COND_MSG(!block, "Out of memory");
+		block->next = nullptr;
+		block->capacity = capacity;
+		reserved_memory.add(capacity);
+		p_arena->first = block;
+	}
+
+	p_arena->current = p_arena->first;
+	p_arena->offset = 0;
+	p_arena->used = 0;
+	p_arena->peak = 0;
+	p_arena->last_allocation = nullptr;
+}
+
+void FrameArena::_next_block(ThreadArena *p_arena, size_t p_bytes) {
+	// Blocks after the current one are kept across rewinds until the next coalescing, reuse them if they fit.
+	Block *next = p_arena->current ? p_arena->current->next : p_arena->first;
+	if (next && next->capacity >= p_bytes) {
+		p_arena->current = next;
+		p_arena->offset = 0;
+		return;
+	}
+
+	const size_t capacity = Memory::get_aligned_address(p_bytes, BLOCK_SIZE);
+	Block *block = static_cast<Block *>(Memory::alloc_static(BLOCK_HEADER_SIZE + capacity));
+	CRASH_COND_MSG(!block, "Out of memory");
+	block->next = next;
+	block->capacity = capacity;
+	reserved_memory.add(capacity);
+
+	if (p_arena->current) {
+		p_arena->current->next = block;
+	} else {
+		p_arena->first = block;
+	}
+	p_arena->current = block;
+	p_arena->offset = 0;
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	ThreadArena *arena = _get_thread_arena();
+	if (arena->used != 0 && arena->live_allocations.get() == 0) {
+		_rewind(arena);
+	}
+
+	const size_t bytes = ALLOCATION_HEADER_SIZE + padded_size(p_bytes);
+	if (unlikely(!arena->current || arena->offset + bytes > arena->current->capacity)) {
+		_next_block(arena, bytes);
+	}
+
+	uint8_t *mem = reinterpret_cast<uint8_t *>(arena->current) + BLOCK_HEADER_SIZE + arena->offset;
+	arena->offset += bytes;
+	arena->used += bytes;
+	if (arena->used > arena->peak) {
+		arena->peak = arena->used;
+	}
+
+	AllocationHeader *header = reinterpret_cast<AllocationHeader *>(mem);
+	header->arena = arena;
+	header->size = p_bytes;
+	arena->live_allocations.increment();
+
+	arena->last_allocation = mem + ALLOCATION_HEADER_SIZE;
+	return arena->last_allocation;
+}
+
+void *FrameArena::alloc_zeroed(size_t p_bytes) {
+	void *mem = alloc(p_bytes);
+	memset(mem, 0, p_bytes);
+	return mem;
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+
+	AllocationHeader *header = get_header(p_memory);
+	if (p_bytes <= header->size) {
+		return p_memory;
+	}
+
+	ThreadArena *arena = thread_arena_owner.arena;
+	if (header->arena == arena && p_memory == arena->last_allocation) {
+		// Growing the most recent allocation of this thread, extend it in place if the block has room.
+		const size_t grow = padded_size(p_bytes) - padded_size(header->size);
+		if (arena->offset + grow <= arena->current->capacity) {
+			arena->offset += grow;
+			arena->used += grow;
+			if (arena->used > arena->peak) {
+				arena->peak = arena->used;
+			}
+			header->size = p_bytes;
+			return p_memory;
+		}
+	}
+
+	void *mem = alloc(p_bytes);
+	memcpy(mem, p_memory, header->size);
+	free(p_memory);
+	return mem;
+}
+
+void FrameArena::free(void *p_memory) {
+	if (p_memory == nullptr) {
+		return;
+	}
+
+	AllocationHeader *header = get_header(p_memory);
+	ThreadArena *arena = static_cast<ThreadArena *>(header->arena);
+	if (arena == thread_arena_owner.arena && p_memory == arena->last_allocation) {
+		// Freeing the most recent allocation makes its space available again right away.
+		const size_t bytes = ALLOCATION_HEADER_SIZE + padded_size(header->size);
+		arena->offset -= bytes;
+		arena->used -= bytes;
+		arena->last_allocation = nullptr;
+	}
+	arena->live_allocations.decrement();
+}
+
+void FrameArena::end_frame() {
+	ThreadArena *arena = thread_arena_owner.arena;
+	if (arena) {
+		if (arena->live_allocations.get() == 0) {
+			_rewind(arena);
+		} else {
+#ifdef DEV_ENABLED
+			WARN_PRINT_ONCE("FrameArena memory allocated on the main thread is still alive at the end of the frame.");
+#endif
+			current_frame_high_water.exchange_if_greater(arena->peak);
+		}
+	}
+
+	// A sample published by another thread between these two calls is lost, which is acceptable for statistics.
+	const uint64_t high_water = current_frame_high_water.get();
+	current_frame_high_water.set(0);
+	last_frame_high_water.set(high_water);
+	max_high_water.exchange_if_greater(high_water);
+}
+
+uint64_t FrameArena::get_frame_high_water() {
+	return last_frame_high_water.get();
+}
+
+uint64_t FrameArena::get_max_high_water() {
+	return max_high_water.get();
+}
+
+uint64_t FrameArena::get_reserved_memory() {
+	return reserved_memory.get();
+}
+
+uint64_t FrameArena::get_thread_usage() {
+	const ThreadArena *arena = thread_arena_owner.arena;
+	return arena ? arena->used : 0;
+}
@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Per-thread bump allocator for scratch memory that does not outlive the current frame.
+//
+// Allocations are carved linearly out of blocks owned by the calling thread. The arena rewinds
+// as soon as every allocation it handed out has been freed, so short-lived containers stop going
+// through malloc/free once a thread's blocks have grown to its working set. Memory can be freed
+// from any thread, but the owning thread is the only one that reuses it.
+//
+// Use it as the allocator of LocalVector and AHashMap (see FrameLocalVector and FrameAHashMap below)
+// for temporaries in the frame loop. Don't store arena memory in anything that survives
+// Main::iteration(): a single long-lived allocation pins every later allocation of that thread.
+class FrameArena {
+	struct ThreadArena;
+	struct ThreadArenaOwner;
+
+	static thread_local ThreadArenaOwner thread_arena_owner;
+
+	static ThreadArena *_get_thread_arena();
+	static void _rewind(ThreadArena *p_arena);
+	static void _next_block(ThreadArena *p_arena, size_t p_bytes);
+
+public:
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+	static void *alloc(size_t p_bytes);
+	static void *alloc_zeroed(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Called by Main::iteration() once per frame to rewind the calling thread's arena and roll the statistics over.
+	static void end_frame();
+
+	// High-water marks are the largest amount of memory a single thread's arena held between two rewinds.
+	static uint64_t get_frame_high_water();
+	static uint64_t get_max_high_water();
+	// Memory held in blocks by all arenas. It is also accounted for in Memory::get_mem_usage().
+	static uint64_t get_reserved_memory();
+	static uint64_t get_thread_usage();
+};
+
+// Scratch vector backed by the calling thread's FrameArena. Must not outlive the current frame.
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameArena>;
+
+// Scratch map backed by the calling thread's FrameArena. Must not outlive the current frame.
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameAHashMap = AHashMap<TKey, TValue, Hasher, Comparator, FrameArena>;
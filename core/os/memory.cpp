@@ -37,6 +37,10 @@
 #include "core/math/math_funcs_binary.h"
 #endif
 
+#ifdef POOLED_ALLOCATOR_ENABLED
+#include "core/os/pooled_allocator.h"
+#endif
+
 #include <cstdlib>
 
 #ifdef DEBUG_ENABLED
@@ -88,18 +92,26 @@ void Memory::free_aligned_static(void *p_memory) {
 
 template <bool p_ensure_zero>
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(POOLED_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
 	void *mem;
+#ifdef POOLED_ALLOCATOR_ENABLED
+	if constexpr (p_ensure_zero) {
+		mem = PooledAllocator::alloc_zeroed(p_bytes + DATA_OFFSET);
+	} else {
+		mem = PooledAllocator::alloc(p_bytes + DATA_OFFSET);
+	}
+#else
 	if constexpr (p_ensure_zero) {
 		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
 	} else {
 		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
 	}
+#endif
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 	GodotProfileAlloc(mem, p_bytes + (prepad ? DATA_OFFSET : 0));
@@ -130,7 +142,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(POOLED_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -151,13 +163,24 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 		if (p_bytes == 0) {
 			GodotProfileFree(mem);
+#ifdef POOLED_ALLOCATOR_ENABLED
+			PooledAllocator::free(mem, *s + DATA_OFFSET);
+#else
 			free(mem);
+#endif
 			return nullptr;
 		} else {
+#ifdef POOLED_ALLOCATOR_ENABLED
+			const uint64_t old_bytes = *s;
+#endif
 			*s = p_bytes;
 
 			GodotProfileFree(mem);
+#ifdef POOLED_ALLOCATOR_ENABLED
+			mem = (uint8_t *)PooledAllocator::realloc(mem, old_bytes + DATA_OFFSET, p_bytes + DATA_OFFSET);
+#else
 			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+#endif
 			ERR_FAIL_NULL_V(mem, nullptr);
 			GodotProfileAlloc(mem, p_bytes + DATA_OFFSET);
 
@@ -183,7 +206,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(POOLED_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -192,13 +215,19 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(POOLED_ALLOCATOR_ENABLED)
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#endif
+#ifdef DEBUG_ENABLED
 		_current_mem_usage.sub(*s);
 #endif
 
 		GodotProfileFree(mem);
+#ifdef POOLED_ALLOCATOR_ENABLED
+		PooledAllocator::free(mem, *s + DATA_OFFSET);
+#else
 		free(mem);
+#endif
 	} else {
 		GodotProfileFree(mem);
 		free(mem);
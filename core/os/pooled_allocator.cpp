@@ -0,0 +1,303 @@
+/**************************************************************************/
+/*  pooled_allocator.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "pooled_allocator.h"
+
+#include "core/os/spin_lock.h"
+#include "core/templates/safe_refcount.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+struct FreeNode {
+	FreeNode *next;
+};
+
+constexpr uint32_t SMALL_CLASS_COUNT = 8; // 16 to 128 bytes, in 16-byte steps.
+constexpr size_t SLAB_SIZE = 64 * 1024;
+constexpr size_t THREAD_CACHE_BYTES = 64 * 1024; // Per class.
+
+static_assert(PooledAllocator::CLASS_COUNT == SMALL_CLASS_COUNT + 4 * 8, "Four classes per power of two from 256 to 32768 bytes.");
+
+struct SizeClassTable {
+	size_t sizes[PooledAllocator::CLASS_COUNT] = {};
+	uint32_t cache_limits[PooledAllocator::CLASS_COUNT] = {};
+};
+
+constexpr SizeClassTable make_size_class_table() {
+	SizeClassTable table;
+	for (uint32_t i = 0; i < PooledAllocator::CLASS_COUNT; i++) {
+		if (i < SMALL_CLASS_COUNT) {
+			table.sizes[i] = (i + 1) << 4;
+		} else {
+			const uint32_t shift = (i - SMALL_CLASS_COUNT) / 4 + 8;
+			table.sizes[i] = (size_t)((i - SMALL_CLASS_COUNT) % 4 + 5) << (shift - 3);
+		}
+		table.cache_limits[i] = MAX((uint32_t)4, (uint32_t)(THREAD_CACHE_BYTES / table.sizes[i]));
+	}
+	return table;
+}
+
+constexpr SizeClassTable size_classes = make_size_class_table();
+static_assert(size_classes.sizes[PooledAllocator::CLASS_COUNT - 1] == PooledAllocator::MAX_POOLED_SIZE);
+
+struct CentralList {
+	SpinLock lock;
+	FreeNode *head = nullptr;
+};
+
+CentralList central_lists[PooledAllocator::CLASS_COUNT];
+SafeNumeric<uint64_t> reserved_memory;
+
+// Trivially destructible so that it stays usable while the thread is being torn down.
+struct ThreadCache {
+	FreeNode *heads[PooledAllocator::CLASS_COUNT];
+	uint32_t counts[PooledAllocator::CLASS_COUNT];
+	bool registered;
+	bool released;
+};
+
+thread_local ThreadCache thread_cache;
+
+// Returns the cached memory of an exiting thread to the shared lists.
+struct ThreadCacheReleaser {
+	bool active = false;
+
+	~ThreadCacheReleaser();
+};
+
+thread_local ThreadCacheReleaser thread_cache_releaser;
+
+// Constructs the releaser of the calling thread, so that it runs on exit.
+_FORCE_INLINE_ void ensure_registered(ThreadCache &r_cache) {
+	if (unlikely(!r_cache.registered)) {
+		r_cache.registered = true;
+		thread_cache_releaser.active = true;
+	}
+}
+
+void push_central(uint32_t p_size_class, FreeNode *p_first, FreeNode *p_last) {
+	CentralList &list = central_lists[p_size_class];
+	list.lock.lock();
+	p_last->next = list.head;
+	list.head = p_first;
+	list.lock.unlock();
+}
+
+// Takes up to `p_max` nodes from the shared list of the class, or carves a new slab if it is empty.
+FreeNode *take_nodes(uint32_t p_size_class, uint32_t p_max, uint32_t &r_count) {
+	CentralList &list = central_lists[p_size_class];
+	list.lock.lock();
+	FreeNode *first = list.head;
+	if (first) {
+		FreeNode *last = first;
+		r_count = 1;
+		while (r_count < p_max && last->next) {
+			last = last->next;
+			r_count++;
+		}
+		list.head = last->next;
+		last->next = nullptr;
+	}
+	list.lock.unlock();
+
+	if (first) {
+		return first;
+	}
+
+	const size_t size = size_classes.sizes[p_size_class];
+	const uint32_t count = MAX((uint32_t)8, (uint32_t)(SLAB_SIZE / size));
+	uint8_t *slab = static_cast<uint8_t *>(malloc(size * count));
+	if (unlikely(!slab)) {
+		r_count = 0;
+		return nullptr;
+	}
+	reserved_memory.add(size * count);
+
+	for (uint32_t i = 0; i < count - 1; i++) {
+		reinterpret_cast<FreeNode *>(slab + i * size)->next = reinterpret_cast<FreeNode *>(slab + (i + 1) * size);
+	}
+	reinterpret_cast<FreeNode *>(slab + (count - 1) * size)->next = nullptr;
+	r_count = count;
+	return reinterpret_cast<FreeNode *>(slab);
+}
+
+ThreadCacheReleaser::~ThreadCacheReleaser() {
+	ThreadCache &cache = thread_cache;
+	for (uint32_t i = 0; i < PooledAllocator::CLASS_COUNT; i++) {
+		FreeNode *first = cache.heads[i];
+		if (!first) {
+			continue;
+		}
+		FreeNode *last = first;
+		while (last->next) {
+			last = last->next;
+		}
+		push_central(i, first, last);
+		cache.heads[i] = nullptr;
+		cache.counts[i] = 0;
+	}
+	// Anything allocated or freed from now on bypasses the cache.
+	cache.released = true;
+}
+
+} // namespace
+
+uint32_t PooledAllocator::get_size_class(size_t p_bytes) {
+	if (p_bytes <= 128) {
+		return p_bytes ? (uint32_t)((p_bytes - 1) >> 4) : 0;
+	}
+	// Requests in (2^(shift - 1), 2^shift] are split into four classes.
+	const size_t rounded = p_bytes - 1;
+	uint32_t shift = 8;
+	while (rounded >> shift) {
+		shift++;
+	}
+	return SMALL_CLASS_COUNT + (shift - 8) * 4 + (uint32_t)(rounded >> (shift - 3)) - 4;
+}
+
+size_t PooledAllocator::get_class_size(uint32_t p_size_class) {
+	return size_classes.sizes[p_size_class];
+}
+
+void *PooledAllocator::alloc(size_t p_bytes) {
+	if (p_bytes > MAX_POOLED_SIZE) {
+		return malloc(p_bytes);
+	}
+
+	const uint32_t size_class = get_size_class(p_bytes);
+	ThreadCache &cache = thread_cache;
+
+	if (unlikely(cache.released)) {
+		uint32_t count = 0;
+		FreeNode *node = take_nodes(size_class, 1, count);
+		if (node && node->next) {
+			// A fresh slab; keep the rest of it for others.
+			FreeNode *last = node->next;
+			while (last->next) {
+				last = last->next;
+			}
+			push_central(size_class, node->next, last);
+		}
+		return node;
+	}
+
+	FreeNode *node = cache.heads[size_class];
+	if (unlikely(!node)) {
+		ensure_registered(cache);
+		uint32_t count = 0;
+		node = take_nodes(size_class, size_classes.cache_limits[size_class] / 2, count);
+		if (unlikely(!node)) {
+			return nullptr;
+		}
+		cache.counts[size_class] = count;
+	}
+
+	cache.heads[size_class] = node->next;
+	cache.counts[size_class]--;
+	return node;
+}
+
+void *PooledAllocator::alloc_zeroed(size_t p_bytes) {
+	if (p_bytes > MAX_POOLED_SIZE) {
+		return calloc(1, p_bytes);
+	}
+
+	void *mem = alloc(p_bytes);
+	if (mem) {
+		memset(mem, 0, p_bytes);
+	}
+	return mem;
+}
+
+void *PooledAllocator::realloc(void *p_memory, size_t p_old_bytes, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+
+	if (p_old_bytes > MAX_POOLED_SIZE && p_bytes > MAX_POOLED_SIZE) {
+		return ::realloc(p_memory, p_bytes);
+	}
+	if (p_old_bytes <= MAX_POOLED_SIZE && p_bytes <= MAX_POOLED_SIZE && get_size_class(p_old_bytes) == get_size_class(p_bytes)) {
+		return p_memory;
+	}
+
+	void *mem = alloc(p_bytes);
+	if (mem) {
+		memcpy(mem, p_memory, MIN(p_old_bytes, p_bytes));
+		free(p_memory, p_old_bytes);
+	}
+	return mem;
+}
+
+void PooledAllocator::free(void *p_memory, size_t p_bytes) {
+	if (p_bytes > MAX_POOLED_SIZE) {
+		::free(p_memory);
+		return;
+	}
+
+	const uint32_t size_class = get_size_class(p_bytes);
+	FreeNode *node = static_cast<FreeNode *>(p_memory);
+	ThreadCache &cache = thread_cache;
+
+	if (unlikely(cache.released)) {
+		push_central(size_class, node, node);
+		return;
+	}
+
+	ensure_registered(cache);
+	node->next = cache.heads[size_class];
+	cache.heads[size_class] = node;
+	cache.counts[size_class]++;
+
+	const uint32_t limit = size_classes.cache_limits[size_class];
+	if (unlikely(cache.counts[size_class] > limit)) {
+		// Hand the least recently freed half over to other threads, recently freed memory is more likely to be in cache.
+		const uint32_t keep = cache.counts[size_class] - limit / 2;
+		FreeNode *last_kept = node;
+		for (uint32_t i = 1; i < keep; i++) {
+			last_kept = last_kept->next;
+		}
+		FreeNode *first = last_kept->next;
+		FreeNode *last = first;
+		while (last->next) {
+			last = last->next;
+		}
+		last_kept->next = nullptr;
+		cache.counts[size_class] = keep;
+		push_central(size_class, first, last);
+	}
+}
+
+uint64_t PooledAllocator::get_reserved_memory() {
+	return reserved_memory.get();
+}
@@ -0,0 +1,61 @@
+/**************************************************************************/
+/*  pooled_allocator.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Size-class allocator with thread-local caches.
+//
+// Memory::alloc_static() and friends use it as their backend when the engine is built with
+// `pooled_allocator=yes`, instead of going to the system allocator for every request.
+// Requests up to MAX_POOLED_SIZE bytes are rounded up to one of CLASS_COUNT size classes and
+// served from a per-thread free list, which is refilled from (and overflows to) a shared list
+// per class. Larger requests are forwarded to malloc().
+//
+// Memory of pooled classes is carved out of slabs that are kept for reuse and never returned
+// to the system. The size that was requested must be passed back on free() and realloc().
+class PooledAllocator {
+public:
+	static constexpr size_t MAX_POOLED_SIZE = 32 * 1024;
+	static constexpr uint32_t CLASS_COUNT = 40;
+
+	static void *alloc(size_t p_bytes);
+	static void *alloc_zeroed(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_old_bytes, size_t p_bytes);
+	static void free(void *p_memory, size_t p_bytes);
+
+	// Size class for a request; 16-byte steps up to 128 bytes, then four classes per power of two.
+	static uint32_t get_size_class(size_t p_bytes);
+	static size_t get_class_size(uint32_t p_size_class);
+
+	// Memory held in slabs, whether handed out or cached.
+	static uint64_t get_reserved_memory();
+};
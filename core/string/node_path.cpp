@@ -421,38 +421,41 @@ NodePath::NodePath(const String &p_path) {
 		return;
 	}
 
-	String path = p_path;
+	// Names are interned straight from the source characters; building a
+	// temporary String per slice would allocate even when the name exists.
+	const char32_t *chars = p_path.ptr();
+	const int length = p_path.length();
 	Vector<StringName> subpath;
 
-	bool absolute = (path[0] == '/');
+	bool absolute = (chars[0] == '/');
 	bool last_is_slash = true;
 	int slices = 0;
-	int subpath_pos = path.find_char(':');
+	int subpath_pos = p_path.find_char(':');
+	int path_length = length;
 
 	if (subpath_pos != -1) {
 		int from = subpath_pos + 1;
 
-		for (int i = from; i <= path.length(); i++) {
-			if (path[i] == ':' || path[i] == 0) {
-				String str = path.substr(from, i - from);
-				if (str.is_empty()) {
-					if (path[i] == 0) {
+		for (int i = from; i <= length; i++) {
+			if (i == length || chars[i] == ':') {
+				if (i == from) {
+					if (i == length) {
 						continue; // Allow end-of-path :
 					}
 
 					ERR_FAIL_MSG(vformat("Invalid NodePath '%s'.", p_path));
 				}
-				subpath.push_back(str);
+				subpath.push_back(StringName(Span(chars + from, i - from)));
 
 				from = i + 1;
 			}
 		}
 
-		path = path.substr(0, subpath_pos);
+		path_length = subpath_pos;
 	}
 
-	for (int i = (int)absolute; i < path.length(); i++) {
-		if (path[i] == '/') {
+	for (int i = (int)absolute; i < path_length; i++) {
+		if (chars[i] == '/') {
 			last_is_slash = true;
 		} else {
 			if (last_is_slash) {
@@ -481,12 +484,11 @@ NodePath::NodePath(const String &p_path) {
 	int from = (int)absolute;
 	int slice = 0;
 
-	for (int i = (int)absolute; i < path.length() + 1; i++) {
-		if (path[i] == '/' || path[i] == 0) {
+	for (int i = (int)absolute; i < path_length + 1; i++) {
+		if (i == path_length || chars[i] == '/') {
 			if (!last_is_slash) {
-				String name = path.substr(from, i - from);
 				ERR_FAIL_INDEX(slice, data->path.size());
-				data->path.write[slice++] = name;
+				data->path.write[slice++] = StringName(Span(chars + from, i - from));
 			}
 			from = i + 1;
 			last_is_slash = true;
@@ -30,42 +30,38 @@
 
 #include "string_name.h"
 
-#include "core/os/mutex.h"
+#include "core/core_globals.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
-#include "core/templates/paged_allocator.h"
+#include "core/templates/concurrent_hash_map.h"
 
 struct StringName::Table {
-	constexpr static uint32_t TABLE_BITS = 16;
-	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
-	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
-
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	// Lets names be looked up from `const char *` without converting them first.
+	struct Comparator {
+		static bool compare(const String &p_lhs, const String &p_rhs) { return p_lhs == p_rhs; }
+		static bool compare(const String &p_lhs, const char *p_rhs) { return p_lhs == p_rhs; }
+		static bool compare(const String &p_lhs, const Span<char32_t> &p_rhs) { return p_lhs == p_rhs; }
+	};
+
+	constexpr static uint32_t SHARD_BITS = 6;
+
+	// Lookups don't lock. A name whose refcount dropped to zero stays listed until
+	// the thread releasing it erases it; meanwhile lookups skip it and intern a new one.
+	static inline ConcurrentHashMap<String, _Data, HashMapHasherDefault, Comparator, SHARD_BITS> names;
 };
 
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
-	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
-
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
-			while (d) {
-				data.push_back(d);
-				d = d->next;
-			}
-		}
+		Table::names.for_each([&data](const String &p_name, _Data &p_data) {
+			data.push_back(&p_data);
+		});
 
 		print_line("\nStringName reference ranking (from most to least referenced):\n");
 
@@ -74,10 +70,11 @@ void StringName::cleanup() {
 		int rarely_referenced_stringnames = 0;
 		const int data_size = data.size();
 		for (int i = 0; i < data_size; i++) {
-			print_line(itos(i + 1) + ": " + data[i]->name + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			const uint32_t references = data[i]->debug_references.get();
+			print_line(itos(i + 1) + ": " + data[i]->name + " - " + itos(references));
+			if (references == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (references < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -87,47 +84,88 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
-			if (d->static_count.get() != d->refcount.get()) {
-				lost_strings++;
-
-				if (OS::get_singleton()->is_stdout_verbose()) {
-					print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", d->name, d->static_count.get(), d->refcount.get()));
-				}
-			}
+	Table::names.for_each([&lost_strings](const String &p_name, _Data &p_data) {
+		if (p_data.static_count.get() != p_data.refcount.get()) {
+			lost_strings++;
 
-			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+			if (OS::get_singleton()->is_stdout_verbose()) {
+				print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", p_data.name, p_data.static_count.get(), p_data.refcount.get()));
+			}
 		}
-	}
+	});
+	Table::names.clear();
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
 }
 
+template <typename T>
+StringName::_Data *StringName::_intern(const T &p_name, uint32_t p_hash, bool p_static) {
+	_Data *data = nullptr;
+	const auto acquire = [&data](_Data &p_data) {
+		// Fails if the name is being released.
+		if (!p_data.refcount.ref()) {
+			return false;
+		}
+		data = &p_data;
+		return true;
+	};
+
+	bool created = false;
+	if (!Table::names.read_hashed(p_hash, p_name, acquire)) {
+		const auto insert = [&](const auto &p_key) {
+			Table::names.find_or_insert_hashed(p_hash, p_key, acquire, [&](_Data &p_data) {
+				p_data.name = p_key;
+				p_data.refcount.init();
+				p_data.static_count.set(p_static ? 1 : 0);
+				p_data.hash = p_hash;
+#ifdef DEBUG_ENABLED
+				if (unlikely(debug_stringname)) {
+					// Keep in memory, force static.
+					p_data.refcount.ref();
+					p_data.static_count.increment();
+				}
+#endif
+				data = &p_data;
+				created = true;
+			});
+		};
+
+		if constexpr (std::is_same_v<T, Span<char32_t>>) {
+			// Spans are only copied into a String once the name turns out to be new.
+			insert(String::utf32_unchecked(p_name));
+		} else {
+			insert(p_name);
+		}
+	}
+
+	if (!created) {
+		// exists
+		if (p_static) {
+			data->static_count.increment();
+		}
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			data->debug_references.increment();
+		}
+#endif
+	}
+	return data;
+}
+
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
-
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
 		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
-		Table::allocator.free(_data);
+		// Nobody else can erase it, so it's safe to use until then.
+		const _Data *data = _data;
+		Table::names.erase_if_hashed(data->hash, data->name, [data](const _Data &p_data) {
+			return &p_data == data;
+		});
 	}
 
 	_data = nullptr;
@@ -212,52 +250,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = _intern(p_name, String::hash(p_name), p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -269,51 +262,19 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
+	_data = _intern(p_name, p_name.hash(), p_static);
+}
 
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
+StringName::StringName(const Span<char32_t> &p_name, bool p_static) {
+	_data = nullptr;
 
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
+	ERR_FAIL_COND(!configured);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
+	if (p_name.is_empty()) {
 		return;
 	}
 
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = _intern(p_name, String::hash(p_name.ptr(), (int)p_name.size()), p_static);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -54,16 +54,16 @@ class [[nodiscard]] _WARN_UNUSED_ StringName {
 		SafeNumeric<uint32_t> static_count;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
 	};
 
 	_Data *_data = nullptr;
 
+	template <typename T>
+	static _Data *_intern(const T &p_name, uint32_t p_hash, bool p_static);
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
@@ -75,7 +75,7 @@ class [[nodiscard]] _WARN_UNUSED_ StringName {
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
@@ -180,6 +180,8 @@ public:
 		p_name._data = nullptr;
 	}
 	StringName(const String &p_name, bool p_static = false);
+	// Interns a run of characters without first copying it into a String.
+	explicit StringName(const Span<char32_t> &p_name, bool p_static = false);
 	StringName() {}
 
 #ifdef SIZE_EXTRA
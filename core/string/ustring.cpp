@@ -2755,6 +2755,12 @@ uint32_t String::hash(const char32_t *p_cstr) {
 }
 
 uint32_t String::hash() const {
+	// Strings used as keys are hashed over and over, e.g. each time a StringName is made from them.
+	const uint32_t cached = _cowdata.get_user_data();
+	if (cached != 0) {
+		return cached;
+	}
+
 	/* simple djb2 hashing */
 
 	const char32_t *chr = get_data();
@@ -2766,6 +2772,8 @@ uint32_t String::hash() const {
 		c = *chr++;
 	}
 
+	// Shared buffers are immutable, so threads sharing one can only ever store the same value.
+	_cowdata.set_user_data(hashv);
 	return hashv;
 }
 
@@ -3577,19 +3585,28 @@ String String::format(const Variant &p_values, const String &p_placeholder) cons
 #endif // DISABLE_DEPRECATED
 
 			// Array structure ["RobotGuy", "Logis", "rookie"].
-			String val = values_arr[i];
-
+			// Values are only stringified once their placeholder is known to be present.
 			if (p_placeholder.contains_char('_')) {
-				new_string = new_string.replace(p_placeholder.replace("_", String::num_int64(i)), val);
+				String placeholder = p_placeholder.replace("_", String::num_int64(i));
+				int pos = new_string.find(placeholder);
+				if (pos != -1) {
+					new_string = _replace_common(new_string, placeholder, values_arr[i], false, pos);
+				}
 			} else {
-				new_string = new_string.replace_first(p_placeholder, val);
+				if (new_string.contains(p_placeholder)) {
+					new_string = new_string.replace_first(p_placeholder, values_arr[i]);
+				}
 			}
 		}
 	} else if (p_values.get_type() == Variant::DICTIONARY) {
 		Dictionary d = p_values;
 
 		for (const KeyValue<Variant, Variant> &kv : d) {
-			new_string = new_string.replace(p_placeholder.replace("_", kv.key), kv.value);
+			String placeholder = p_placeholder.replace("_", kv.key);
+			int pos = new_string.find(placeholder);
+			if (pos != -1) {
+				new_string = _replace_common(new_string, placeholder, kv.value, false, pos);
+			}
 		}
 	} else if (p_values.get_type() == Variant::OBJECT) {
 		Object *obj = p_values.get_validated_object();
@@ -5061,7 +5078,21 @@ String String::path_join(const String &p_file) const {
 	if (operator[](length() - 1) == '/' || (p_file.size() > 0 && p_file.operator[](0) == '/')) {
 		return *this + p_file;
 	}
-	return *this + "/" + p_file;
+
+	// Joined in place; chaining `+` here would allocate an intermediate string.
+	const int this_len = length();
+	const int file_len = p_file.length();
+
+	String joined;
+	joined.resize_uninitialized(this_len + 1 + file_len + 1);
+	char32_t *dst = joined.ptrw();
+	memcpy(dst, ptr(), this_len * sizeof(char32_t));
+	dst[this_len] = '/';
+	if (file_len > 0) {
+		memcpy(dst + this_len + 1, p_file.ptr(), file_len * sizeof(char32_t));
+	}
+	dst[this_len + 1 + file_len] = 0;
+	return joined;
 }
 
 String String::property_name_encode() const {
@@ -156,10 +156,12 @@ public:
 
 	_FORCE_INLINE_ void operator=(const T &p_other) const {
 		_cowdata.set(_index, p_other);
+		_cowdata.set_user_data(0); // String keeps its hash there.
 	}
 
 	_FORCE_INLINE_ void operator=(const CharProxy<T> &p_other) const {
 		_cowdata.set(_index, p_other.operator T());
+		_cowdata.set_user_data(0);
 	}
 };
 
@@ -304,12 +306,21 @@ class [[nodiscard]] _WARN_UNUSED_ String {
 	int _count(const char *p_string, int p_from, int p_to, bool p_case_insensitive) const;
 	String _separate_compound_words() const;
 
+	// The hash is cached in the CowData user data, see hash().
+	// Every method that changes the characters must call this after the write, once the buffer is ours.
+	_FORCE_INLINE_ void _clear_cached_hash() { _cowdata.set_user_data(0); }
+
 public:
 	enum {
 		npos = -1 ///<for "some" compatibility with std::string (npos is a huge value in std::string)
 	};
 
-	_FORCE_INLINE_ char32_t *ptrw() _LIFETIME_BOUND_ { return _cowdata.ptrw(); }
+	// Writes through the returned pointer must be done before hash() is called again.
+	_FORCE_INLINE_ char32_t *ptrw() _LIFETIME_BOUND_ {
+		char32_t *w = _cowdata.ptrw();
+		_clear_cached_hash();
+		return w;
+	}
 	_FORCE_INLINE_ const char32_t *ptr() const _LIFETIME_BOUND_ { return _cowdata.ptr(); }
 	_FORCE_INLINE_ const char32_t *get_data() const _LIFETIME_BOUND_ { return size() ? ptr() : &_null; }
 
@@ -323,16 +334,26 @@ public:
 	_FORCE_INLINE_ operator Span<char32_t>() const _LIFETIME_BOUND_ { return Span(ptr(), length()); }
 	_FORCE_INLINE_ Span<char32_t> span() const _LIFETIME_BOUND_ { return Span(ptr(), length()); }
 
-	void remove_at(int p_index) { _cowdata.remove_at(p_index); }
+	void remove_at(int p_index) {
+		_cowdata.remove_at(p_index);
+		_clear_cached_hash();
+	}
 
 	_FORCE_INLINE_ void clear() { resize_uninitialized(0); }
 
 	_FORCE_INLINE_ char32_t get(int p_index) const { return _cowdata.get(p_index); }
-	_FORCE_INLINE_ void set(int p_index, const char32_t &p_elem) { _cowdata.set(p_index, p_elem); }
+	_FORCE_INLINE_ void set(int p_index, const char32_t &p_elem) {
+		_cowdata.set(p_index, p_elem);
+		_clear_cached_hash();
+	}
 
 	/// Resizes the string. The given size must include the null terminator.
 	/// New characters are not initialized, and should be set by the caller.
-	Error resize_uninitialized(int64_t p_size) { return _cowdata.resize<false>(p_size); }
+	Error resize_uninitialized(int64_t p_size) {
+		const Error err = _cowdata.resize<false>(p_size);
+		_clear_cached_hash();
+		return err;
+	}
 
 	Error reserve(int64_t p_size) {
 		ERR_FAIL_COND_V(p_size < 0, ERR_INVALID_PARAMETER);
@@ -47,13 +47,15 @@ class Variant;
  *
  * Key-values are not pointer-stable.
  * Indices are stable as long as no elements are removed; otherwise arbitrary.
+ * Storage comes from `Allocator`, which provides static alloc/alloc_zeroed/realloc/free (e.g. FrameArena).
  *
  * Core container guidance:
  * https://docs.godotengine.org/en/latest/engine_details/architecture/core_types.html#containers
  */
 template <typename TKey, typename TValue,
 		typename Hasher = HashMapHasherDefault,
-		typename Comparator = HashMapComparatorDefault<TKey>>
+		typename Comparator = HashMapComparatorDefault<TKey>,
+		typename Allocator = DefaultAllocator>
 class _WARN_UNUSED_ AHashMap {
 public:
 	// Must be a power of two.
@@ -190,8 +192,8 @@ private:
 
 		Metadata *old_map_data = _metadata;
 
-		_metadata = reinterpret_cast<Metadata *>(Memory::alloc_static_zeroed(sizeof(Metadata) * real_capacity));
-		_elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(_elements, sizeof(MapKeyValue) * (_get_resize_count(_capacity_mask) + 1)));
+		_metadata = reinterpret_cast<Metadata *>(Allocator::alloc_zeroed(sizeof(Metadata) * real_capacity));
+		_elements = reinterpret_cast<MapKeyValue *>(Allocator::realloc(_elements, sizeof(MapKeyValue) * (_get_resize_count(_capacity_mask) + 1)));
 
 		if (_size != 0) {
 			for (uint32_t i = 0; i < real_old_capacity; i++) {
@@ -202,7 +204,7 @@ private:
 			}
 		}
 
-		Memory::free_static(old_map_data);
+		Allocator::free(old_map_data);
 	}
 
 	int32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
@@ -210,8 +212,8 @@ private:
 			// Allocate on demand to save memory.
 
 			uint32_t real_capacity = _capacity_mask + 1;
-			_metadata = reinterpret_cast<Metadata *>(Memory::alloc_static_zeroed(sizeof(Metadata) * real_capacity));
-			_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * (_get_resize_count(_capacity_mask) + 1)));
+			_metadata = reinterpret_cast<Metadata *>(Allocator::alloc_zeroed(sizeof(Metadata) * real_capacity));
+			_elements = reinterpret_cast<MapKeyValue *>(Allocator::alloc(sizeof(MapKeyValue) * (_get_resize_count(_capacity_mask) + 1)));
 		}
 
 		if (unlikely(_size > _get_resize_count(_capacity_mask))) {
@@ -234,8 +236,8 @@ private:
 			return;
 		}
 
-		_metadata = reinterpret_cast<Metadata *>(Memory::alloc_static(sizeof(Metadata) * real_capacity));
-		_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * (_get_resize_count(_capacity_mask) + 1)));
+		_metadata = reinterpret_cast<Metadata *>(Allocator::alloc(sizeof(Metadata) * real_capacity));
+		_elements = reinterpret_cast<MapKeyValue *>(Allocator::alloc(sizeof(MapKeyValue) * (_get_resize_count(_capacity_mask) + 1)));
 
 		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
 			void *destination = _elements;
@@ -686,8 +688,8 @@ public:
 					_elements[i].value.~TValue();
 				}
 			}
-			Memory::free_static(_elements);
-			Memory::free_static(_metadata);
+			Allocator::free(_elements);
+			Allocator::free(_metadata);
 			_elements = nullptr;
 		}
 		_capacity_mask = INITIAL_CAPACITY - 1;
@@ -33,7 +33,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/condition_variable.h"
 #include "core/os/mutex.h"
-#include "core/templates/local_vector.h"
+#include "core/os/thread.h"
 #include "core/templates/tuple.h"
 #include "core/typedefs.h"
 
@@ -104,55 +104,165 @@ class CommandQueueMT {
 
 	/***** BASE *******/
 
-	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	// Every producing thread writes into one of PRODUCER_COUNT single-producer
+	// buffers, claimed for the duration of a push, so concurrent pushes don't
+	// contend on a shared lock. Each command takes a ticket from a shared
+	// counter while its buffer is claimed, and the flushing thread merges the
+	// buffers back in ticket order, so commands still run in the order they
+	// were pushed, also across threads.
+	static const uint32_t PRODUCER_COUNT = 16;
+	static const uint32_t BLOCK_SIZE = 16384;
+
+	// Buffers are linked lists of blocks. Commands never move once written,
+	// so they are called in place.
+	struct Block {
+		std::atomic<Block *> next{ nullptr };
+		std::atomic<uint32_t> committed{ 0 }; // Bytes of data ready to be read.
+		alignas(uint64_t) uint8_t data[BLOCK_SIZE];
+	};
+
+	struct CommandHeader {
+		uint64_t ticket = 0;
+		uint64_t size = 0;
+	};
+
+	struct Producer {
+		std::atomic<bool> busy{ false };
+		std::atomic<Block *> first_block{ nullptr };
+		std::atomic<Block *> spare_block{ nullptr };
+
+		// Only accessed by the thread that claimed the producer.
+		Block *write_block = nullptr;
+		uint32_t write_pos = 0;
+
+		// Only accessed by the flushing thread.
+		Block *read_block = nullptr;
+		uint32_t read_pos = 0;
+
+		char padding[Thread::CACHE_LINE_BYTES];
+	};
 
 	inline static thread_local bool flushing = false;
+	inline static thread_local uint32_t producer_hint = UINT32_MAX;
+
+	Producer producers[PRODUCER_COUNT];
+	std::atomic<uint64_t> next_ticket{ 0 };
+	std::atomic<bool> pending{ false };
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id{ WorkerThreadPool::INVALID_TASK_ID };
+
+	BinaryMutex flush_mutex;
+	uint64_t flush_ticket = 0; // Protected by flush_mutex.
+	uint32_t flush_producer = 0; // Protected by flush_mutex.
 
 	BinaryMutex mutex;
-	LocalVector<uint8_t> command_mem;
 	ConditionVariable sync_cond_var;
-	uint32_t sync_head = 0;
-	uint32_t sync_tail = 0;
-	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
-	uint64_t flush_read_ptr = 0;
-	std::atomic<bool> pending{ false };
+	uint64_t sync_head = 0; // Protected by mutex.
+
+	static Block *_alloc_block() {
+		return memnew_placement(memalloc(sizeof(Block)), Block);
+	}
+
+	Producer &_claim_producer() {
+		uint32_t index = producer_hint;
+		if (unlikely(index == UINT32_MAX)) {
+			index = Thread::get_caller_id() % PRODUCER_COUNT;
+		}
+		while (true) {
+			Producer &producer = producers[index];
+			if (!producer.busy.load(std::memory_order_relaxed) && !producer.busy.exchange(true, std::memory_order_acquire)) {
+				producer_hint = index;
+				return producer;
+			}
+			index = (index + 1) % PRODUCER_COUNT;
+		}
+	}
 
 	template <typename T, typename... Args>
-	_FORCE_INLINE_ void create_command(Args &&...p_args) {
+	_FORCE_INLINE_ uint64_t create_command(Producer &p_producer, Args &&...p_args) {
 		// alloc size is size+T+safeguard
 		constexpr uint64_t alloc_size = ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
-		static_assert(alloc_size < UINT32_MAX, "Type too large to fit in the command queue.");
-
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + sizeof(uint64_t));
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		void *cmd = &command_mem[size + sizeof(uint64_t)];
-		memnew_placement(cmd, T(std::forward<Args>(p_args)...));
-		pending.store(true);
+		static_assert(alloc_size + sizeof(CommandHeader) <= BLOCK_SIZE, "Type too large to fit in the command queue.");
+
+		if (unlikely(!p_producer.write_block)) {
+			p_producer.write_block = _alloc_block();
+			p_producer.first_block.store(p_producer.write_block, std::memory_order_release);
+		} else if (p_producer.write_pos + sizeof(CommandHeader) + alloc_size > BLOCK_SIZE) {
+			Block *block = p_producer.spare_block.exchange(nullptr, std::memory_order_acquire);
+			if (block) {
+				block->next.store(nullptr, std::memory_order_relaxed);
+				block->committed.store(0, std::memory_order_relaxed);
+			} else {
+				block = _alloc_block();
+			}
+			p_producer.write_block->next.store(block, std::memory_order_release);
+			p_producer.write_block = block;
+			p_producer.write_pos = 0;
+		}
+
+		uint64_t ticket = next_ticket.fetch_add(1);
+
+		CommandHeader *header = memnew_placement(&p_producer.write_block->data[p_producer.write_pos], CommandHeader);
+		header->ticket = ticket;
+		header->size = alloc_size;
+		memnew_placement(header + 1, T(std::forward<Args>(p_args)...));
+
+		p_producer.write_pos += sizeof(CommandHeader) + alloc_size;
+		p_producer.write_block->committed.store(p_producer.write_pos, std::memory_order_release);
+		return ticket;
+	}
+
+	_FORCE_INLINE_ void _notify_pump() {
+		WorkerThreadPool::TaskID task_id = pump_task_id.load();
+		if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+		}
 	}
 
 	template <typename T, bool NeedsSync, typename... Args>
 	_FORCE_INLINE_ void _push_internal(Args &&...p_args) {
-		MutexLock mlock(mutex);
-		create_command<T>(std::forward<Args>(p_args)...);
-
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);
+		Producer &producer = _claim_producer();
+		uint64_t ticket = create_command<T>(producer, std::forward<Args>(p_args)...);
+		producer.busy.store(false, std::memory_order_release);
+
+		// Only the push that finds the queue idle wakes the server thread up;
+		// a flush clears the flag before it starts reading.
+		if (!pending.load() && !pending.exchange(true)) {
+			_notify_pump();
 		}
 
 		if constexpr (NeedsSync) {
-			sync_tail++;
-			_wait_for_sync(mlock);
+			_wait_for_sync(ticket);
 		}
 	}
 
-	_FORCE_INLINE_ void _prevent_sync_wraparound() {
-		bool safe_to_reset = !sync_awaiters;
-		bool already_sync_to_latest = sync_head == sync_tail;
-		if (safe_to_reset && already_sync_to_latest) {
-			sync_head = 0;
-			sync_tail = 0;
+	// Returns the next committed command of the given producer, if any.
+	CommandHeader *_peek(Producer &p_producer) {
+		if (unlikely(!p_producer.read_block)) {
+			p_producer.read_block = p_producer.first_block.load(std::memory_order_acquire);
+			if (!p_producer.read_block) {
+				return nullptr;
+			}
+		}
+
+		while (true) {
+			Block *block = p_producer.read_block;
+			if (p_producer.read_pos < block->committed.load(std::memory_order_acquire)) {
+				return reinterpret_cast<CommandHeader *>(&block->data[p_producer.read_pos]);
+			}
+			Block *next = block->next.load(std::memory_order_acquire);
+			if (!next) {
+				return nullptr;
+			}
+			// The producer commits its last command before linking the next block.
+			if (p_producer.read_pos < block->committed.load(std::memory_order_acquire)) {
+				continue;
+			}
+			p_producer.read_block = next;
+			p_producer.read_pos = 0;
+			Block *old_spare = p_producer.spare_block.exchange(block, std::memory_order_acq_rel);
+			if (old_spare) {
+				memfree(old_spare);
+			}
 		}
 	}
 
@@ -164,62 +274,63 @@ class CommandQueueMT {
 
 		flushing = true;
 
-		MutexLock lock(mutex);
-
-		if (unlikely(flush_read_ptr)) {
-			// Another thread is flushing.
-			lock.temp_unlock(); // Not really temp.
-			sync();
-			flushing = false;
-			return;
-		}
+		// If another thread is flushing, this waits for it to finish and then runs whatever is left.
+		MutexLock lock(flush_mutex);
 
-		alignas(uint64_t) char cmd_local_mem[MAX_COMMAND_SIZE];
+		pending.store(false);
 
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += sizeof(uint64_t);
+		uint64_t issued = next_ticket.load();
+		while (flush_ticket < issued) {
+			// Runs of commands from the same producer are common, so look there first.
+			Producer *producer = nullptr;
+			CommandHeader *header = nullptr;
+			for (uint32_t i = 0; i < PRODUCER_COUNT; i++) {
+				Producer &candidate = producers[(flush_producer + i) % PRODUCER_COUNT];
+				header = _peek(candidate);
+				if (header && header->ticket == flush_ticket) {
+					producer = &candidate;
+					flush_producer = (flush_producer + i) % PRODUCER_COUNT;
+					break;
+				}
+			}
 
-			// Protect against race condition between this thread
-			// during the call to the command and other threads potentially
-			// invalidating the pointer due to reallocs by relocating the object.
-			CommandBase *cmd_original = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			CommandBase *cmd_local = reinterpret_cast<CommandBase *>(cmd_local_mem);
-			memcpy(cmd_local_mem, (char *)cmd_original, size);
+			if (unlikely(!producer)) {
+				// The ticket was taken, but its command is still being written.
+#ifdef THREADS_ENABLED
+				Thread::yield();
+#endif
+				continue;
+			}
 
-			lock.temp_unlock();
-			cmd_local->call();
-			lock.temp_relock();
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(header + 1);
+			cmd->call();
 
-			if (unlikely(cmd_local->sync)) {
-				sync_head++;
-				lock.temp_unlock(); // Give an opportunity to awaiters right away.
+			if (unlikely(cmd->sync)) {
+				{
+					MutexLock sync_lock(mutex);
+					sync_head = flush_ticket + 1;
+				}
 				sync_cond_var.notify_all();
-				lock.temp_relock();
 			}
 
-			cmd_local->~CommandBase();
+			cmd->~CommandBase();
 
-			flush_read_ptr += size;
-		}
-
-		command_mem.clear();
-		pending.store(false);
-		flush_read_ptr = 0;
+			producer->read_pos += sizeof(CommandHeader) + header->size;
+			flush_ticket++;
 
-		_prevent_sync_wraparound();
+			if (flush_ticket == issued) {
+				issued = next_ticket.load();
+			}
+		}
 
 		flushing = false;
 	}
 
-	_FORCE_INLINE_ void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
-		sync_awaiters++;
-		uint32_t sync_head_goal = sync_tail;
-		do {
-			sync_cond_var.wait(p_lock);
-		} while (sync_head < sync_head_goal);
-		sync_awaiters--;
-		_prevent_sync_wraparound();
+	_FORCE_INLINE_ void _wait_for_sync(uint64_t p_ticket) {
+		MutexLock lock(mutex);
+		while (sync_head <= p_ticket) {
+			sync_cond_var.wait(lock);
+		}
 	}
 
 	void _no_op() {}
@@ -270,11 +381,26 @@ public:
 	}
 
 	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
-		MutexLock lock(mutex);
-		pump_task_id = p_task_id;
+		pump_task_id.store(p_task_id);
+		// Commands pushed before there was a pump to notify still need to wake it up.
+		if (pending.load()) {
+			_notify_pump();
+		}
 	}
 
-	CommandQueueMT() {
-		command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	CommandQueueMT() {}
+
+	~CommandQueueMT() {
+		for (Producer &producer : producers) {
+			Block *block = producer.read_block ? producer.read_block : producer.first_block.load();
+			while (block) {
+				Block *next = block->next.load();
+				memfree(block);
+				block = next;
+			}
+			if (producer.spare_block.load()) {
+				memfree(producer.spare_block.load());
+			}
+		}
 	}
 };
@@ -0,0 +1,566 @@
+/**************************************************************************/
+/*  concurrent_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+
+#include <atomic>
+
+// Hash map for registries that are read from many threads and written rarely.
+// - Reads (has(), lookup(), read(), size()) never lock. They only touch an
+//   atomic reader count of the shard the key belongs to.
+// - Writes lock one of SHARD_COUNT shards, so writers on different keys
+//   rarely contend.
+// - Buckets are small immutable arrays which writers replace as a whole
+//   (copy-on-write). Replaced buckets, tables and erased elements are
+//   retired and only freed once no reader of their shard can still see them.
+// - Elements never move, so pointers to values stay valid until the element
+//   is erased and every reader which might still see it has left.
+//   synchronize() waits for that explicitly, for values which own
+//   something whose lifetime depends on the map entry.
+// - Lookups may use any key type K accepted by Hasher::hash() and
+//   Comparator::compare(const TKey &, const K &).
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>,
+		uint32_t SHARD_BITS = 5>
+class ConcurrentHashMap {
+public:
+	static constexpr uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	static constexpr uint32_t MIN_CAPACITY = 8;
+
+private:
+	struct Element {
+		uint32_t hash;
+		TKey key;
+		TValue value;
+
+		Element(uint32_t p_hash, const TKey &p_key) :
+				hash(p_hash), key(p_key) {}
+		Element(uint32_t p_hash, const TKey &p_key, const TValue &p_value) :
+				hash(p_hash), key(p_key), value(p_value) {}
+	};
+
+	struct Entry {
+		uint32_t hash;
+		Element *element;
+	};
+
+	// Followed by `size` Entry structs, newest first.
+	struct alignas(Entry) Bucket {
+		uint32_t size;
+	};
+
+	// Followed by `mask + 1` bucket pointers.
+	struct alignas(std::atomic<Bucket *>) Table {
+		uint32_t mask;
+	};
+
+	struct Retired {
+		void *ptr;
+		void (*free_func)(void *);
+	};
+
+	struct Shard {
+		// Read side. Readers register in the slot of the epoch they entered in.
+		std::atomic<uint32_t> epoch{ 0 };
+		std::atomic<uint32_t> readers[2] = {};
+		std::atomic<Table *> table{ nullptr };
+		uint8_t _pad0[Thread::CACHE_LINE_BYTES];
+
+		// Write side, protected by mutex.
+		BinaryMutex mutex;
+		uint32_t size = 0;
+		std::atomic<uint32_t> atomic_size{ 0 };
+		LocalVector<Retired> retired[2];
+	};
+
+	Shard shards[SHARD_COUNT];
+
+	static _FORCE_INLINE_ Entry *_get_entries(Bucket *p_bucket) {
+		return reinterpret_cast<Entry *>(p_bucket + 1);
+	}
+
+	static _FORCE_INLINE_ std::atomic<Bucket *> *_get_buckets(Table *p_table) {
+		return reinterpret_cast<std::atomic<Bucket *> *>(p_table + 1);
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_shard_index(uint32_t p_hash) {
+		return p_hash >> (32 - SHARD_BITS);
+	}
+
+	template <typename K>
+	static _FORCE_INLINE_ uint32_t _hash(const K &p_key) {
+		return hash_fmix32(Hasher::hash(p_key));
+	}
+
+	static Bucket *_alloc_bucket(uint32_t p_size) {
+		Bucket *bucket = static_cast<Bucket *>(Memory::alloc_static(sizeof(Bucket) + sizeof(Entry) * p_size));
+		bucket->size = p_size;
+		return bucket;
+	}
+
+	static Table *_alloc_table(uint32_t p_capacity) {
+		Table *table = static_cast<Table *>(Memory::alloc_static(sizeof(Table) + sizeof(std::atomic<Bucket *>) * p_capacity));
+		table->mask = p_capacity - 1;
+		std::atomic<Bucket *> *buckets = _get_buckets(table);
+		for (uint32_t i = 0; i < p_capacity; i++) {
+			memnew_placement(&buckets[i], std::atomic<Bucket *>(nullptr));
+		}
+		return table;
+	}
+
+	static void _free_element(void *p_ptr) {
+		memdelete(static_cast<Element *>(p_ptr));
+	}
+
+	static void _free_memory(void *p_ptr) {
+		Memory::free_static(p_ptr);
+	}
+
+	static void _free_retired(LocalVector<Retired> &r_retired) {
+		for (const Retired &retired : r_retired) {
+			retired.free_func(retired.ptr);
+		}
+		r_retired.clear();
+	}
+
+	// Read side.
+
+	static _FORCE_INLINE_ uint32_t _read_lock(const Shard &p_shard) {
+		Shard &shard = const_cast<Shard &>(p_shard);
+		while (true) {
+			const uint32_t epoch = shard.epoch.load(std::memory_order_seq_cst);
+			const uint32_t slot = epoch & 1;
+			shard.readers[slot].fetch_add(1, std::memory_order_seq_cst);
+			// If a writer flipped the epoch in between, it may not have seen us. Retry in the new slot.
+			if (likely(shard.epoch.load(std::memory_order_seq_cst) == epoch)) {
+				return slot;
+			}
+			shard.readers[slot].fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	static _FORCE_INLINE_ void _read_unlock(const Shard &p_shard, uint32_t p_slot) {
+		const_cast<Shard &>(p_shard).readers[p_slot].fetch_sub(1, std::memory_order_release);
+	}
+
+	template <typename K, typename V>
+	static _FORCE_INLINE_ bool _read(const Shard &p_shard, uint32_t p_hash, const K &p_key, V &p_visitor) {
+		Table *table = p_shard.table.load(std::memory_order_acquire);
+		if (unlikely(!table)) {
+			return false;
+		}
+		Bucket *bucket = _get_buckets(table)[p_hash & table->mask].load(std::memory_order_acquire);
+		if (!bucket) {
+			return false;
+		}
+		const Entry *entries = _get_entries(bucket);
+		for (uint32_t i = 0; i < bucket->size; i++) {
+			if (entries[i].hash == p_hash && Comparator::compare(entries[i].element->key, p_key)) {
+				if (p_visitor(entries[i].element->value)) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	// Write side, shard mutex must be held.
+
+	void _retire(Shard &p_shard, void *p_ptr, void (*p_free_func)(void *)) {
+		p_shard.retired[p_shard.epoch.load(std::memory_order_relaxed) & 1].push_back({ p_ptr, p_free_func });
+	}
+
+	// Frees what was retired in the previous epoch once its readers are gone,
+	// then starts a new epoch if anything is waiting.
+	void _reclaim(Shard &p_shard) {
+		const uint32_t epoch = p_shard.epoch.load(std::memory_order_relaxed);
+		const uint32_t prev_slot = (epoch + 1) & 1;
+		if (p_shard.readers[prev_slot].load(std::memory_order_seq_cst) != 0) {
+			return;
+		}
+		_free_retired(p_shard.retired[prev_slot]);
+		if (!p_shard.retired[epoch & 1].is_empty()) {
+			p_shard.epoch.store(epoch + 1, std::memory_order_seq_cst);
+		}
+	}
+
+	static void _wait_for_readers(Shard &p_shard, uint32_t p_slot) {
+		while (p_shard.readers[p_slot].load(std::memory_order_seq_cst) != 0) {
+#ifdef THREADS_ENABLED
+			Thread::yield();
+#endif
+		}
+	}
+
+	void _synchronize(Shard &p_shard) {
+		const uint32_t epoch = p_shard.epoch.load(std::memory_order_relaxed);
+		const uint32_t prev_slot = (epoch + 1) & 1;
+		_wait_for_readers(p_shard, prev_slot);
+		_free_retired(p_shard.retired[prev_slot]);
+		p_shard.epoch.store(epoch + 1, std::memory_order_seq_cst);
+		_wait_for_readers(p_shard, epoch & 1);
+		_free_retired(p_shard.retired[epoch & 1]);
+	}
+
+	std::atomic<Bucket *> &_get_bucket_slot(Shard &p_shard, uint32_t p_hash) {
+		Table *table = p_shard.table.load(std::memory_order_relaxed);
+		return _get_buckets(table)[p_hash & table->mask];
+	}
+
+	// Publishes `p_element` in front of its bucket. If `p_replace_index` is
+	// valid, the entry at that index of the old bucket is dropped and retired.
+	void _publish(Shard &p_shard, Element *p_element, int32_t p_replace_index = -1) {
+		Table *table = p_shard.table.load(std::memory_order_relaxed);
+		if (unlikely(!table)) {
+			table = _alloc_table(MIN_CAPACITY);
+			p_shard.table.store(table, std::memory_order_release);
+		} else if (p_replace_index < 0 && p_shard.size >= table->mask + 1) {
+			_grow(p_shard);
+		}
+
+		std::atomic<Bucket *> &slot = _get_bucket_slot(p_shard, p_element->hash);
+		Bucket *old_bucket = slot.load(std::memory_order_relaxed);
+		const uint32_t old_size = old_bucket ? old_bucket->size : 0;
+
+		Bucket *bucket = _alloc_bucket(p_replace_index < 0 ? old_size + 1 : old_size);
+		Entry *entries = _get_entries(bucket);
+		entries[0] = { p_element->hash, p_element };
+		uint32_t dst = 1;
+		for (uint32_t i = 0; i < old_size; i++) {
+			if (int32_t(i) == p_replace_index) {
+				_retire(p_shard, _get_entries(old_bucket)[i].element, &_free_element);
+				continue;
+			}
+			entries[dst++] = _get_entries(old_bucket)[i];
+		}
+		slot.store(bucket, std::memory_order_release);
+
+		if (old_bucket) {
+			_retire(p_shard, old_bucket, &_free_memory);
+		}
+		if (p_replace_index < 0) {
+			p_shard.size++;
+			p_shard.atomic_size.store(p_shard.size, std::memory_order_relaxed);
+		}
+		_reclaim(p_shard);
+	}
+
+	void _grow(Shard &p_shard) {
+		Table *old_table = p_shard.table.load(std::memory_order_relaxed);
+		const uint32_t old_capacity = old_table->mask + 1;
+		std::atomic<Bucket *> *old_buckets = _get_buckets(old_table);
+
+		Table *table = _alloc_table(old_capacity * 2);
+		std::atomic<Bucket *> *buckets = _get_buckets(table);
+
+		// Each old bucket splits into the buckets at the same index and at index + old_capacity.
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			Bucket *old_bucket = old_buckets[i].load(std::memory_order_relaxed);
+			if (!old_bucket) {
+				continue;
+			}
+			const Entry *old_entries = _get_entries(old_bucket);
+			uint32_t high_count = 0;
+			for (uint32_t j = 0; j < old_bucket->size; j++) {
+				high_count += (old_entries[j].hash & old_capacity) ? 1 : 0;
+			}
+			const uint32_t low_count = old_bucket->size - high_count;
+			Bucket *low = low_count ? _alloc_bucket(low_count) : nullptr;
+			Bucket *high = high_count ? _alloc_bucket(high_count) : nullptr;
+			uint32_t low_index = 0;
+			uint32_t high_index = 0;
+			for (uint32_t j = 0; j < old_bucket->size; j++) {
+				if (old_entries[j].hash & old_capacity) {
+					_get_entries(high)[high_index++] = old_entries[j];
+				} else {
+					_get_entries(low)[low_index++] = old_entries[j];
+				}
+			}
+			buckets[i].store(low, std::memory_order_relaxed);
+			buckets[i + old_capacity].store(high, std::memory_order_relaxed);
+			_retire(p_shard, old_bucket, &_free_memory);
+		}
+
+		p_shard.table.store(table, std::memory_order_release);
+		_retire(p_shard, old_table, &_free_memory);
+	}
+
+	template <typename K, typename P>
+	bool _erase(Shard &p_shard, uint32_t p_hash, const K &p_key, P &p_predicate) {
+		MutexLock lock(p_shard.mutex);
+		Table *table = p_shard.table.load(std::memory_order_relaxed);
+		if (!table) {
+			return false;
+		}
+		std::atomic<Bucket *> &slot = _get_bucket_slot(p_shard, p_hash);
+		Bucket *old_bucket = slot.load(std::memory_order_relaxed);
+		if (!old_bucket) {
+			return false;
+		}
+		const Entry *old_entries = _get_entries(old_bucket);
+		for (uint32_t i = 0; i < old_bucket->size; i++) {
+			Element *element = old_entries[i].element;
+			if (old_entries[i].hash != p_hash || !Comparator::compare(element->key, p_key) || !p_predicate(element->value)) {
+				continue;
+			}
+
+			Bucket *bucket = nullptr;
+			if (old_bucket->size > 1) {
+				bucket = _alloc_bucket(old_bucket->size - 1);
+				uint32_t dst = 0;
+				for (uint32_t j = 0; j < old_bucket->size; j++) {
+					if (j != i) {
+						_get_entries(bucket)[dst++] = old_entries[j];
+					}
+				}
+			}
+			slot.store(bucket, std::memory_order_release);
+
+			_retire(p_shard, old_bucket, &_free_memory);
+			_retire(p_shard, element, &_free_element);
+			p_shard.size--;
+			p_shard.atomic_size.store(p_shard.size, std::memory_order_relaxed);
+			_reclaim(p_shard);
+			return true;
+		}
+		return false;
+	}
+
+	void _free_shard(Shard &p_shard) {
+		Table *table = p_shard.table.load(std::memory_order_relaxed);
+		if (table) {
+			std::atomic<Bucket *> *buckets = _get_buckets(table);
+			for (uint32_t i = 0; i <= table->mask; i++) {
+				Bucket *bucket = buckets[i].load(std::memory_order_relaxed);
+				if (!bucket) {
+					continue;
+				}
+				for (uint32_t j = 0; j < bucket->size; j++) {
+					_retire(p_shard, _get_entries(bucket)[j].element, &_free_element);
+				}
+				_retire(p_shard, bucket, &_free_memory);
+			}
+			_retire(p_shard, table, &_free_memory);
+			p_shard.table.store(nullptr, std::memory_order_release);
+		}
+		p_shard.size = 0;
+		p_shard.atomic_size.store(0, std::memory_order_relaxed);
+	}
+
+public:
+	/* Lock-free reads. */
+
+	// Calls `p_visitor(TValue &)` on the elements matching the key, newest
+	// first, until it returns true. Returns whether it did.
+	// The visitor runs while the element is protected from being freed, but
+	// not from concurrent writes, so it must only use thread-safe members of
+	// the value. It must not write to the map.
+	template <typename K, typename V>
+	bool read_hashed(uint32_t p_hash, const K &p_key, V &&p_visitor) const {
+		const uint32_t hash = hash_fmix32(p_hash);
+		const Shard &shard = shards[_get_shard_index(hash)];
+		const uint32_t slot = _read_lock(shard);
+		const bool found = _read(shard, hash, p_key, p_visitor);
+		_read_unlock(shard, slot);
+		return found;
+	}
+
+	template <typename K, typename V>
+	_FORCE_INLINE_ bool read(const K &p_key, V &&p_visitor) const {
+		return read_hashed(Hasher::hash(p_key), p_key, p_visitor);
+	}
+
+	template <typename K>
+	bool lookup(const K &p_key, TValue &r_value) const {
+		return read(p_key, [&r_value](const TValue &p_value) {
+			r_value = p_value;
+			return true;
+		});
+	}
+
+	template <typename K>
+	bool has(const K &p_key) const {
+		return read(p_key, [](const TValue &) { return true; });
+	}
+
+	// May be out of date by the time it returns, if other threads are writing.
+	uint32_t size() const {
+		uint32_t total = 0;
+		for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+			total += shards[i].atomic_size.load(std::memory_order_relaxed);
+		}
+		return total;
+	}
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return size() == 0;
+	}
+
+	/* Writes. */
+
+	// Inserts or replaces the value for `p_key`.
+	// A replaced element is retired like an erased one.
+	void insert(const TKey &p_key, const TValue &p_value) {
+		const uint32_t hash = _hash(p_key);
+		Shard &shard = shards[_get_shard_index(hash)];
+		MutexLock lock(shard.mutex);
+
+		int32_t replace_index = -1;
+		Table *table = shard.table.load(std::memory_order_relaxed);
+		if (table) {
+			Bucket *bucket = _get_bucket_slot(shard, hash).load(std::memory_order_relaxed);
+			for (uint32_t i = 0; bucket && i < bucket->size; i++) {
+				const Entry &entry = _get_entries(bucket)[i];
+				if (entry.hash == hash && Comparator::compare(entry.element->key, p_key)) {
+					replace_index = i;
+					break;
+				}
+			}
+		}
+		_publish(shard, memnew(Element(hash, p_key, p_value)), replace_index);
+	}
+
+	// Atomically looks up and, if needed, inserts. Under the shard lock, calls
+	// `p_visitor(TValue &)` on the elements matching the key, newest first,
+	// until it returns true. If none does, a new element with a
+	// default-constructed value is inserted in front of them, `p_init(TValue &)`
+	// is called on it before it becomes visible to readers, and the elements
+	// that were rejected are left for their owners to erase.
+	// Returns the accepted or created value. `p_init` must not write to the map.
+	template <typename K, typename V, typename I>
+	TValue *find_or_insert_hashed(uint32_t p_hash, const K &p_key, V &&p_visitor, I &&p_init) {
+		const uint32_t hash = hash_fmix32(p_hash);
+		Shard &shard = shards[_get_shard_index(hash)];
+		MutexLock lock(shard.mutex);
+
+		Table *table = shard.table.load(std::memory_order_relaxed);
+		if (table) {
+			Bucket *bucket = _get_bucket_slot(shard, hash).load(std::memory_order_relaxed);
+			for (uint32_t i = 0; bucket && i < bucket->size; i++) {
+				const Entry &entry = _get_entries(bucket)[i];
+				if (entry.hash == hash && Comparator::compare(entry.element->key, p_key) && p_visitor(entry.element->value)) {
+					return &entry.element->value;
+				}
+			}
+		}
+
+		Element *element = memnew(Element(hash, TKey(p_key)));
+		p_init(element->value);
+		_publish(shard, element);
+		return &element->value;
+	}
+
+	template <typename K, typename V, typename I>
+	_FORCE_INLINE_ TValue *find_or_insert(const K &p_key, V &&p_visitor, I &&p_init) {
+		return find_or_insert_hashed(Hasher::hash(p_key), p_key, p_visitor, p_init);
+	}
+
+	// Erases the newest element matching the key for which `p_predicate(const TValue &)` returns true.
+	template <typename K, typename P>
+	bool erase_if_hashed(uint32_t p_hash, const K &p_key, P &&p_predicate) {
+		const uint32_t hash = hash_fmix32(p_hash);
+		return _erase(shards[_get_shard_index(hash)], hash, p_key, p_predicate);
+	}
+
+	template <typename K, typename P>
+	_FORCE_INLINE_ bool erase_if(const K &p_key, P &&p_predicate) {
+		return erase_if_hashed(Hasher::hash(p_key), p_key, p_predicate);
+	}
+
+	template <typename K>
+	bool erase(const K &p_key) {
+		return erase_if(p_key, [](const TValue &) { return true; });
+	}
+
+	// Calls `p_callback(const TKey &, TValue &)` on every element, one shard at a time
+	// with its lock held. The callback must not write to the map.
+	template <typename C>
+	void for_each(C &&p_callback) {
+		for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+			Shard &shard = shards[i];
+			MutexLock lock(shard.mutex);
+			Table *table = shard.table.load(std::memory_order_relaxed);
+			if (!table) {
+				continue;
+			}
+			std::atomic<Bucket *> *buckets = _get_buckets(table);
+			for (uint32_t j = 0; j <= table->mask; j++) {
+				Bucket *bucket = buckets[j].load(std::memory_order_relaxed);
+				for (uint32_t k = 0; bucket && k < bucket->size; k++) {
+					Element *element = _get_entries(bucket)[k].element;
+					p_callback(element->key, element->value);
+				}
+			}
+		}
+	}
+
+	// Waits until no reader can still see an element erased from the shard of `p_key`
+	// before this call, and frees everything retired there.
+	template <typename K>
+	void synchronize(const K &p_key) {
+		Shard &shard = shards[_get_shard_index(_hash(p_key))];
+		MutexLock lock(shard.mutex);
+		_synchronize(shard);
+	}
+
+	void synchronize() {
+		for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+			MutexLock lock(shards[i].mutex);
+			_synchronize(shards[i]);
+		}
+	}
+
+	void clear() {
+		for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+			MutexLock lock(shards[i].mutex);
+			_free_shard(shards[i]);
+			_synchronize(shards[i]);
+		}
+	}
+
+	ConcurrentHashMap() = default;
+	ConcurrentHashMap(const ConcurrentHashMap &) = delete;
+	ConcurrentHashMap &operator=(const ConcurrentHashMap &) = delete;
+
+	~ConcurrentHashMap() {
+		for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+			_free_shard(shards[i]);
+			_free_retired(shards[i].retired[0]);
+			_free_retired(shards[i].retired[1]);
+		}
+	}
+};
@@ -64,17 +64,20 @@ public:
 	static constexpr USize MAX_INT = INT64_MAX;
 
 private:
-	// Alignment:  ↓ max_align_t           ↓ USize          ↓ USize            ↓ MAX_ALIGN
-	//             ┌────────────────────┬──┬───────────────┬──┬─────────────┬──┬───────────...
-	//             │ SafeNumeric<USize> │░░│ USize         │░░│ USize       │░░│ T[]
-	//             │ ref. count         │░░│ data capacity │░░│ data size   │░░│ data
-	//             └────────────────────┴──┴───────────────┴──┴─────────────┴──┴───────────...
-	// Offset:     ↑ REF_COUNT_OFFSET      ↑ CAPACITY_OFFSET  ↑ SIZE_OFFSET    ↑ DATA_OFFSET
+	// Alignment:  ↓ max_align_t           ↓ USize          ↓ USize            ↓ uint32_t            ↓ MAX_ALIGN
+	//             ┌────────────────────┬──┬───────────────┬──┬─────────────┬──┬──────────────────┬──┬───────────...
+	//             │ SafeNumeric<USize> │░░│ USize         │░░│ USize       │░░│ atomic<uint32_t> │░░│ T[]
+	//             │ ref. count         │░░│ data capacity │░░│ data size   │░░│ user data        │░░│ data
+	//             └────────────────────┴──┴───────────────┴──┴─────────────┴──┴──────────────────┴──┴───────────...
+	// Offset:     ↑ REF_COUNT_OFFSET      ↑ CAPACITY_OFFSET  ↑ SIZE_OFFSET    ↑ USER_DATA_OFFSET     ↑ DATA_OFFSET
+	//
+	// The user data only exists if it fits in the padding before the data, so it never makes the header bigger.
 
 	static constexpr size_t REF_COUNT_OFFSET = 0;
 	static constexpr size_t CAPACITY_OFFSET = Memory::get_aligned_address(REF_COUNT_OFFSET + sizeof(SafeNumeric<USize>), alignof(USize));
 	static constexpr size_t SIZE_OFFSET = Memory::get_aligned_address(CAPACITY_OFFSET + sizeof(USize), alignof(USize));
 	static constexpr size_t DATA_OFFSET = Memory::get_aligned_address(SIZE_OFFSET + sizeof(USize), Memory::MAX_ALIGN);
+	static constexpr size_t USER_DATA_OFFSET = Memory::get_aligned_address(SIZE_OFFSET + sizeof(USize), alignof(std::atomic<uint32_t>));
 
 	mutable T *_ptr = nullptr;
 
@@ -120,6 +123,11 @@ private:
 		return (USize *)((uint8_t *)_ptr - DATA_OFFSET + CAPACITY_OFFSET);
 	}
 
+	/// Note: Assumes _ptr != nullptr and HAS_USER_DATA.
+	_FORCE_INLINE_ std::atomic<uint32_t> *_get_user_data() const {
+		return (std::atomic<uint32_t> *)((uint8_t *)_ptr - DATA_OFFSET + USER_DATA_OFFSET);
+	}
+
 	// Decrements the reference count. Deallocates the backing buffer if needed.
 	// After this function, _ptr is guaranteed to be NULL.
 	void _unref();
@@ -151,6 +159,9 @@ private:
 	/// Ensure we are the only owners of the backing buffer.
 	[[nodiscard]] Error _copy_on_write();
 
+public:
+	static constexpr bool HAS_USER_DATA = USER_DATA_OFFSET + sizeof(std::atomic<uint32_t>) <= DATA_OFFSET;
+
 public:
 	void operator=(const CowData<T> &p_from) { _ref(p_from); }
 	void operator=(CowData<T> &&p_from) {
@@ -173,6 +184,26 @@ public:
 		return _ptr;
 	}
 
+	/// Returns the word stored with set_user_data(), or 0 if there is none.
+	/// New buffers start at 0. CowData never changes it otherwise, even when the data is written or resized,
+	/// so an owner that derives it from the data must reset it after writing.
+	_FORCE_INLINE_ uint32_t get_user_data() const {
+		if constexpr (HAS_USER_DATA) {
+			if (_ptr) {
+				return _get_user_data()->load(std::memory_order_relaxed);
+			}
+		}
+		return 0;
+	}
+
+	_FORCE_INLINE_ void set_user_data(uint32_t p_value) const {
+		if constexpr (HAS_USER_DATA) {
+			if (_ptr) {
+				_get_user_data()->store(p_value, std::memory_order_relaxed);
+			}
+		}
+	}
+
 	_FORCE_INLINE_ Size size() const { return !_ptr ? 0 : *_get_size(); }
 	_FORCE_INLINE_ USize capacity() const { return !_ptr ? 0 : *_get_capacity(); }
 	_FORCE_INLINE_ USize refcount() const { return !_ptr ? 0 : *_get_refcount(); }
@@ -475,6 +506,9 @@ Error CowData<T>::_alloc_exact(USize p_capacity) {
 	// If we alloc, we're guaranteed to be the only reference.
 	new (_get_refcount()) SafeNumeric<USize>(1);
 	*_get_size() = 0;
+	if constexpr (HAS_USER_DATA) {
+		new (_get_user_data()) std::atomic<uint32_t>(0);
+	}
 	// The actual capacity is whatever we can stuff into the alloc_size.
 	*_get_capacity() = p_capacity;
 
@@ -46,8 +46,9 @@
  * https://docs.godotengine.org/en/latest/engine_details/architecture/core_types.html#containers
  *
  * @tparam tight Disable exponential growth (reallocate element-by-element instead).
+ * @tparam Allocator Provides static alloc/realloc/free for the element buffer, e.g. FrameArena for per-frame scratch.
  */
-template <typename T, typename U = uint32_t, bool force_trivial = false, bool tight = false>
+template <typename T, typename U = uint32_t, bool force_trivial = false, bool tight = false, typename Allocator = DefaultAllocator>
 class _WARN_UNUSED_ LocalVector {
 	static_assert(!force_trivial, "force_trivial is no longer supported. Use resize_uninitialized instead.");
 
@@ -160,7 +161,7 @@ public:
 	_FORCE_INLINE_ void reset() {
 		clear();
 		if (data) {
-			memfree(data);
+			Allocator::free(data);
 			data = nullptr;
 			capacity = 0;
 		}
@@ -181,7 +182,7 @@ public:
 					capacity = p_size;
 				}
 			}
-			data = (T *)memrealloc(data, capacity * sizeof(T));
+			data = (T *)Allocator::realloc(data, capacity * sizeof(T));
 			CRASH_COND_MSG(!data, "Out of memory");
 		} else if (p_size < count) {
 			WARN_VERBOSE("reserve() called with a capacity smaller than the current size. This is likely a mistake.");
@@ -402,5 +403,5 @@ template <typename T, typename U = uint32_t>
 using TightLocalVector = LocalVector<T, U, false, true>;
 
 // Zero-constructing LocalVector initializes count, capacity and data to 0 and thus empty.
-template <typename T, typename U, bool force_trivial, bool tight>
-struct is_zero_constructible<LocalVector<T, U, force_trivial, tight>> : std::true_type {};
+template <typename T, typename U, bool force_trivial, bool tight, typename Allocator>
+struct is_zero_constructible<LocalVector<T, U, force_trivial, tight, Allocator>> : std::true_type {};
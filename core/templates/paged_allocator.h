@@ -52,12 +52,7 @@ class PagedAllocator {
 	uint32_t page_size = 0;
 	SpinLock spin_lock;
 
-public:
-	template <typename... Args>
-	T *alloc(Args &&...p_args) {
-		if constexpr (thread_safe) {
-			spin_lock.lock();
-		}
+	_FORCE_INLINE_ T *_alloc_unlocked() {
 		if (unlikely(allocs_available == 0)) {
 			uint32_t pages_used = pages_allocated;
 
@@ -75,7 +70,21 @@ public:
 		}
 
 		allocs_available--;
-		T *alloc = available_pool[allocs_available >> page_shift][allocs_available & page_mask];
+		return available_pool[allocs_available >> page_shift][allocs_available & page_mask];
+	}
+
+	_FORCE_INLINE_ void _free_unlocked(T *p_mem) {
+		available_pool[allocs_available >> page_shift][allocs_available & page_mask] = p_mem;
+		allocs_available++;
+	}
+
+public:
+	template <typename... Args>
+	T *alloc(Args &&...p_args) {
+		if constexpr (thread_safe) {
+			spin_lock.lock();
+		}
+		T *alloc = _alloc_unlocked();
 		if constexpr (thread_safe) {
 			spin_lock.unlock();
 		}
@@ -88,8 +97,39 @@ public:
 			spin_lock.lock();
 		}
 		p_mem->~T();
-		available_pool[allocs_available >> page_shift][allocs_available & page_mask] = p_mem;
-		allocs_available++;
+		_free_unlocked(p_mem);
+		if constexpr (thread_safe) {
+			spin_lock.unlock();
+		}
+	}
+
+	// Like alloc() and free() for several default-constructed elements at once,
+	// taking the lock only once. Used to feed per-thread caches.
+	void alloc_batch(T **r_mem, uint32_t p_count) {
+		if constexpr (thread_safe) {
+			spin_lock.lock();
+		}
+		for (uint32_t i = 0; i < p_count; i++) {
+			r_mem[i] = _alloc_unlocked();
+		}
+		if constexpr (thread_safe) {
+			spin_lock.unlock();
+		}
+		for (uint32_t i = 0; i < p_count; i++) {
+			memnew_placement(r_mem[i], T);
+		}
+	}
+
+	void free_batch(T *const *p_mem, uint32_t p_count) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_mem[i]->~T();
+		}
+		if constexpr (thread_safe) {
+			spin_lock.lock();
+		}
+		for (uint32_t i = 0; i < p_count; i++) {
+			_free_unlocked(p_mem[i]);
+		}
 		if constexpr (thread_safe) {
 			spin_lock.unlock();
 		}
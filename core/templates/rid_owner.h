@@ -32,6 +32,7 @@
 
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
@@ -67,6 +68,13 @@
 class RID_AllocBase {
 	static inline SafeNumeric<uint64_t> base_id{ 1 };
 
+	// IDs are handed out to each thread in blocks, so threads creating
+	// RIDs concurrently don't all contend on the same counter.
+	static constexpr uint64_t ID_BLOCK_SIZE = 256;
+
+	static inline thread_local uint64_t id_block_next = 0;
+	static inline thread_local uint64_t id_block_end = 0;
+
 protected:
 	static RID _make_from_id(uint64_t p_id) {
 		RID rid;
@@ -81,7 +89,12 @@ protected:
 	friend struct VariantUtilityFunctions;
 
 	static uint64_t _gen_id() {
-		return base_id.increment();
+		if (unlikely(id_block_next == id_block_end)) {
+			uint64_t last = base_id.add(ID_BLOCK_SIZE);
+			id_block_next = last - ID_BLOCK_SIZE + 1;
+			id_block_end = last + 1;
+		}
+		return id_block_next++;
 	}
 
 public:
@@ -106,69 +119,189 @@ class RID_Alloc : public RID_AllocBase {
 
 	mutable Mutex mutex;
 
-	_FORCE_INLINE_ RID _allocate_rid() {
+	// In thread-safe mode, free indices are handed out from small caches
+	// selected by the calling thread, so allocating and freeing only touches
+	// the shared free list (and its mutex) once every THREAD_CACHE_BATCH calls.
+	// Validation in get_or_null() and owns() doesn't lock at all; it relies on
+	// acquire/release ordering of max_alloc and each chunk's validator.
+	static constexpr uint32_t THREAD_CACHE_COUNT = 16;
+	static constexpr uint32_t THREAD_CACHE_SIZE = 31; // Along with the count, fills two cache lines.
+	static constexpr uint32_t THREAD_CACHE_BATCH = 16;
+
+	struct ThreadCache {
+		SpinLock lock;
+		std::atomic<uint32_t> count{ 0 };
+		uint32_t indices[THREAD_CACHE_SIZE];
+	};
+	ThreadCache *thread_caches = nullptr;
+
+	_FORCE_INLINE_ static std::atomic<uint32_t> &_as_atomic(const uint32_t &p_value) {
+		return *(std::atomic<uint32_t> *)const_cast<uint32_t *>(&p_value);
+	}
+
+	_FORCE_INLINE_ uint32_t _get_max_alloc() const {
+		if constexpr (THREAD_SAFE) { // Pairs with the store in _grow(), so the new chunk pointers are visible.
+			return _as_atomic(max_alloc).load(std::memory_order_acquire);
+		} else {
+			return max_alloc;
+		}
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_validator(const Chunk &p_chunk) {
 		if constexpr (THREAD_SAFE) {
-			mutex.lock();
+			return _as_atomic(p_chunk.validator).load(std::memory_order_acquire);
+		} else {
+			return p_chunk.validator;
 		}
+	}
 
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-			if (THREAD_SAFE && chunk_count == chunk_limit) {
-				mutex.unlock();
-				if (description != nullptr) {
-					ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
-				} else {
-					ERR_FAIL_V_MSG(RID(), "Element limit reached.");
-				}
-			}
+	_FORCE_INLINE_ static void _set_validator(Chunk &p_chunk, uint32_t p_validator) {
+		if constexpr (THREAD_SAFE) {
+			_as_atomic(p_chunk.validator).store(p_validator, std::memory_order_release);
+		} else {
+			p_chunk.validator = p_validator;
+		}
+	}
 
-			//grow chunks
-			if constexpr (!THREAD_SAFE) {
-				chunks = (Chunk **)memrealloc(chunks, sizeof(Chunk *) * (chunk_count + 1));
-			}
-			chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
-			//grow free lists
-			if constexpr (!THREAD_SAFE) {
-				free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			}
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+	_FORCE_INLINE_ ThreadCache &_get_thread_cache() const {
+		return thread_caches[Thread::get_caller_id() % THREAD_CACHE_COUNT];
+	}
 
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				// Don't initialize chunk.
-				chunks[chunk_count][i].validator = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
-			}
+	void _grow() {
+		uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
 
-			if constexpr (THREAD_SAFE) {
-				// Store atomically to avoid data race with the load in get_or_null().
-				((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_relaxed);
-			} else {
-				max_alloc += elements_in_chunk;
-			}
+		//grow chunks
+		if constexpr (!THREAD_SAFE) {
+			chunks = (Chunk **)memrealloc(chunks, sizeof(Chunk *) * (chunk_count + 1));
+		}
+		chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
+		//grow free lists
+		if constexpr (!THREAD_SAFE) {
+			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
 		}
+		free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		//initialize
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			// Don't initialize chunk.
+			chunks[chunk_count][i].validator = 0xFFFFFFFF;
+			free_list_chunks[chunk_count][i] = alloc_count + i;
+		}
 
-		uint32_t free_chunk = free_index / elements_in_chunk;
-		uint32_t free_element = free_index % elements_in_chunk;
+		if constexpr (THREAD_SAFE) {
+			_as_atomic(max_alloc).store(max_alloc + elements_in_chunk, std::memory_order_release);
+		} else {
+			max_alloc += elements_in_chunk;
+		}
+	}
 
+	_FORCE_INLINE_ RID _make_rid_at(uint32_t p_index) {
 		uint32_t validator = 1 + (uint32_t)(_gen_id() % 0x7FFFFFFF);
 		uint64_t id = validator;
 		id <<= 32;
-		id |= free_index;
+		id |= p_index;
 
-		chunks[free_chunk][free_element].validator = validator;
-		chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
+		_set_validator(chunks[p_index / elements_in_chunk][p_index % elements_in_chunk], validator | 0x80000000); //mark uninitialized bit
+
+		return _make_from_id(id);
+	}
 
-		alloc_count++;
+	// Moves up to THREAD_CACHE_BATCH indices from the shared free list into an empty cache.
+	uint32_t _refill_thread_cache(ThreadCache &p_cache) {
+		MutexLock lock(mutex);
 
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+		if (alloc_count == max_alloc) {
+			if (max_alloc / elements_in_chunk == chunk_limit) {
+				return 0;
+			}
+			_grow();
 		}
 
-		return _make_from_id(id);
+		uint32_t count = MIN(THREAD_CACHE_BATCH, max_alloc - alloc_count);
+		for (uint32_t i = 0; i < count; i++) {
+			p_cache.indices[i] = free_list_chunks[(alloc_count + i) / elements_in_chunk][(alloc_count + i) % elements_in_chunk];
+		}
+		// Stored atomically to avoid a data race with the load in get_rid_count().
+		_as_atomic(alloc_count).store(alloc_count + count, std::memory_order_relaxed);
+		return count;
+	}
+
+	// Moves the last `p_flush_count` indices of a cache back to the shared free list.
+	uint32_t _flush_thread_cache(ThreadCache &p_cache, uint32_t p_count, uint32_t p_flush_count = THREAD_CACHE_BATCH) {
+		MutexLock lock(mutex);
+
+		uint32_t new_alloc_count = alloc_count;
+		for (uint32_t i = p_count - p_flush_count; i < p_count; i++) {
+			new_alloc_count--;
+			free_list_chunks[new_alloc_count / elements_in_chunk][new_alloc_count % elements_in_chunk] = p_cache.indices[i];
+		}
+		_as_atomic(alloc_count).store(new_alloc_count, std::memory_order_relaxed);
+		return p_count - p_flush_count;
+	}
+
+	// Cached indices still count as allocated, so when the limit is reached,
+	// free slots may be parked in the caches of other threads. This gives
+	// them back to the shared free list before reporting failure.
+	// Only one cache is locked at a time, and always before the mutex, like everywhere else.
+	void _drain_thread_caches() {
+		for (uint32_t i = 0; i < THREAD_CACHE_COUNT; i++) {
+			ThreadCache &cache = thread_caches[i];
+			cache.lock.lock();
+			const uint32_t count = cache.count.load(std::memory_order_relaxed);
+			if (count > 0) {
+				cache.count.store(_flush_thread_cache(cache, count, count), std::memory_order_relaxed);
+			}
+			cache.lock.unlock();
+		}
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
+		if constexpr (THREAD_SAFE) {
+			ThreadCache &cache = _get_thread_cache();
+			cache.lock.lock();
+
+			uint32_t count = cache.count.load(std::memory_order_relaxed);
+			if (unlikely(count == 0)) {
+				count = _refill_thread_cache(cache);
+				if (unlikely(count == 0)) {
+					cache.lock.unlock();
+					_drain_thread_caches();
+					cache.lock.lock();
+					// Another thread using the same cache may have refilled it in the meantime.
+					count = cache.count.load(std::memory_order_relaxed);
+					if (count == 0) {
+						count = _refill_thread_cache(cache);
+					}
+				}
+				if (unlikely(count == 0)) {
+					cache.lock.unlock();
+					if (description != nullptr) {
+						ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
+					} else {
+						ERR_FAIL_V_MSG(RID(), "Element limit reached.");
+					}
+				}
+			}
+
+			count--;
+			uint32_t free_index = cache.indices[count];
+			cache.count.store(count, std::memory_order_relaxed);
+
+			cache.lock.unlock();
+
+			// The index now belongs to this thread alone, so no lock is needed to claim it.
+			return _make_rid_at(free_index);
+		} else {
+			if (alloc_count == max_alloc) {
+				//allocate a new chunk
+				_grow();
+			}
+
+			uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+			alloc_count++;
+
+			return _make_rid_at(free_index);
+		}
 	}
 
 public:
@@ -193,19 +326,9 @@ public:
 			return nullptr;
 		}
 
-		if constexpr (THREAD_SAFE) {
-			SYNC_ACQUIRE;
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		uint32_t ma;
-		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _allocate_rid().
-			ma = ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_relaxed);
-		} else {
-			ma = max_alloc;
-		}
-		if (unlikely(idx >= ma)) {
+		if (unlikely(idx >= _get_max_alloc())) {
 			return nullptr;
 		}
 
@@ -214,47 +337,27 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_acquire(&chunks[idx_chunk]); // We know not a race in practice.
-			__tsan_acquire(&chunks[idx_chunk][idx_element]); // We know not a race in practice.
-#endif
-		}
-
 		Chunk &c = chunks[idx_chunk][idx_element];
-
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(&chunks[idx_chunk]);
-			__tsan_release(&chunks[idx_chunk][idx_element]);
-			__tsan_acquire(&c.validator); // We know not a race in practice.
-#endif
-		}
+		uint32_t current_validator = _get_validator(c);
 
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(c.validator & 0x80000000))) {
+			if (unlikely(!(current_validator & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((c.validator & 0x7FFFFFFF) != validator)) {
+			if (unlikely((current_validator & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 			}
 
-			c.validator &= 0x7FFFFFFF; //initialized
+			_set_validator(c, validator); //initialized
 
-		} else if (unlikely(c.validator != validator)) {
-			if ((c.validator & 0x80000000) && c.validator != 0xFFFFFFFF) {
+		} else if (unlikely(current_validator != validator)) {
+			if ((current_validator & 0x80000000) && current_validator != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(&c.validator);
-#endif
-		}
-
 		T *ptr = &c.data;
 
 		return ptr;
@@ -300,16 +403,9 @@ public:
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _get_max_alloc())) {
 			return false;
 		}
 
@@ -318,26 +414,13 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
-
-		return owned;
+		return (_get_validator(chunks[idx_chunk][idx_element]) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _get_max_alloc())) {
 			ERR_FAIL();
 		}
 
@@ -345,31 +428,55 @@ public:
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		Chunk &c = chunks[idx_chunk][idx_element];
+		uint32_t current_validator = _get_validator(c);
+		if (unlikely(current_validator & 0x80000000)) {
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		} else if (unlikely(current_validator != validator)) {
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].data.~T();
-		chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
+		if constexpr (THREAD_SAFE) {
+			// Go invalid first, so that only one of several threads freeing the same RID
+			// gets to destroy it, and lookups fail while the destructor runs.
+			if (unlikely(!_as_atomic(c.validator).compare_exchange_strong(current_validator, 0xFFFFFFFF, std::memory_order_acq_rel))) {
+				ERR_FAIL();
+			}
+
+			c.data.~T();
 
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+			ThreadCache &cache = _get_thread_cache();
+			cache.lock.lock();
 
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			uint32_t count = cache.count.load(std::memory_order_relaxed);
+			if (unlikely(count == THREAD_CACHE_SIZE)) {
+				count = _flush_thread_cache(cache, count);
+			}
+			cache.indices[count] = idx;
+			cache.count.store(count + 1, std::memory_order_relaxed);
+
+			cache.lock.unlock();
+		} else {
+			c.data.~T();
+			c.validator = 0xFFFFFFFF; // go invalid
+
+			alloc_count--;
+			free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
 		}
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		if constexpr (THREAD_SAFE) {
+			// Indices sitting in the thread caches are taken from the free list but not in use.
+			// The result is only exact while no other thread is allocating or freeing.
+			int64_t count = _as_atomic(alloc_count).load(std::memory_order_relaxed);
+			for (uint32_t i = 0; i < THREAD_CACHE_COUNT; i++) {
+				count -= thread_caches[i].count.load(std::memory_order_relaxed);
+			}
+			return count > 0 ? uint32_t(count) : 0;
+		} else {
+			return alloc_count;
+		}
 	}
 	LocalVector<RID> get_owned_list() const {
 		LocalVector<RID> owned;
@@ -377,7 +484,7 @@ public:
 			mutex.lock();
 		}
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _get_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				owned.push_back(_make_from_id((validator << 32) | i));
 			}
@@ -395,7 +502,7 @@ public:
 		}
 		uint32_t idx = 0;
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _get_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
@@ -417,6 +524,10 @@ public:
 			chunk_limit = (p_maximum_number_of_elements / elements_in_chunk) + 1;
 			chunks = (Chunk **)memalloc(sizeof(Chunk *) * chunk_limit);
 			free_list_chunks = (uint32_t **)memalloc(sizeof(uint32_t *) * chunk_limit);
+			thread_caches = (ThreadCache *)memalloc(sizeof(ThreadCache) * THREAD_CACHE_COUNT);
+			for (uint32_t i = 0; i < THREAD_CACHE_COUNT; i++) {
+				memnew_placement(&thread_caches[i], ThreadCache);
+			}
 			SYNC_RELEASE;
 		}
 	}
@@ -426,9 +537,10 @@ public:
 			SYNC_ACQUIRE;
 		}
 
-		if (alloc_count) {
+		uint32_t leaked = get_rid_count();
+		if (leaked) {
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
-					alloc_count, description ? description : typeid(T).name()));
+					leaked, description ? description : typeid(T).name()));
 
 			for (size_t i = 0; i < max_alloc; i++) {
 				uint32_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
@@ -451,6 +563,10 @@ public:
 			memfree(chunks);
 			memfree(free_list_chunks);
 		}
+
+		if (thread_caches) {
+			memfree(thread_caches);
+		}
 	}
 };
 
@@ -0,0 +1,678 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/math_funcs_binary.h"
+#include "core/os/memory.h"
+#include "core/string/print_string.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#define SWISS_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Matches the control bytes of a 16-slot group of SwissHashMap in one go.
+// Each function returns a bitmask with bit `i` set if slot `i` of the group matches.
+struct SwissHashMapGroup {
+	static constexpr uint32_t SIZE = 16;
+	static constexpr uint8_t EMPTY = 0x80;
+	static constexpr uint8_t DELETED = 0xFE;
+
+#if defined(SWISS_HASH_MAP_SSE2)
+	static _FORCE_INLINE_ uint32_t match(const uint8_t *p_ctrl, uint8_t p_h2) {
+		const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)p_h2)));
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty_or_deleted(const uint8_t *p_ctrl) {
+		// Both have the high bit set, full slots don't.
+		return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl)));
+	}
+#elif defined(SWISS_HASH_MAP_NEON)
+	static _FORCE_INLINE_ uint32_t _to_bitmask(uint8x16_t p_matches) {
+		static const uint8_t bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t masked = vandq_u8(p_matches, vld1q_u8(bits));
+		return (uint32_t)vaddv_u8(vget_low_u8(masked)) | ((uint32_t)vaddv_u8(vget_high_u8(masked)) << 8);
+	}
+
+	static _FORCE_INLINE_ uint32_t match(const uint8_t *p_ctrl, uint8_t p_h2) {
+		return _to_bitmask(vceqq_u8(vld1q_u8(p_ctrl), vdupq_n_u8(p_h2)));
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty_or_deleted(const uint8_t *p_ctrl) {
+		return _to_bitmask(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(p_ctrl))));
+	}
+#else
+	// Portable version working on eight control bytes at a time.
+	static constexpr uint64_t LSBS = 0x0101010101010101;
+	static constexpr uint64_t MSBS = 0x8080808080808080;
+
+	static _FORCE_INLINE_ uint64_t _load(const uint8_t *p_ctrl) {
+		uint64_t word;
+		memcpy(&word, p_ctrl, sizeof(word));
+#ifdef BIG_ENDIAN_ENABLED
+		word = BSWAP64(word);
+#endif
+		return word;
+	}
+
+	// Gathers the high bit of each byte into the low eight bits.
+	static _FORCE_INLINE_ uint32_t _to_bitmask(uint64_t p_msbs) {
+		return (uint32_t)(((p_msbs >> 7) * 0x0102040810204080) >> 56);
+	}
+
+	static _FORCE_INLINE_ uint64_t _match_word(uint64_t p_word, uint8_t p_h2) {
+		const uint64_t x = p_word ^ (LSBS * p_h2);
+		// Exact zero byte test, carries can't cross bytes.
+		return ~(((x & ~MSBS) + ~MSBS) | x) & MSBS;
+	}
+
+	static _FORCE_INLINE_ uint32_t match(const uint8_t *p_ctrl, uint8_t p_h2) {
+		return _to_bitmask(_match_word(_load(p_ctrl), p_h2)) | (_to_bitmask(_match_word(_load(p_ctrl + 8), p_h2)) << 8);
+	}
+
+	static _FORCE_INLINE_ uint32_t match_empty_or_deleted(const uint8_t *p_ctrl) {
+		return _to_bitmask(_load(p_ctrl) & MSBS) | (_to_bitmask(_load(p_ctrl + 8) & MSBS) << 8);
+	}
+#endif
+
+	static _FORCE_INLINE_ uint32_t match_empty(const uint8_t *p_ctrl) {
+		return match(p_ctrl, EMPTY);
+	}
+
+	static _FORCE_INLINE_ uint32_t lowest_bit_index(uint32_t p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return (uint32_t)__builtin_ctz(p_mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, p_mask);
+		return (uint32_t)index;
+#else
+		uint32_t index = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+};
+
+/**
+ * Key-value container using Swiss table style group probing.
+ *
+ * Like AHashMap, elements are stored in a dense array in insertion order (until elements are erased),
+ * and key-values are not pointer-stable. Lookups, however, scan 16 one-byte control entries (7 bits of
+ * the hash each) at once using SSE2 or NEON, with a scalar fallback, and only compare keys on a match.
+ * This is faster than AHashMap for lookup-heavy maps whose keys are expensive to compare.
+ *
+ * Core container guidance:
+ * https://docs.godotengine.org/en/latest/engine_details/architecture/core_types.html#containers
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class _WARN_UNUSED_ SwissHashMap {
+public:
+	// Must be a power of two, and a multiple of the group size.
+	static constexpr uint32_t INITIAL_CAPACITY = 16;
+
+private:
+	typedef SwissHashMapGroup Group;
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+
+	static_assert(INITIAL_CAPACITY % Group::SIZE == 0);
+
+	// `_capacity` control bytes followed by `_capacity` element indices, in a single allocation.
+	uint8_t *_ctrl = nullptr;
+	uint32_t *_slots = nullptr;
+	// Dense arrays of `_get_max_load(_capacity)` entries.
+	MapKeyValue *_elements = nullptr;
+	uint32_t *_hashes = nullptr;
+
+	uint32_t _capacity = INITIAL_CAPACITY;
+	uint32_t _size = 0;
+	// Inserts left before rehashing. Erasing can leave DELETED markers, which also use it up.
+	uint32_t _growth_left = 0;
+
+	static _FORCE_INLINE_ uint32_t _get_max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_capacity_for(uint32_t p_elements) {
+		const uint32_t needed = p_elements + p_elements / 7 + 1;
+		return MAX(INITIAL_CAPACITY, Math::next_power_of_2(needed));
+	}
+
+	static _FORCE_INLINE_ uint8_t _h2(uint32_t p_hash) {
+		return p_hash & 0x7F;
+	}
+
+	_FORCE_INLINE_ uint32_t _first_group(uint32_t p_hash) const {
+		return (p_hash >> 7) & (_capacity / Group::SIZE - 1);
+	}
+
+	// Triangular probing visits every group once when the group count is a power of two.
+	_FORCE_INLINE_ uint32_t _next_group(uint32_t p_group, uint32_t p_step) const {
+		return (p_group + p_step) & (_capacity / Group::SIZE - 1);
+	}
+
+	bool _lookup_slot(const TKey &p_key, uint32_t p_hash, uint32_t &r_slot) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+
+		const uint8_t h2 = _h2(p_hash);
+		uint32_t group = _first_group(p_hash);
+		for (uint32_t step = 1;; step++) {
+			const uint8_t *ctrl = _ctrl + group * Group::SIZE;
+			uint32_t mask = Group::match(ctrl, h2);
+			while (mask) {
+				const uint32_t slot = group * Group::SIZE + Group::lowest_bit_index(mask);
+				const uint32_t element_idx = _slots[slot];
+				if (_hashes[element_idx] == p_hash && Comparator::compare(_elements[element_idx].key, p_key)) {
+					r_slot = slot;
+					return true;
+				}
+				mask &= mask - 1;
+			}
+			if (Group::match_empty(ctrl)) {
+				return false;
+			}
+			group = _next_group(group, step);
+		}
+	}
+
+	_FORCE_INLINE_ bool _lookup_idx(const TKey &p_key, uint32_t &r_element_idx) const {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return false;
+		}
+		r_element_idx = _slots[slot];
+		return true;
+	}
+
+	uint32_t _find_free_slot(uint32_t p_hash) const {
+		uint32_t group = _first_group(p_hash);
+		for (uint32_t step = 1;; step++) {
+			const uint32_t mask = Group::match_empty_or_deleted(_ctrl + group * Group::SIZE);
+			if (mask) {
+				return group * Group::SIZE + Group::lowest_bit_index(mask);
+			}
+			group = _next_group(group, step);
+		}
+	}
+
+	// Finds the slot referring to an element without comparing keys.
+	uint32_t _find_element_slot(uint32_t p_hash, uint32_t p_element_idx) const {
+		const uint8_t h2 = _h2(p_hash);
+		uint32_t group = _first_group(p_hash);
+		for (uint32_t step = 1;; step++) {
+			uint32_t mask = Group::match(_ctrl + group * Group::SIZE, h2);
+			while (mask) {
+				const uint32_t slot = group * Group::SIZE + Group::lowest_bit_index(mask);
+				if (_slots[slot] == p_element_idx) {
+					return slot;
+				}
+				mask &= mask - 1;
+			}
+			group = _next_group(group, step);
+		}
+	}
+
+	void _allocate_table(uint32_t p_capacity) {
+		_capacity = p_capacity;
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(p_capacity * (sizeof(uint8_t) + sizeof(uint32_t))));
+		_slots = reinterpret_cast<uint32_t *>(_ctrl + p_capacity);
+		memset(_ctrl, Group::EMPTY, p_capacity);
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		Memory::free_static(_ctrl);
+		_allocate_table(p_new_capacity);
+
+		const uint32_t max_load = _get_max_load(p_new_capacity);
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(_elements, sizeof(MapKeyValue) * max_load));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(_hashes, sizeof(uint32_t) * max_load));
+
+		for (uint32_t i = 0; i < _size; i++) {
+			const uint32_t slot = _find_free_slot(_hashes[i]);
+			_ctrl[slot] = _h2(_hashes[i]);
+			_slots[slot] = i;
+		}
+		_growth_left = max_load - _size;
+	}
+
+	uint32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(_elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate_table(_capacity);
+			const uint32_t max_load = _get_max_load(_capacity);
+			_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_load));
+			_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_load));
+			_growth_left = max_load;
+		}
+
+		if (unlikely(_growth_left == 0)) {
+			// Mostly DELETED markers: clean them up in place. Otherwise grow.
+			_resize_and_rehash(_size < _get_max_load(_capacity) / 2 ? _capacity : _capacity * 2);
+		}
+
+		const uint32_t slot = _find_free_slot(p_hash);
+		if (_ctrl[slot] == Group::EMPTY) {
+			_growth_left--;
+		}
+		_ctrl[slot] = _h2(p_hash);
+		_slots[slot] = _size;
+
+		memnew_placement(&_elements[_size], MapKeyValue(p_key, p_value));
+		_hashes[_size] = p_hash;
+		_size++;
+		return _size - 1;
+	}
+
+	void _erase_slot(uint32_t p_slot) {
+		const uint32_t element_idx = _slots[p_slot];
+
+		// A group that already has an EMPTY slot ends every probe sequence reaching it,
+		// so no other key depends on this slot being occupied.
+		if (Group::match_empty(_ctrl + (p_slot & ~(Group::SIZE - 1)))) {
+			_ctrl[p_slot] = Group::EMPTY;
+			_growth_left++;
+		} else {
+			_ctrl[p_slot] = Group::DELETED;
+		}
+
+		_elements[element_idx].key.~TKey();
+		_elements[element_idx].value.~TValue();
+		_size--;
+
+		if (element_idx < _size) {
+			memcpy((void *)&_elements[element_idx], (const void *)&_elements[_size], sizeof(MapKeyValue));
+			_hashes[element_idx] = _hashes[_size];
+			_slots[_find_element_slot(_hashes[element_idx], _size)] = element_idx;
+		}
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		_capacity = p_other._capacity;
+		_size = p_other._size;
+		_growth_left = p_other._growth_left;
+
+		if (p_other._elements == nullptr) {
+			return;
+		}
+
+		const uint32_t max_load = _get_max_load(_capacity);
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(_capacity * (sizeof(uint8_t) + sizeof(uint32_t))));
+		_slots = reinterpret_cast<uint32_t *>(_ctrl + _capacity);
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_load));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_load));
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			memcpy((void *)_elements, (const void *)p_other._elements, sizeof(MapKeyValue) * _size);
+		} else {
+			for (uint32_t i = 0; i < _size; i++) {
+				memnew_placement(&_elements[i], MapKeyValue(p_other._elements[i]));
+			}
+		}
+
+		memcpy(_hashes, p_other._hashes, sizeof(uint32_t) * _size);
+		memcpy(_ctrl, p_other._ctrl, _capacity * (sizeof(uint8_t) + sizeof(uint32_t)));
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		if (_elements == nullptr || _size == 0) {
+			return;
+		}
+
+		memset(_ctrl, Group::EMPTY, _capacity);
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < _size; i++) {
+				_elements[i].key.~TKey();
+				_elements[i].value.~TValue();
+			}
+		}
+
+		_size = 0;
+		_growth_left = _get_max_load(_capacity);
+	}
+
+	TValue &get(const TKey &p_key) _LIFETIME_BOUND_ {
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue &get(const TKey &p_key) const _LIFETIME_BOUND_ {
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const _LIFETIME_BOUND_ {
+		uint32_t element_idx = 0;
+		if (_lookup_idx(p_key, element_idx)) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) _LIFETIME_BOUND_ {
+		uint32_t element_idx = 0;
+		if (_lookup_idx(p_key, element_idx)) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		return _lookup_idx(p_key, element_idx);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return false;
+		}
+		_erase_slot(slot);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_size) {
+		const uint32_t capacity = _get_capacity_for(p_new_size);
+		if (_elements == nullptr) {
+			_capacity = capacity;
+			return; // Unallocated yet.
+		}
+		if (capacity <= _capacity) {
+			if (p_new_size < size()) {
+				WARN_VERBOSE("reserve() called with a size smaller than the current size. This is likely a mistake.");
+			}
+			return;
+		}
+		_resize_and_rehash(capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return pair == p_other.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return pair != p_other.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(MapKeyValue *p_key, MapKeyValue *p_end) {
+			pair = p_key;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &p_other) const { return pair == p_other.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &p_other) const { return pair != p_other.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_key, MapKeyValue *p_end) {
+			pair = p_key;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(pair, end);
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() _LIFETIME_BOUND_ {
+		return Iterator(_elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator end() _LIFETIME_BOUND_ {
+		return Iterator(_elements + _size, _elements + _size);
+	}
+
+	Iterator find(const TKey &p_key) _LIFETIME_BOUND_ {
+		uint32_t element_idx = 0;
+		if (!_lookup_idx(p_key, element_idx)) {
+			return end();
+		}
+		return Iterator(_elements + element_idx, _elements + _size);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const _LIFETIME_BOUND_ {
+		return ConstIterator(_elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator end() const _LIFETIME_BOUND_ {
+		return ConstIterator(_elements + _size, _elements + _size);
+	}
+
+	ConstIterator find(const TKey &p_key) const _LIFETIME_BOUND_ {
+		uint32_t element_idx = 0;
+		if (!_lookup_idx(p_key, element_idx)) {
+			return end();
+		}
+		return ConstIterator(_elements + element_idx, _elements + _size);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const _LIFETIME_BOUND_ {
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx);
+		CRASH_COND(!exists);
+		return _elements[element_idx].value;
+	}
+
+	TValue &operator[](const TKey &p_key) _LIFETIME_BOUND_ {
+		const uint32_t hash = Hasher::hash(p_key);
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, hash, slot)) {
+			return _elements[_slots[slot]].value;
+		}
+		return _elements[_insert_element(p_key, TValue(), hash)].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) _LIFETIME_BOUND_ {
+		const uint32_t hash = Hasher::hash(p_key);
+		uint32_t slot = 0;
+		uint32_t element_idx = 0;
+		if (_lookup_slot(p_key, hash, slot)) {
+			element_idx = _slots[slot];
+			_elements[element_idx].value = p_value;
+		} else {
+			element_idx = _insert_element(p_key, p_value, hash);
+		}
+		return Iterator(_elements + element_idx, _elements + _size);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) _LIFETIME_BOUND_ {
+		DEV_ASSERT(!has(p_key));
+		const uint32_t element_idx = _insert_element(p_key, p_value, Hasher::hash(p_key));
+		return Iterator(_elements + element_idx, _elements + _size);
+	}
+
+	/* Array methods. */
+
+	// Returns the element index. If not found, returns -1.
+	int get_index(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		if (!_lookup_idx(p_key, element_idx)) {
+			return -1;
+		}
+		return element_idx;
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) _LIFETIME_BOUND_ {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, _size);
+		return _elements[p_index];
+	}
+
+	/* Constructors */
+
+	SwissHashMap(SwissHashMap &&p_other) {
+		_ctrl = p_other._ctrl;
+		_slots = p_other._slots;
+		_elements = p_other._elements;
+		_hashes = p_other._hashes;
+		_capacity = p_other._capacity;
+		_size = p_other._size;
+		_growth_left = p_other._growth_left;
+
+		p_other._ctrl = nullptr;
+		p_other._slots = nullptr;
+		p_other._elements = nullptr;
+		p_other._hashes = nullptr;
+		p_other._capacity = INITIAL_CAPACITY;
+		p_other._size = 0;
+		p_other._growth_left = 0;
+	}
+
+	explicit SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		_capacity = _get_capacity_for(p_initial_capacity);
+	}
+	SwissHashMap() {}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (_elements != nullptr) {
+			if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+				for (uint32_t i = 0; i < _size; i++) {
+					_elements[i].key.~TKey();
+					_elements[i].value.~TValue();
+				}
+			}
+			Memory::free_static(_elements);
+			Memory::free_static(_hashes);
+			Memory::free_static(_ctrl);
+			_elements = nullptr;
+			_hashes = nullptr;
+			_ctrl = nullptr;
+			_slots = nullptr;
+		}
+		_capacity = INITIAL_CAPACITY;
+		_size = 0;
+		_growth_left = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
@@ -69,6 +69,33 @@ void Callable::callp(const Variant **p_arguments, int p_argcount, Variant &r_ret
 	}
 }
 
+bool Callable::try_ptrcallp(const Variant **p_arguments, int p_argcount) const {
+	if (!is_custom()) {
+		return false;
+	}
+	const void **argptrs = nullptr;
+	if (p_argcount) {
+		argptrs = (const void **)alloca(sizeof(void *) * p_argcount);
+	}
+	if (!custom->get_ptrcall_arguments(p_arguments, p_argcount, argptrs) || !custom->is_valid()) {
+		return false;
+	}
+	custom->ptrcall(argptrs, nullptr);
+	return true;
+}
+
+const void *Callable::get_ptrcall_signature() const {
+	if (!is_custom()) {
+		return nullptr;
+	}
+	return custom->get_ptrcall_signature();
+}
+
+void Callable::ptrcallp(const void **p_arguments, void *r_return_value) const {
+	ERR_FAIL_COND_MSG(!is_custom(), vformat("Callable '%s' doesn't support ptrcall.", String(*this)));
+	custom->ptrcall(p_arguments, r_return_value);
+}
+
 Variant Callable::callv(const Array &p_arguments) const {
 	int argcount = p_arguments.size();
 	const Variant **argptrs = nullptr;
@@ -481,6 +508,18 @@ int CallableCustom::get_unbound_arguments_count() const {
 	return 0;
 }
 
+bool CallableCustom::get_ptrcall_arguments(const Variant **p_arguments, int p_argcount, const void **r_pointers) const {
+	return false;
+}
+
+const void *CallableCustom::get_ptrcall_signature() const {
+	return nullptr;
+}
+
+void CallableCustom::ptrcall(const void **p_arguments, void *r_return_value) const {
+	ERR_FAIL_MSG(vformat("Callable '%s' doesn't support ptrcall.", get_as_text()));
+}
+
 CallableCustom::CallableCustom() {
 	ref_count.init();
 }
@@ -38,6 +38,16 @@ class Object;
 class Variant;
 class CallableCustom;
 
+// Identifies a list of ptrcall parameter types. Typed callers and callees build it from
+// the same (decayed) C++ types at compile time, so comparing signatures is enough to know
+// the arguments can be passed through CallableCustom::ptrcall() as they are.
+template <typename... P>
+struct CallablePtrcallSignature {
+	static inline const char id = 0;
+
+	static const void *get() { return &id; }
+};
+
 // This is an abstraction of things that can be called.
 // It is used for signals and other cases where efficient calling of functions
 // is required. It is designed for the standard case (object and method)
@@ -71,6 +81,16 @@ public:
 	template <typename... VarArgs>
 	Variant call(VarArgs... p_args) const;
 	void callp(const Variant **p_arguments, int p_argcount, Variant &r_return_value, CallError &r_call_error) const;
+	// Calls the target through CallableCustom::ptrcall(), skipping argument conversion and
+	// discarding the return value. Returns false, without calling, if callp() is needed.
+	bool try_ptrcallp(const Variant **p_arguments, int p_argcount) const;
+	// Native arguments matching get_ptrcall_signature() can be passed through ptrcallp().
+	const void *get_ptrcall_signature() const;
+	void ptrcallp(const void **p_arguments, void *r_return_value) const;
+	// Calls with native arguments, through ptrcallp() when the target takes exactly these
+	// types and through callp() otherwise. Defined in callable_mp.h.
+	template <typename... Args>
+	void call_typed(const Args &...p_args) const;
 	void call_deferredp(const Variant **p_arguments, int p_argcount) const;
 	Variant callv(const Array &p_arguments) const;
 
@@ -165,6 +185,15 @@ public:
 	virtual void get_bound_arguments(Vector<Variant> &r_arguments) const;
 	virtual int get_unbound_arguments_count() const;
 
+	// Optional typed calling convention, with arguments passed as in MethodBind::ptrcall().
+	// get_ptrcall_arguments() fills `r_pointers` when the Variant arguments already have
+	// the exact types the target takes, and returns false when call() must be used instead.
+	// `r_return_value` may be null if the caller doesn't need the result.
+	virtual bool get_ptrcall_arguments(const Variant **p_arguments, int p_argcount, const void **r_pointers) const;
+	// Signature of the arguments ptrcall() takes (see CallablePtrcallSignature), or null.
+	virtual const void *get_ptrcall_signature() const;
+	virtual void ptrcall(const void **p_arguments, void *r_return_value) const;
+
 	CallableCustom();
 	virtual ~CallableCustom() {}
 };
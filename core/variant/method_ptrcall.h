@@ -419,3 +419,81 @@ struct PtrToArg<TypedDictionary<K, V>> {
 		*(Dictionary *)p_ptr = p_val;
 	}
 };
+
+// Variant type whose internal storage can be passed unchanged as a ptrcall argument of type T,
+// so callers already holding Variants of that exact type can skip the conversion.
+// NIL means T is Variant itself (the argument is then a pointer to the Variant), and
+// VARIANT_MAX means T always needs a Variant conversion.
+
+template <typename T, typename = void>
+struct PtrToArgVariantType {
+	static constexpr Variant::Type VARIANT_TYPE = Variant::VARIANT_MAX;
+};
+
+template <typename T>
+struct PtrToArgVariantType<const T &> : PtrToArgVariantType<T> {};
+
+template <typename T>
+struct PtrToArgVariantType<T, std::enable_if_t<std::is_enum_v<T>>> {
+	static constexpr Variant::Type VARIANT_TYPE = Variant::INT;
+};
+
+template <typename T>
+struct PtrToArgVariantType<BitField<T>, std::enable_if_t<std::is_enum_v<T>>> {
+	static constexpr Variant::Type VARIANT_TYPE = Variant::INT;
+};
+
+#define MAKE_PTRARG_VARIANT_TYPE(m_type, m_var_type) \
+	template <> \
+	struct PtrToArgVariantType<m_type> { \
+		static constexpr Variant::Type VARIANT_TYPE = m_var_type; \
+	};
+
+MAKE_PTRARG_VARIANT_TYPE(Variant, Variant::NIL)
+MAKE_PTRARG_VARIANT_TYPE(bool, Variant::BOOL)
+MAKE_PTRARG_VARIANT_TYPE(uint8_t, Variant::INT)
+MAKE_PTRARG_VARIANT_TYPE(int8_t, Variant::INT)
+MAKE_PTRARG_VARIANT_TYPE(uint16_t, Variant::INT)
+MAKE_PTRARG_VARIANT_TYPE(int16_t, Variant::INT)
+MAKE_PTRARG_VARIANT_TYPE(uint32_t, Variant::INT)
+MAKE_PTRARG_VARIANT_TYPE(int32_t, Variant::INT)
+MAKE_PTRARG_VARIANT_TYPE(int64_t, Variant::INT)
+MAKE_PTRARG_VARIANT_TYPE(uint64_t, Variant::INT)
+MAKE_PTRARG_VARIANT_TYPE(float, Variant::FLOAT)
+MAKE_PTRARG_VARIANT_TYPE(double, Variant::FLOAT)
+MAKE_PTRARG_VARIANT_TYPE(String, Variant::STRING)
+MAKE_PTRARG_VARIANT_TYPE(Vector2, Variant::VECTOR2)
+MAKE_PTRARG_VARIANT_TYPE(Vector2i, Variant::VECTOR2I)
+MAKE_PTRARG_VARIANT_TYPE(Rect2, Variant::RECT2)
+MAKE_PTRARG_VARIANT_TYPE(Rect2i, Variant::RECT2I)
+MAKE_PTRARG_VARIANT_TYPE(Vector3, Variant::VECTOR3)
+MAKE_PTRARG_VARIANT_TYPE(Vector3i, Variant::VECTOR3I)
+MAKE_PTRARG_VARIANT_TYPE(Transform2D, Variant::TRANSFORM2D)
+MAKE_PTRARG_VARIANT_TYPE(Vector4, Variant::VECTOR4)
+MAKE_PTRARG_VARIANT_TYPE(Vector4i, Variant::VECTOR4I)
+MAKE_PTRARG_VARIANT_TYPE(Plane, Variant::PLANE)
+MAKE_PTRARG_VARIANT_TYPE(Quaternion, Variant::QUATERNION)
+MAKE_PTRARG_VARIANT_TYPE(AABB, Variant::AABB)
+MAKE_PTRARG_VARIANT_TYPE(Basis, Variant::BASIS)
+MAKE_PTRARG_VARIANT_TYPE(Transform3D, Variant::TRANSFORM3D)
+MAKE_PTRARG_VARIANT_TYPE(Projection, Variant::PROJECTION)
+MAKE_PTRARG_VARIANT_TYPE(Color, Variant::COLOR)
+MAKE_PTRARG_VARIANT_TYPE(StringName, Variant::STRING_NAME)
+MAKE_PTRARG_VARIANT_TYPE(NodePath, Variant::NODE_PATH)
+MAKE_PTRARG_VARIANT_TYPE(RID, Variant::RID)
+MAKE_PTRARG_VARIANT_TYPE(Callable, Variant::CALLABLE)
+MAKE_PTRARG_VARIANT_TYPE(Signal, Variant::SIGNAL)
+MAKE_PTRARG_VARIANT_TYPE(Dictionary, Variant::DICTIONARY)
+MAKE_PTRARG_VARIANT_TYPE(Array, Variant::ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedByteArray, Variant::PACKED_BYTE_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedInt32Array, Variant::PACKED_INT32_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedInt64Array, Variant::PACKED_INT64_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedFloat32Array, Variant::PACKED_FLOAT32_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedFloat64Array, Variant::PACKED_FLOAT64_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedStringArray, Variant::PACKED_STRING_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedVector2Array, Variant::PACKED_VECTOR2_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedVector3Array, Variant::PACKED_VECTOR3_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedColorArray, Variant::PACKED_COLOR_ARRAY)
+MAKE_PTRARG_VARIANT_TYPE(PackedVector4Array, Variant::PACKED_VECTOR4_ARRAY)
+
+#undef MAKE_PTRARG_VARIANT_TYPE
@@ -0,0 +1,447 @@
+/**************************************************************************/
+/*  packed_array_math.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#include "packed_array_math.h"
+
+#include "core/error/error_macros.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PACKED_ARRAY_MATH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace PackedArrayMath {
+
+// Scalar loops, used for doubles and for whatever the SIMD loops leave over.
+// The `p_from` offset of the repeated variants must be a multiple of the stride.
+
+template <typename T>
+static void _add(T *r_values, const T *p_other, int64_t p_from, int64_t p_count) {
+	for (int64_t i = p_from; i < p_count; i++) {
+		r_values[i] += p_other[i];
+	}
+}
+
+template <typename T>
+static void _multiply(T *r_values, const T *p_other, int64_t p_from, int64_t p_count) {
+	for (int64_t i = p_from; i < p_count; i++) {
+		r_values[i] *= p_other[i];
+	}
+}
+
+template <typename T>
+static void _lerp(T *r_values, const T *p_to, T p_weight, int64_t p_from, int64_t p_count) {
+	for (int64_t i = p_from; i < p_count; i++) {
+		r_values[i] += (p_to[i] - r_values[i]) * p_weight;
+	}
+}
+
+template <typename T>
+static void _add_repeated(T *r_values, const T *p_value, int p_stride, int64_t p_from, int64_t p_count) {
+	for (int64_t i = p_from; i < p_count; i += p_stride) {
+		for (int c = 0; c < p_stride; c++) {
+			r_values[i + c] += p_value[c];
+		}
+	}
+}
+
+template <typename T>
+static void _multiply_repeated(T *r_values, const T *p_value, int p_stride, int64_t p_from, int64_t p_count) {
+	for (int64_t i = p_from; i < p_count; i += p_stride) {
+		for (int c = 0; c < p_stride; c++) {
+			r_values[i + c] *= p_value[c];
+		}
+	}
+}
+
+template <typename T>
+static void _clamp_repeated(T *r_values, const T *p_min, const T *p_max, int p_stride, int64_t p_from, int64_t p_count) {
+	for (int64_t i = p_from; i < p_count; i += p_stride) {
+		for (int c = 0; c < p_stride; c++) {
+			r_values[i + c] = CLAMP(r_values[i + c], p_min[c], p_max[c]);
+		}
+	}
+}
+
+template <typename T>
+static void _min_repeated(const T *p_values, int p_stride, int64_t p_from, int64_t p_count, T *r_min) {
+	for (int64_t i = p_from; i < p_count; i += p_stride) {
+		for (int c = 0; c < p_stride; c++) {
+			r_min[c] = MIN(r_min[c], p_values[i + c]);
+		}
+	}
+}
+
+template <typename T>
+static void _max_repeated(const T *p_values, int p_stride, int64_t p_from, int64_t p_count, T *r_max) {
+	for (int64_t i = p_from; i < p_count; i += p_stride) {
+		for (int c = 0; c < p_stride; c++) {
+			r_max[c] = MAX(r_max[c], p_values[i + c]);
+		}
+	}
+}
+
+template <typename T>
+static void _sum_repeated(const T *p_values, int p_stride, int64_t p_from, int64_t p_count, double *r_sum) {
+	for (int64_t i = p_from; i < p_count; i += p_stride) {
+		for (int c = 0; c < p_stride; c++) {
+			r_sum[c] += p_values[i + c];
+		}
+	}
+}
+
+template <typename T>
+static void _transform_3d(T *r_values, const T *p_matrix, int64_t p_from, int64_t p_count) {
+	for (int64_t i = p_from; i < p_count; i += 3) {
+		const T x = r_values[i];
+		const T y = r_values[i + 1];
+		const T z = r_values[i + 2];
+		for (int c = 0; c < 3; c++) {
+			const T *row = p_matrix + 3 * c;
+			r_values[i + c] = row[0] * x + row[1] * y + row[2] * z + p_matrix[9 + c];
+		}
+	}
+}
+
+#ifdef PACKED_ARRAY_MATH_SSE2
+// The repeated kernels process blocks of four elements, which is `p_stride` SSE
+// registers. Within a block each register lane always maps to the same component,
+// so one register of the element pattern per block position is enough.
+static void _fill_pattern(const float *p_value, int p_stride, __m128 *r_pattern) {
+	float pattern[16];
+	for (int i = 0; i < 4 * p_stride; i++) {
+		pattern[i] = p_value[i % p_stride];
+	}
+	for (int j = 0; j < p_stride; j++) {
+		r_pattern[j] = _mm_loadu_ps(pattern + 4 * j);
+	}
+}
+
+// Returns the component (`0` to `p_stride - 1`) of lane `p_lane` in register `p_register` of a block.
+static _FORCE_INLINE_ int _lane_component(int p_stride, int p_register, int p_lane) {
+	return (4 * p_register + p_lane) % p_stride;
+}
+#endif
+
+void add(float *r_values, const float *p_other, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_values + i, _mm_add_ps(_mm_loadu_ps(r_values + i), _mm_loadu_ps(p_other + i)));
+	}
+#endif
+	_add(r_values, p_other, i, p_count);
+}
+
+void add(double *r_values, const double *p_other, int64_t p_count) {
+	_add(r_values, p_other, 0, p_count);
+}
+
+void multiply(float *r_values, const float *p_other, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_values + i, _mm_mul_ps(_mm_loadu_ps(r_values + i), _mm_loadu_ps(p_other + i)));
+	}
+#endif
+	_multiply(r_values, p_other, i, p_count);
+}
+
+void multiply(double *r_values, const double *p_other, int64_t p_count) {
+	_multiply(r_values, p_other, 0, p_count);
+}
+
+void lerp(float *r_values, const float *p_to, float p_weight, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	const __m128 weight = _mm_set1_ps(p_weight);
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 from = _mm_loadu_ps(r_values + i);
+		const __m128 to = _mm_loadu_ps(p_to + i);
+		_mm_storeu_ps(r_values + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), weight)));
+	}
+#endif
+	_lerp(r_values, p_to, p_weight, i, p_count);
+}
+
+void lerp(double *r_values, const double *p_to, double p_weight, int64_t p_count) {
+	_lerp(r_values, p_to, p_weight, 0, p_count);
+}
+
+void add_repeated(float *r_values, const float *p_value, int p_stride, int64_t p_count) {
+	DEV_ASSERT(p_stride >= 1 && p_stride <= 4 && p_count % p_stride == 0);
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	__m128 pattern[4];
+	_fill_pattern(p_value, p_stride, pattern);
+	const int block = 4 * p_stride;
+	for (; i + block <= p_count; i += block) {
+		for (int j = 0; j < p_stride; j++) {
+			float *ptr = r_values + i + 4 * j;
+			_mm_storeu_ps(ptr, _mm_add_ps(_mm_loadu_ps(ptr), pattern[j]));
+		}
+	}
+#endif
+	_add_repeated(r_values, p_value, p_stride, i, p_count);
+}
+
+void add_repeated(double *r_values, const double *p_value, int p_stride, int64_t p_count) {
+	_add_repeated(r_values, p_value, p_stride, 0, p_count);
+}
+
+void multiply_repeated(float *r_values, const float *p_value, int p_stride, int64_t p_count) {
+	DEV_ASSERT(p_stride >= 1 && p_stride <= 4 && p_count % p_stride == 0);
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	__m128 pattern[4];
+	_fill_pattern(p_value, p_stride, pattern);
+	const int block = 4 * p_stride;
+	for (; i + block <= p_count; i += block) {
+		for (int j = 0; j < p_stride; j++) {
+			float *ptr = r_values + i + 4 * j;
+			_mm_storeu_ps(ptr, _mm_mul_ps(_mm_loadu_ps(ptr), pattern[j]));
+		}
+	}
+#endif
+	_multiply_repeated(r_values, p_value, p_stride, i, p_count);
+}
+
+void multiply_repeated(double *r_values, const double *p_value, int p_stride, int64_t p_count) {
+	_multiply_repeated(r_values, p_value, p_stride, 0, p_count);
+}
+
+void clamp_repeated(float *r_values, const float *p_min, const float *p_max, int p_stride, int64_t p_count) {
+	DEV_ASSERT(p_stride >= 1 && p_stride <= 4 && p_count % p_stride == 0);
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	__m128 min_pattern[4];
+	__m128 max_pattern[4];
+	_fill_pattern(p_min, p_stride, min_pattern);
+	_fill_pattern(p_max, p_stride, max_pattern);
+	const int block = 4 * p_stride;
+	for (; i + block <= p_count; i += block) {
+		for (int j = 0; j < p_stride; j++) {
+			float *ptr = r_values + i + 4 * j;
+			// Same as CLAMP(), including NaN and inverted ranges: `value < min ? min : (value > max ? max : value)`.
+			// _mm_min_ps() returns its second operand when the comparison fails.
+			const __m128 value = _mm_loadu_ps(ptr);
+			const __m128 below = _mm_cmplt_ps(value, min_pattern[j]);
+			const __m128 upper_clamped = _mm_min_ps(max_pattern[j], value);
+			_mm_storeu_ps(ptr, _mm_or_ps(_mm_and_ps(below, min_pattern[j]), _mm_andnot_ps(below, upper_clamped)));
+		}
+	}
+#endif
+	_clamp_repeated(r_values, p_min, p_max, p_stride, i, p_count);
+}
+
+void clamp_repeated(double *r_values, const double *p_min, const double *p_max, int p_stride, int64_t p_count) {
+	_clamp_repeated(r_values, p_min, p_max, p_stride, 0, p_count);
+}
+
+void min_repeated(const float *p_values, int p_stride, int64_t p_count, float *r_min) {
+	DEV_ASSERT(p_stride >= 1 && p_stride <= 4 && p_count >= p_stride && p_count % p_stride == 0);
+	for (int c = 0; c < p_stride; c++) {
+		r_min[c] = p_values[c];
+	}
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	const int block = 4 * p_stride;
+	if (p_count >= block) {
+		__m128 acc[4];
+		__m128 nan = _mm_setzero_ps();
+		for (int j = 0; j < p_stride; j++) {
+			acc[j] = _mm_loadu_ps(p_values + 4 * j);
+			nan = _mm_or_ps(nan, _mm_cmpunord_ps(acc[j], acc[j]));
+		}
+		for (i = block; i + block <= p_count; i += block) {
+			for (int j = 0; j < p_stride; j++) {
+				const __m128 value = _mm_loadu_ps(p_values + i + 4 * j);
+				acc[j] = _mm_min_ps(acc[j], value);
+				nan = _mm_or_ps(nan, _mm_cmpunord_ps(value, value));
+			}
+		}
+		if (unlikely(_mm_movemask_ps(nan))) {
+			// MIN() lets a NaN through or drops it depending on where it is in the sequence,
+			// which the lanes can't reproduce. Let the scalar loop redo it all.
+			i = p_stride;
+		} else {
+			for (int j = 0; j < p_stride; j++) {
+				float lanes[4];
+				_mm_storeu_ps(lanes, acc[j]);
+				for (int l = 0; l < 4; l++) {
+					const int c = _lane_component(p_stride, j, l);
+					r_min[c] = MIN(r_min[c], lanes[l]);
+				}
+			}
+		}
+	}
+#endif
+	_min_repeated(p_values, p_stride, i, p_count, r_min);
+}
+
+void min_repeated(const double *p_values, int p_stride, int64_t p_count, double *r_min) {
+	DEV_ASSERT(p_count >= p_stride);
+	for (int c = 0; c < p_stride; c++) {
+		r_min[c] = p_values[c];
+	}
+	_min_repeated(p_values, p_stride, p_stride, p_count, r_min);
+}
+
+void max_repeated(const float *p_values, int p_stride, int64_t p_count, float *r_max) {
+	DEV_ASSERT(p_stride >= 1 && p_stride <= 4 && p_count >= p_stride && p_count % p_stride == 0);
+	for (int c = 0; c < p_stride; c++) {
+		r_max[c] = p_values[c];
+	}
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	const int block = 4 * p_stride;
+	if (p_count >= block) {
+		__m128 acc[4];
+		__m128 nan = _mm_setzero_ps();
+		for (int j = 0; j < p_stride; j++) {
+			acc[j] = _mm_loadu_ps(p_values + 4 * j);
+			nan = _mm_or_ps(nan, _mm_cmpunord_ps(acc[j], acc[j]));
+		}
+		for (i = block; i + block <= p_count; i += block) {
+			for (int j = 0; j < p_stride; j++) {
+				const __m128 value = _mm_loadu_ps(p_values + i + 4 * j);
+				acc[j] = _mm_max_ps(acc[j], value);
+				nan = _mm_or_ps(nan, _mm_cmpunord_ps(value, value));
+			}
+		}
+		if (unlikely(_mm_movemask_ps(nan))) {
+			// MAX() lets a NaN through or drops it depending on where it is in the sequence,
+			// which the lanes can't reproduce. Let the scalar loop redo it all.
+			i = p_stride;
+		} else {
+			for (int j = 0; j < p_stride; j++) {
+				float lanes[4];
+				_mm_storeu_ps(lanes, acc[j]);
+				for (int l = 0; l < 4; l++) {
+					const int c = _lane_component(p_stride, j, l);
+					r_max[c] = MAX(r_max[c], lanes[l]);
+				}
+			}
+		}
+	}
+#endif
+	_max_repeated(p_values, p_stride, i, p_count, r_max);
+}
+
+void max_repeated(const double *p_values, int p_stride, int64_t p_count, double *r_max) {
+	DEV_ASSERT(p_count >= p_stride);
+	for (int c = 0; c < p_stride; c++) {
+		r_max[c] = p_values[c];
+	}
+	_max_repeated(p_values, p_stride, p_stride, p_count, r_max);
+}
+
+void sum_repeated(const float *p_values, int p_stride, int64_t p_count, double *r_sum) {
+	DEV_ASSERT(p_stride >= 1 && p_stride <= 4 && p_count % p_stride == 0);
+	for (int c = 0; c < p_stride; c++) {
+		r_sum[c] = 0.0;
+	}
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	const int block = 4 * p_stride;
+	if (p_count >= block) {
+		// Two double registers (lanes 0-1 and 2-3) per float register.
+		__m128d acc_low[4];
+		__m128d acc_high[4];
+		for (int j = 0; j < p_stride; j++) {
+			acc_low[j] = _mm_setzero_pd();
+			acc_high[j] = _mm_setzero_pd();
+		}
+		for (; i + block <= p_count; i += block) {
+			for (int j = 0; j < p_stride; j++) {
+				const __m128 v = _mm_loadu_ps(p_values + i + 4 * j);
+				acc_low[j] = _mm_add_pd(acc_low[j], _mm_cvtps_pd(v));
+				acc_high[j] = _mm_add_pd(acc_high[j], _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+			}
+		}
+		for (int j = 0; j < p_stride; j++) {
+			double lanes[4];
+			_mm_storeu_pd(lanes, acc_low[j]);
+			_mm_storeu_pd(lanes + 2, acc_high[j]);
+			for (int l = 0; l < 4; l++) {
+				r_sum[_lane_component(p_stride, j, l)] += lanes[l];
+			}
+		}
+	}
+#endif
+	_sum_repeated(p_values, p_stride, i, p_count, r_sum);
+}
+
+void sum_repeated(const double *p_values, int p_stride, int64_t p_count, double *r_sum) {
+	for (int c = 0; c < p_stride; c++) {
+		r_sum[c] = 0.0;
+	}
+	_sum_repeated(p_values, p_stride, 0, p_count, r_sum);
+}
+
+void transform_3d(float *r_values, const float *p_matrix, int64_t p_count) {
+	DEV_ASSERT(p_count % 3 == 0);
+	int64_t i = 0;
+#ifdef PACKED_ARRAY_MATH_SSE2
+	__m128 m[12];
+	for (int k = 0; k < 12; k++) {
+		m[k] = _mm_set1_ps(p_matrix[k]);
+	}
+	// Four vectors at a time: the three registers `x0 y0 z0 x1`, `y1 z1 x2 y2` and `z2 x3 y3 z3`
+	// are split into one register per axis, transformed, and interleaved back.
+	for (; i + 12 <= p_count; i += 12) {
+		const __m128 a = _mm_loadu_ps(r_values + i);
+		const __m128 b = _mm_loadu_ps(r_values + i + 4);
+		const __m128 c = _mm_loadu_ps(r_values + i + 8);
+		const __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+
+		// Same operation order as the scalar loop, so the results are identical.
+		__m128 axes[3];
+		for (int k = 0; k < 3; k++) {
+			const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[3 * k], x), _mm_mul_ps(m[3 * k + 1], y)), _mm_mul_ps(m[3 * k + 2], z));
+			axes[k] = _mm_add_ps(dot, m[9 + k]);
+		}
+
+		_mm_storeu_ps(r_values + i, _mm_shuffle_ps(_mm_shuffle_ps(axes[0], axes[1], _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(axes[2], axes[0], _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(r_values + i + 4, _mm_shuffle_ps(_mm_shuffle_ps(axes[1], axes[2], _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(axes[0], axes[1], _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(r_values + i + 8, _mm_shuffle_ps(_mm_shuffle_ps(axes[2], axes[0], _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(axes[1], axes[2], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+#endif
+	_transform_3d(r_values, p_matrix, i, p_count);
+}
+
+void transform_3d(double *r_values, const double *p_matrix, int64_t p_count) {
+	_transform_3d(r_values, p_matrix, 0, p_count);
+}
+
+} // namespace PackedArrayMath
@@ -0,0 +1,72 @@
+/**************************************************************************/
+/*  packed_array_math.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Element-wise kernels behind the bulk math methods of PackedFloat32Array,
+// PackedVector3Array and PackedColorArray.
+// Vector and color elements are handled as runs of `p_stride` components (1 to 4),
+// so every kernel works on flat float or double data; `p_count` is the number
+// of components, not elements. The float versions use SSE2 when available.
+namespace PackedArrayMath {
+
+void add(float *r_values, const float *p_other, int64_t p_count);
+void add(double *r_values, const double *p_other, int64_t p_count);
+void multiply(float *r_values, const float *p_other, int64_t p_count);
+void multiply(double *r_values, const double *p_other, int64_t p_count);
+void lerp(float *r_values, const float *p_to, float p_weight, int64_t p_count);
+void lerp(double *r_values, const double *p_to, double p_weight, int64_t p_count);
+
+// `p_value`, `p_min` and `p_max` hold one element (`p_stride` components).
+void add_repeated(float *r_values, const float *p_value, int p_stride, int64_t p_count);
+void add_repeated(double *r_values, const double *p_value, int p_stride, int64_t p_count);
+void multiply_repeated(float *r_values, const float *p_value, int p_stride, int64_t p_count);
+void multiply_repeated(double *r_values, const double *p_value, int p_stride, int64_t p_count);
+void clamp_repeated(float *r_values, const float *p_min, const float *p_max, int p_stride, int64_t p_count);
+void clamp_repeated(double *r_values, const double *p_min, const double *p_max, int p_stride, int64_t p_count);
+
+// Per-component reductions. `p_count` must be at least `p_stride`.
+void min_repeated(const float *p_values, int p_stride, int64_t p_count, float *r_min);
+void min_repeated(const double *p_values, int p_stride, int64_t p_count, double *r_min);
+void max_repeated(const float *p_values, int p_stride, int64_t p_count, float *r_max);
+void max_repeated(const double *p_values, int p_stride, int64_t p_count, double *r_max);
+// Sums are accumulated in double precision.
+void sum_repeated(const float *p_values, int p_stride, int64_t p_count, double *r_sum);
+void sum_repeated(const double *p_values, int p_stride, int64_t p_count, double *r_sum);
+
+// Transforms runs of 3 components (`p_count` must be a multiple of 3) like Transform3D::xform().
+// `p_matrix` holds the three rows of the basis followed by the origin.
+void transform_3d(float *r_values, const float *p_matrix, int64_t p_count);
+void transform_3d(double *r_values, const double *p_matrix, int64_t p_count);
+
+} // namespace PackedArrayMath
@@ -36,6 +36,7 @@
 #include "core/templates/local_vector.h"
 #include "core/variant/binder_common.h"
 #include "core/variant/method_ptrcall.h"
+#include "core/variant/packed_array_math.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_internal.h"
 
@@ -1246,6 +1247,150 @@ struct _VariantCall {
 		return p_vector->bsearch(p_value, p_before);
 	}
 #endif
+
+	// Bulk math on packed float, vector and color arrays. Elements are passed to the
+	// PackedArrayMath kernels as flat runs of STRIDE components.
+	template <typename T>
+	struct PackedMathElement;
+
+	template <typename T>
+	static typename PackedMathElement<T>::Component *_packed_components(T *p_elements) {
+		static_assert(sizeof(T) == PackedMathElement<T>::STRIDE * sizeof(typename PackedMathElement<T>::Component));
+		return reinterpret_cast<typename PackedMathElement<T>::Component *>(p_elements);
+	}
+
+	template <typename T>
+	static const typename PackedMathElement<T>::Component *_packed_components(const T *p_elements) {
+		static_assert(sizeof(T) == PackedMathElement<T>::STRIDE * sizeof(typename PackedMathElement<T>::Component));
+		return reinterpret_cast<const typename PackedMathElement<T>::Component *>(p_elements);
+	}
+
+	template <typename T>
+	static void func_packed_add_value(Vector<T> *p_instance, const T &p_value) {
+		const int64_t count = p_instance->size() * PackedMathElement<T>::STRIDE;
+		if (count > 0) {
+			PackedArrayMath::add_repeated(_packed_components(p_instance->ptrw()), _packed_components(&p_value), PackedMathElement<T>::STRIDE, count);
+		}
+	}
+
+	template <typename T>
+	static void func_packed_multiply_value(Vector<T> *p_instance, const T &p_value) {
+		const int64_t count = p_instance->size() * PackedMathElement<T>::STRIDE;
+		if (count > 0) {
+			PackedArrayMath::multiply_repeated(_packed_components(p_instance->ptrw()), _packed_components(&p_value), PackedMathElement<T>::STRIDE, count);
+		}
+	}
+
+	template <typename T>
+	static void func_packed_add_array(Vector<T> *p_instance, const Vector<T> &p_array) {
+		ERR_FAIL_COND_MSG(p_instance->size() != p_array.size(), vformat("Array sizes don't match (%d and %d).", p_instance->size(), p_array.size()));
+		const int64_t count = p_instance->size() * PackedMathElement<T>::STRIDE;
+		if (count > 0) {
+			PackedArrayMath::add(_packed_components(p_instance->ptrw()), _packed_components(p_array.ptr()), count);
+		}
+	}
+
+	template <typename T>
+	static void func_packed_multiply_array(Vector<T> *p_instance, const Vector<T> &p_array) {
+		ERR_FAIL_COND_MSG(p_instance->size() != p_array.size(), vformat("Array sizes don't match (%d and %d).", p_instance->size(), p_array.size()));
+		const int64_t count = p_instance->size() * PackedMathElement<T>::STRIDE;
+		if (count > 0) {
+			PackedArrayMath::multiply(_packed_components(p_instance->ptrw()), _packed_components(p_array.ptr()), count);
+		}
+	}
+
+	template <typename T>
+	static void func_packed_lerp_array(Vector<T> *p_instance, const Vector<T> &p_to, double p_weight) {
+		ERR_FAIL_COND_MSG(p_instance->size() != p_to.size(), vformat("Array sizes don't match (%d and %d).", p_instance->size(), p_to.size()));
+		const int64_t count = p_instance->size() * PackedMathElement<T>::STRIDE;
+		if (count > 0) {
+			PackedArrayMath::lerp(_packed_components(p_instance->ptrw()), _packed_components(p_to.ptr()), typename PackedMathElement<T>::Component(p_weight), count);
+		}
+	}
+
+	template <typename T>
+	static void func_packed_clamp(Vector<T> *p_instance, const T &p_min, const T &p_max) {
+		const int64_t count = p_instance->size() * PackedMathElement<T>::STRIDE;
+		if (count > 0) {
+			PackedArrayMath::clamp_repeated(_packed_components(p_instance->ptrw()), _packed_components(&p_min), _packed_components(&p_max), PackedMathElement<T>::STRIDE, count);
+		}
+	}
+
+	template <typename T>
+	static T func_packed_min(Vector<T> *p_instance) {
+		T ret = T();
+		if (!p_instance->is_empty()) {
+			PackedArrayMath::min_repeated(_packed_components(p_instance->ptr()), PackedMathElement<T>::STRIDE, p_instance->size() * PackedMathElement<T>::STRIDE, _packed_components(&ret));
+		}
+		return ret;
+	}
+
+	template <typename T>
+	static T func_packed_max(Vector<T> *p_instance) {
+		T ret = T();
+		if (!p_instance->is_empty()) {
+			PackedArrayMath::max_repeated(_packed_components(p_instance->ptr()), PackedMathElement<T>::STRIDE, p_instance->size() * PackedMathElement<T>::STRIDE, _packed_components(&ret));
+		}
+		return ret;
+	}
+
+	template <typename T>
+	static typename PackedMathElement<T>::Sum func_packed_sum(Vector<T> *p_instance) {
+		double sum[4] = {};
+		if (!p_instance->is_empty()) {
+			PackedArrayMath::sum_repeated(_packed_components(p_instance->ptr()), PackedMathElement<T>::STRIDE, p_instance->size() * PackedMathElement<T>::STRIDE, sum);
+		}
+		return PackedMathElement<T>::make_sum(sum);
+	}
+
+	// Multiplies every component by the same factor, unlike multiply_value() which takes one per component.
+	template <typename T>
+	static void func_packed_multiply_scalar(Vector<T> *p_instance, double p_value) {
+		const int64_t count = p_instance->size() * PackedMathElement<T>::STRIDE;
+		const typename PackedMathElement<T>::Component value = p_value;
+		if (count > 0) {
+			PackedArrayMath::multiply_repeated(_packed_components(p_instance->ptrw()), &value, 1, count);
+		}
+	}
+
+	static void func_PackedVector3Array_transform(PackedVector3Array *p_instance, const Transform3D &p_transform) {
+		const int64_t count = p_instance->size() * 3;
+		if (count > 0) {
+			const Basis &basis = p_transform.basis;
+			const real_t matrix[12] = {
+				basis.rows[0].x, basis.rows[0].y, basis.rows[0].z,
+				basis.rows[1].x, basis.rows[1].y, basis.rows[1].z,
+				basis.rows[2].x, basis.rows[2].y, basis.rows[2].z,
+				p_transform.origin.x, p_transform.origin.y, p_transform.origin.z
+			};
+			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
+			PackedArrayMath::transform_3d(reinterpret_cast<real_t *>(p_instance->ptrw()), matrix, count);
+		}
+	}
+};
+
+template <>
+struct _VariantCall::PackedMathElement<float> {
+	typedef float Component;
+	typedef double Sum;
+	static constexpr int STRIDE = 1;
+	static Sum make_sum(const double *p_sum) { return p_sum[0]; }
+};
+
+template <>
+struct _VariantCall::PackedMathElement<Vector3> {
+	typedef real_t Component;
+	typedef Vector3 Sum;
+	static constexpr int STRIDE = 3;
+	static Sum make_sum(const double *p_sum) { return Vector3(p_sum[0], p_sum[1], p_sum[2]); }
+};
+
+template <>
+struct _VariantCall::PackedMathElement<Color> {
+	typedef float Component;
+	typedef Color Sum;
+	static constexpr int STRIDE = 4;
+	static Sum make_sum(const double *p_sum) { return Color(p_sum[0], p_sum[1], p_sum[2], p_sum[3]); }
 };
 
 HashMap<StringName, Variant> *_VariantCall::variant_constants = nullptr;
@@ -2867,6 +3012,15 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
 	bind_method(PackedFloat32Array, erase, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, add_value, _VariantCall::func_packed_add_value<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_value, _VariantCall::func_packed_multiply_value<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, add_array, _VariantCall::func_packed_add_array<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_array, _VariantCall::func_packed_multiply_array<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, lerp_array, _VariantCall::func_packed_lerp_array<float>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedFloat32Array, clamp, _VariantCall::func_packed_clamp<float>, sarray("min", "max"), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_packed_min<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_packed_max<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_packed_sum<float>, sarray(), varray());
 
 	/* Float64 Array */
 
@@ -2979,6 +3133,17 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
 	bind_method(PackedVector3Array, erase, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, add_value, _VariantCall::func_packed_add_value<Vector3>, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, multiply_value, _VariantCall::func_packed_multiply_value<Vector3>, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, multiply_scalar, _VariantCall::func_packed_multiply_scalar<Vector3>, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, add_array, _VariantCall::func_packed_add_array<Vector3>, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, multiply_array, _VariantCall::func_packed_multiply_array<Vector3>, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, lerp_array, _VariantCall::func_packed_lerp_array<Vector3>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedVector3Array, clamp, _VariantCall::func_packed_clamp<Vector3>, sarray("min", "max"), varray());
+	bind_function(PackedVector3Array, min, _VariantCall::func_packed_min<Vector3>, sarray(), varray());
+	bind_function(PackedVector3Array, max, _VariantCall::func_packed_max<Vector3>, sarray(), varray());
+	bind_function(PackedVector3Array, sum, _VariantCall::func_packed_sum<Vector3>, sarray(), varray());
+	bind_functionnc(PackedVector3Array, transform, _VariantCall::func_PackedVector3Array_transform, sarray("transform"), varray());
 
 	/* Color Array */
 
@@ -3007,6 +3172,16 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedColorArray, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedColorArray, count, sarray("value"), varray());
 	bind_method(PackedColorArray, erase, sarray("value"), varray());
+	bind_functionnc(PackedColorArray, add_value, _VariantCall::func_packed_add_value<Color>, sarray("value"), varray());
+	bind_functionnc(PackedColorArray, multiply_value, _VariantCall::func_packed_multiply_value<Color>, sarray("value"), varray());
+	bind_functionnc(PackedColorArray, multiply_scalar, _VariantCall::func_packed_multiply_scalar<Color>, sarray("value"), varray());
+	bind_functionnc(PackedColorArray, add_array, _VariantCall::func_packed_add_array<Color>, sarray("array"), varray());
+	bind_functionnc(PackedColorArray, multiply_array, _VariantCall::func_packed_multiply_array<Color>, sarray("array"), varray());
+	bind_functionnc(PackedColorArray, lerp_array, _VariantCall::func_packed_lerp_array<Color>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedColorArray, clamp, _VariantCall::func_packed_clamp<Color>, sarray("min", "max"), varray());
+	bind_function(PackedColorArray, min, _VariantCall::func_packed_min<Color>, sarray(), varray());
+	bind_function(PackedColorArray, max, _VariantCall::func_packed_max<Color>, sarray(), varray());
+	bind_function(PackedColorArray, sum, _VariantCall::func_packed_sum<Color>, sarray(), varray());
 
 	/* Vector4 Array */
 
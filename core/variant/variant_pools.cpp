@@ -34,6 +34,7 @@
 #include "core/math/projection.h"
 #include "core/math/transform_2d.h"
 #include "core/math/transform_3d.h"
+#include "core/os/thread.h"
 #include "core/templates/paged_allocator.h"
 
 namespace VariantPools {
@@ -64,9 +65,71 @@ static_assert(sizeof(BucketLarge) == VariantPools::BUCKET_LARGE);
 static_assert(alignof(BucketLarge) == alignof(real_t));
 } //namespace VariantPools
 
-static PagedAllocator<VariantPools::BucketSmall, true> _bucket_small;
-static PagedAllocator<VariantPools::BucketMedium, true> _bucket_medium;
-static PagedAllocator<VariantPools::BucketLarge, true> _bucket_large;
+namespace VariantPools {
+// Shared paged pool with per-thread caches in front of it, so that threads
+// creating and destroying many Variants don't all contend on the pool's lock.
+// As in RID_Alloc, each thread uses one of THREAD_CACHE_COUNT caches picked
+// by its caller ID; the caches exchange THREAD_CACHE_BATCH elements at a time
+// with the pool. A cache is normally only touched by one thread, so its lock
+// is uncontended.
+template <typename T>
+class CachedPool {
+	static constexpr uint32_t THREAD_CACHE_COUNT = 16;
+	static constexpr uint32_t THREAD_CACHE_SIZE = 64;
+	static constexpr uint32_t THREAD_CACHE_BATCH = 32;
+
+	struct alignas(64) ThreadCache {
+		SpinLock lock;
+		uint32_t count = 0;
+		T *elements[THREAD_CACHE_SIZE];
+	};
+
+	PagedAllocator<T, true> pool;
+	ThreadCache caches[THREAD_CACHE_COUNT];
+
+	_FORCE_INLINE_ ThreadCache &_get_thread_cache() {
+		return caches[Thread::get_caller_id() % THREAD_CACHE_COUNT];
+	}
+
+public:
+	_FORCE_INLINE_ void *alloc() {
+		ThreadCache &cache = _get_thread_cache();
+		cache.lock.lock();
+		if (unlikely(cache.count == 0)) {
+			pool.alloc_batch(cache.elements, THREAD_CACHE_BATCH);
+			cache.count = THREAD_CACHE_BATCH;
+		}
+		T *ret = cache.elements[--cache.count];
+		cache.lock.unlock();
+		return ret;
+	}
+
+	_FORCE_INLINE_ void free(void *p_ptr) {
+		ThreadCache &cache = _get_thread_cache();
+		cache.lock.lock();
+		if (unlikely(cache.count == THREAD_CACHE_SIZE)) {
+			// Return the older half, keeping the most recently freed (and likely still cached in memory) elements.
+			pool.free_batch(cache.elements, THREAD_CACHE_BATCH);
+			memmove(cache.elements, cache.elements + THREAD_CACHE_BATCH, sizeof(T *) * (THREAD_CACHE_SIZE - THREAD_CACHE_BATCH));
+			cache.count -= THREAD_CACHE_BATCH;
+		}
+		cache.elements[cache.count++] = static_cast<T *>(p_ptr);
+		cache.lock.unlock();
+	}
+
+	~CachedPool() {
+		// Give everything back before the pool checks for leaks.
+		for (ThreadCache &cache : caches) {
+			pool.free_batch(cache.elements, cache.count);
+			cache.count = 0;
+		}
+	}
+};
+} //namespace VariantPools
+
+static VariantPools::CachedPool<VariantPools::BucketSmall> _bucket_small;
+static VariantPools::CachedPool<VariantPools::BucketMedium> _bucket_medium;
+static VariantPools::CachedPool<VariantPools::BucketLarge> _bucket_large;
 
 void *VariantPools::alloc_small() {
 	return _bucket_small.alloc();
@@ -81,13 +144,13 @@ void *VariantPools::alloc_large() {
 }
 
 void VariantPools::free_small(void *p_ptr) {
-	_bucket_small.free(static_cast<BucketSmall *>(p_ptr));
+	_bucket_small.free(p_ptr);
 }
 
 void VariantPools::free_medium(void *p_ptr) {
-	_bucket_medium.free(static_cast<BucketMedium *>(p_ptr));
+	_bucket_medium.free(p_ptr);
 }
 
 void VariantPools::free_large(void *p_ptr) {
-	_bucket_large.free(static_cast<BucketLarge *>(p_ptr));
+	_bucket_large.free(p_ptr);
 }
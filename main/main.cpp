@@ -51,6 +51,7 @@
 #include "core/object/class_db.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/os/process_id.h"
 #include "core/os/time.h"
@@ -153,6 +154,7 @@
 
 #ifdef MODULE_GDSCRIPT_ENABLED
 #include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_sampling_profiler.h"
 #if defined(TOOLS_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 #include "modules/gdscript/language_server/gdscript_language_server.h"
 #endif // TOOLS_ENABLED && !GDSCRIPT_NO_LSP
@@ -592,6 +594,9 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-b, --breakpoints", "Breakpoint list as source:line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--ignore-error-breaks", "If debugger is connected, prevents sending error breakpoints.\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+#ifdef MODULE_GDSCRIPT_ENABLED
+	print_help_option("--script-profile <file>", "Sample GDScript call stacks while running and write them to <file> in the folded format used by flame graph tools.\n");
+#endif // MODULE_GDSCRIPT_ENABLED
 #endif
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
@@ -1468,6 +1473,16 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 					"`--profiling` was specified on the command line, but this Godot binary was compiled without debug. Aborting.\n"
 					"To be able to use it, use the `target=template_debug` SCons option when compiling Godot.\n");
 #endif
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+		} else if (arg == "--script-profile") {
+			if (N) {
+				GDScriptSamplingProfiler::cli_output_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <file> argument for --script-profile <file>.\n");
+				goto error;
+			}
+#endif // DEBUG_ENABLED && MODULE_GDSCRIPT_ENABLED
 		} else if (arg == "-l" || arg == "--language") { // language
 
 			if (N) {
@@ -5077,6 +5092,8 @@ bool Main::iteration() {
 	frames++;
 	Engine::get_singleton()->_process_frames++;
 
+	FrameArena::end_frame();
+
 	if (frame > 1000000) {
 		// Wait a few seconds before printing FPS, as FPS reporting just after the engine has started is inaccurate.
 		if (hide_print_fps_attempts == 0) {
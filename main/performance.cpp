@@ -33,6 +33,7 @@
 
 #include "core/config/engine.h"
 #include "core/object/class_db.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
@@ -135,6 +136,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_MAX);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -229,7 +232,12 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_connected"),
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
+#else
+		// Keeps the indices of the monitors below the same in every build.
+		"", "", "", "", "", "", "", "", "", "",
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("memory/frame_arena"),
+		PNAME("memory/frame_arena_max"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -254,6 +262,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return Memory::get_mem_max_usage();
 		case MEMORY_MESSAGE_BUFFER_MAX:
 			return MessageQueue::get_singleton()->get_max_buffer_usage();
+		case MEMORY_FRAME_ARENA:
+			return FrameArena::get_frame_high_water();
+		case MEMORY_FRAME_ARENA_MAX:
+			return FrameArena::get_max_high_water();
 		case OBJECT_COUNT:
 			return ObjectDB::get_object_count();
 		case OBJECT_RESOURCE_COUNT:
@@ -526,8 +538,13 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+#else
+		// Keeps the indices of the monitors below the same in every build.
+		MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
-
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
 
@@ -122,6 +122,9 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		// Same value whether or not 3D is disabled.
+		MEMORY_FRAME_ARENA = NAVIGATION_2D_OBSTACLE_COUNT + 11,
+		MEMORY_FRAME_ARENA_MAX,
 		MONITOR_MAX
 	};
 
@@ -31,9 +31,11 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -818,9 +820,33 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+
+	if (is_root_script() && path.is_resource_file() && GDScriptBytecodeCache::is_enabled()) {
+		const Vector<uint8_t> cached = GDScriptBytecodeCache::fetch(path, GDScriptBytecodeCache::get_source_digest(this));
+		if (!cached.is_empty() && GDScriptBytecodeCache::deserialize(this, cached) == OK) {
+			Error err = GDScriptCache::finish_compiling(path);
+			if (err) {
+				_err_print_error("GDScript::reload", (const char *)path.utf8().get_data(), 0, "Compile Error: Failed to compile depended scripts.", false, ERR_HANDLER_SCRIPT);
+				reloading = false;
+				return ERR_COMPILATION_FAILED;
+			}
+			if (ScriptServer::is_scripting_enabled() || tool) {
+				err = _static_init();
+				if (err) {
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+	}
+
 	GDScriptParser parser;
 	Error err;
-	if (!binary_tokens.is_empty()) {
+	// Dependencies may have been parsed ahead on worker threads, see `GDScriptCache::finish_compiling()`.
+	if (!path.is_empty() && GDScriptCache::take_parsed_script(path, this, parser)) {
+		err = OK;
+	} else if (!binary_tokens.is_empty()) {
 		err = parser.parse_binary(binary_tokens, path);
 	} else {
 		err = parser.parse(source, path, false);
@@ -872,6 +898,10 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	if (is_root_script() && path.is_resource_file() && GDScriptBytecodeCache::is_enabled()) {
+		GDScriptBytecodeCache::store(this, &parser);
+	}
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -2182,6 +2212,11 @@ void GDScriptLanguage::init() {
 	if (!ProjectSettings::get_singleton()->is_connected("settings_changed", callable_mp_static(&GDScriptParser::update_project_settings))) {
 		ProjectSettings::get_singleton()->connect("settings_changed", callable_mp_static(&GDScriptParser::update_project_settings));
 	}
+
+	GDScriptSamplingProfiler::register_debugger_profiler();
+	if (!GDScriptSamplingProfiler::cli_output_path.is_empty() && !GDScriptSamplingProfiler::is_running()) {
+		GDScriptSamplingProfiler::start(GLOBAL_GET("debug/settings/gdscript/sampling_profiler_interval_usec"), GLOBAL_GET("debug/settings/gdscript/sampling_profiler_native_frames"));
+	}
 #endif // DEBUG_ENABLED
 
 #ifdef TESTS_ENABLED
@@ -2223,6 +2258,16 @@ void GDScriptLanguage::finish() {
 	ERR_FAIL_COND_MSG(finishing, "GDScript bug (please report): GDScriptLanguage double finish.");
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler::stop();
+	GDScriptSamplingProfiler::unregister_debugger_profiler();
+	if (!GDScriptSamplingProfiler::cli_output_path.is_empty()) {
+		if (GDScriptSamplingProfiler::save_folded_stacks(GDScriptSamplingProfiler::cli_output_path) == OK) {
+			print_line(vformat("GDScript sampling profile (%d samples) saved to \"%s\".", GDScriptSamplingProfiler::get_sample_count(), GDScriptSamplingProfiler::cli_output_path));
+		}
+	}
+#endif // DEBUG_ENABLED
+
 	// Clear the cache before parsing the `script_list`. Some `GDScript` instances will drop to a ref count of zero and destruct on their own.
 	// TODO: This might lead to issues when trying to load a script from within `NOTIFICATION_PREDELETE`, we ignore this issue for now.
 	GDScriptCache::clear();
@@ -2862,6 +2907,9 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	GLOBAL_DEF_RST("application/run/gdscript_bytecode_cache", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/gdscript/sampling_profiler_interval_usec", PROPERTY_HINT_RANGE, "50,100000,1,or_greater"), 1000);
+	GLOBAL_DEF("debug/settings/gdscript/sampling_profiler_native_frames", false);
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
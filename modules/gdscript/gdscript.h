@@ -72,6 +72,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -399,6 +400,7 @@ public:
 
 class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
+	friend class GDScriptSamplingProfiler;
 
 	static GDScriptLanguage *singleton;
 
@@ -225,6 +225,7 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->code = opcodes;
 		function->_code_ptr = &function->code.write[0];
 		function->_code_size = opcodes.size();
+		function->global_index_positions = global_index_positions;
 
 	} else {
 		function->_code_ptr = nullptr;
@@ -605,18 +606,23 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	}
 
 	if (valid) {
+		Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 		if (p_target.mode == Address::TEMPORARY) {
-			Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 			Variant::Type temp_type = temporaries[p_target.address].type;
 			if (result_type != temp_type) {
 				write_type_adjust(p_target, result_type);
 			}
 		}
 
+		if (p_operator == Variant::OP_ADD && _fuse_multiply_add(p_target, p_left_operand, p_right_operand)) {
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+		last_operator.position = opcodes.size();
+		append_opcode(GDScriptFunction::get_specialized_operator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type));
 		append(p_left_operand);
 		append(p_right_operand);
 		append(p_target);
@@ -624,6 +630,16 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
+
+		last_operator.end = opcodes.size();
+		last_operator.result_offset = 3;
+		last_operator.op = p_operator;
+		last_operator.left_type = p_left_operand.type.builtin_type;
+		last_operator.right_type = p_right_operand.type.builtin_type;
+		last_operator.result_type = result_type;
+		last_operator.left = p_left_operand;
+		last_operator.right = p_right_operand;
+		last_operator.result = p_target;
 		return;
 	}
 
@@ -641,6 +657,160 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	}
 }
 
+const GDScriptByteCodeGenerator::FusableOperator *GDScriptByteCodeGenerator::_get_fusable_operator(const Address &p_result) const {
+	if (!superinstructions_enabled) {
+		return nullptr;
+	}
+	// Only results in temporaries, since nothing else can read them between the two instructions.
+	if (last_operator.end != opcodes.size() || p_result.mode != Address::TEMPORARY || !_is_same_address(last_operator.result, p_result)) {
+		return nullptr;
+	}
+	return &last_operator;
+}
+
+void GDScriptByteCodeGenerator::_move_temporary_index(const Address &p_address, int p_from, int p_to) {
+	if (p_address.mode != Address::TEMPORARY) {
+		return;
+	}
+	Vector<int> &indices = temporaries.write[p_address.address].bytecode_indices;
+	for (int i = indices.size() - 1; i >= 0; i--) {
+		if (indices[i] == p_from) {
+			indices.write[i] = p_to;
+			return;
+		}
+	}
+}
+
+bool GDScriptByteCodeGenerator::_fuse_compare_and_jump(const Address &p_condition, List<int> &r_jmp_addrs) {
+	const FusableOperator *compare = _get_fusable_operator(p_condition);
+	if (compare == nullptr || compare->end != compare->position + 5 || compare->left_type != compare->right_type || compare->op > Variant::OP_GREATER_EQUAL) {
+		return false;
+	}
+
+	// The fused opcodes follow the order of the comparison operators.
+	static_assert(GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT - GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT == Variant::OP_GREATER_EQUAL - Variant::OP_EQUAL);
+	static_assert(GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT - GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_FLOAT == Variant::OP_GREATER_EQUAL - Variant::OP_EQUAL);
+	int opcode;
+	switch (compare->left_type) {
+		case Variant::INT:
+			opcode = GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT + (compare->op - Variant::OP_EQUAL);
+			break;
+		case Variant::FLOAT:
+			opcode = GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_FLOAT + (compare->op - Variant::OP_EQUAL);
+			break;
+		default:
+			return false;
+	}
+
+	// Keep the operator layout and append the jump destination, the result is still stored.
+	opcodes.write[compare->position] = opcode;
+	r_jmp_addrs.push_back(opcodes.size());
+	append(0); // Jump destination, will be patched.
+
+	last_operator.end = -1;
+	return true;
+}
+
+bool GDScriptByteCodeGenerator::_fuse_multiply_add(const Address &p_target, const Address &p_left_operand, const Address &p_right_operand) {
+	if (p_left_operand.type.builtin_type != Variant::VECTOR3 || p_right_operand.type.builtin_type != Variant::VECTOR3) {
+		return false;
+	}
+
+	const FusableOperator *product = _get_fusable_operator(p_left_operand);
+	Address addend = p_right_operand;
+	if (product == nullptr) {
+		product = _get_fusable_operator(p_right_operand);
+		addend = p_left_operand;
+	}
+	if (product == nullptr || product->op != Variant::OP_MULTIPLY || product->end != product->position + 5) {
+		return false;
+	}
+
+	const int position = product->position;
+	GDScriptFunction::Opcode opcode;
+	if (product->left_type == Variant::VECTOR3 && product->right_type == Variant::VECTOR3) {
+		opcode = GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3;
+	} else if (product->left_type == Variant::VECTOR3 && product->right_type == Variant::FLOAT) {
+		opcode = GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3_FLOAT;
+	} else if (product->left_type == Variant::FLOAT && product->right_type == Variant::VECTOR3) {
+		// Scaling is commutative, put the vector first.
+		opcode = GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3_FLOAT;
+		SWAP(opcodes.write[position + 1], opcodes.write[position + 2]);
+		_move_temporary_index(product->left, position + 1, position + 2);
+		_move_temporary_index(product->right, position + 2, position + 1);
+	} else {
+		return false;
+	}
+
+	const Address product_result = product->result;
+	Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(Variant::OP_ADD, Variant::VECTOR3, Variant::VECTOR3);
+
+	opcodes.write[position] = opcode;
+	append(addend);
+	append(p_target);
+	append(op_func);
+#ifdef DEBUG_ENABLED
+	add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(Variant::OP_ADD));
+#endif
+
+	last_operator.end = opcodes.size();
+	last_operator.result_offset = 6;
+	last_operator.op = Variant::OP_ADD;
+	last_operator.left_type = Variant::VECTOR3;
+	last_operator.right_type = Variant::VECTOR3;
+	last_operator.result_type = Variant::VECTOR3;
+	last_operator.left = addend;
+	last_operator.right = product_result;
+	last_operator.result = p_target;
+	return true;
+}
+
+bool GDScriptByteCodeGenerator::_fuse_assign(const Address &p_target, const Address &p_source) {
+	const FusableOperator *source = _get_fusable_operator(p_source);
+	if (source == nullptr) {
+		return false;
+	}
+
+	// Validated operators write the result in place, so the target must already hold a value of the result type.
+	// This is only known for typed variables which are also an operand, like `i += 1`.
+	if (p_target.mode != Address::LOCAL_VARIABLE && p_target.mode != Address::FUNCTION_PARAMETER) {
+		return false;
+	}
+	if (p_target.type.kind != GDScriptDataType::BUILTIN || p_target.type.builtin_type != source->result_type) {
+		return false;
+	}
+	if (!_is_same_address(source->left, p_target) && !_is_same_address(source->right, p_target)) {
+		return false;
+	}
+
+	// Only types which operators compute fully before storing, so the result can alias an operand.
+	switch (source->result_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::QUATERNION:
+		case Variant::COLOR:
+			break;
+		default:
+			return false;
+	}
+
+	const int result_position = source->position + source->result_offset;
+	Vector<int> &indices = temporaries.write[p_source.address].bytecode_indices;
+	ERR_FAIL_COND_V(indices.is_empty() || indices[indices.size() - 1] != result_position, false);
+	indices.remove_at(indices.size() - 1);
+
+	opcodes.write[result_position] = address_of(p_target);
+	last_operator.result = p_target;
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
 	switch (p_type.kind) {
 		case GDScriptDataType::BUILTIN: {
@@ -969,6 +1139,10 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (_fuse_assign(p_target, p_source)) {
+		return;
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type(0);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -1029,6 +1203,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+	global_index_positions.push_back(opcodes.size());
 	append(p_global_index);
 }
 
@@ -1521,6 +1696,10 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
+	if (_fuse_compare_and_jump(p_condition, if_jmp_addrs)) {
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
@@ -1792,10 +1971,15 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_operator.end = -1;
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
+	if (_fuse_compare_and_jump(p_condition, while_jmp_addrs)) {
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
@@ -79,6 +79,21 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	GDScriptFunction *function = nullptr;
 
 	Vector<int> opcodes;
+	Vector<int> global_index_positions;
+
+	// The last validated operator written, so the instruction consuming its result can be fused with it.
+	struct FusableOperator {
+		int position = -1; // Start of the instruction.
+		int end = -1; // Code size right after the instruction, it can only be fused while nothing else was written.
+		int result_offset = 3;
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type left_type = Variant::NIL;
+		Variant::Type right_type = Variant::NIL;
+		Variant::Type result_type = Variant::NIL;
+		Address left;
+		Address right;
+		Address result;
+	} last_operator;
 	List<RBMap<StringName, int>> stack_id_stack;
 	RBMap<StringName, int> stack_identifiers;
 	List<int> stack_identifiers_counts;
@@ -446,9 +461,24 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		// The current position is now a jump target, so the previous instruction must keep its size.
+		last_operator.end = -1;
 	}
 
+	static bool _is_same_address(const Address &p_a, const Address &p_b) {
+		return p_a.mode == p_b.mode && p_a.address == p_b.address;
+	}
+
+	const FusableOperator *_get_fusable_operator(const Address &p_result) const;
+	void _move_temporary_index(const Address &p_address, int p_from, int p_to);
+	bool _fuse_compare_and_jump(const Address &p_condition, List<int> &r_jmp_addrs);
+	bool _fuse_multiply_add(const Address &p_target, const Address &p_left_operand, const Address &p_right_operand);
+	bool _fuse_assign(const Address &p_target, const Address &p_source);
+
 public:
+	// Fusing can be turned off to compare against unfused code, e.g. in tests and benchmarks.
+	static inline bool superinstructions_enabled = true;
+
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local_constant(const StringName &p_name, const Variant &p_constant) override;
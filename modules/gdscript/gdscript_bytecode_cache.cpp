@@ -0,0 +1,2148 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/extension/gdextension_manager.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+static constexpr uint32_t CACHE_MAGIC = 0x43424447; // "GDBC".
+static constexpr int MAX_VARIANT_DEPTH = 64;
+
+enum CacheTag : uint8_t {
+	TAG_VALUE,
+	TAG_ARRAY,
+	TAG_DICTIONARY,
+	TAG_NULL_OBJECT,
+	TAG_SCRIPT,
+	TAG_GLOBAL,
+	TAG_RESOURCE,
+};
+
+enum CacheFlags : uint8_t {
+	FLAG_STATIC_SCRIPT = 1,
+};
+
+// Validated calls are stored as function pointers, so they are written out
+// as the operator, type and name they were looked up with.
+struct GDScriptBytecodeCacheTables {
+	struct Operator {
+		Variant::Operator op;
+		Variant::Type type_a;
+		Variant::Type type_b;
+	};
+
+	struct Member {
+		Variant::Type type;
+		StringName name;
+	};
+
+	struct Constructor {
+		Variant::Type type;
+		int index;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, Operator> operators;
+	RBMap<Variant::ValidatedSetter, Member> setters;
+	RBMap<Variant::ValidatedGetter, Member> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Member> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Constructor> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	GDScriptBytecodeCacheTables() {
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int a = 0; a < Variant::VARIANT_MAX; a++) {
+				for (int b = 0; b < Variant::VARIANT_MAX; b++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)a, (Variant::Type)b);
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, { (Variant::Operator)op, (Variant::Type)a, (Variant::Type)b });
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			const Variant::Type type = (Variant::Type)i;
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+				if (setter && !setters.has(setter)) {
+					setters.insert(setter, { type, member });
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+				if (getter && !getters.has(getter)) {
+					getters.insert(getter, { type, member });
+				}
+			}
+
+			Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+			if (keyed_setter && !keyed_setters.has(keyed_setter)) {
+				keyed_setters.insert(keyed_setter, type);
+			}
+			Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+			if (keyed_getter && !keyed_getters.has(keyed_getter)) {
+				keyed_getters.insert(keyed_getter, type);
+			}
+			Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+			if (indexed_setter && !indexed_setters.has(indexed_setter)) {
+				indexed_setters.insert(indexed_setter, type);
+			}
+			Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+			if (indexed_getter && !indexed_getters.has(indexed_getter)) {
+				indexed_getters.insert(indexed_getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+				if (builtin_method && !builtin_methods.has(builtin_method)) {
+					builtin_methods.insert(builtin_method, { type, method });
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+				if (constructor && !constructors.has(constructor)) {
+					constructors.insert(constructor, { type, j });
+				}
+			}
+		}
+
+		List<StringName> utility_functions;
+		Variant::get_utility_function_list(&utility_functions);
+		for (const StringName &name : utility_functions) {
+			Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(name);
+			if (utility && !utilities.has(utility)) {
+				utilities.insert(utility, name);
+			}
+		}
+
+		List<StringName> gds_utility_functions;
+		GDScriptUtilityFunctions::get_function_list(&gds_utility_functions);
+		for (const StringName &name : gds_utility_functions) {
+			GDScriptUtilityFunctions::FunctionPtr gds_utility = GDScriptUtilityFunctions::get_function(name);
+			if (gds_utility && !gds_utilities.has(gds_utility)) {
+				gds_utilities.insert(gds_utility, name);
+			}
+		}
+	}
+};
+
+template <typename K, typename V>
+static const V *_lookup(const RBMap<K, V> &p_map, const K &p_key) {
+	const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+	return E ? &E->value() : nullptr;
+}
+
+static GDScriptBytecodeCacheTables *reverse_tables = nullptr;
+static Mutex reverse_tables_mutex;
+
+static const GDScriptBytecodeCacheTables *_get_reverse_tables() {
+	MutexLock lock(reverse_tables_mutex);
+	if (reverse_tables == nullptr) {
+		reverse_tables = memnew(GDScriptBytecodeCacheTables);
+	}
+	return reverse_tables;
+}
+
+/* WRITER */
+
+struct GDScriptBytecodeCache::Writer {
+	LocalVector<uint8_t> data;
+	const GDScript *root = nullptr;
+	const GDScriptBytecodeCacheTables *tables = nullptr;
+	HashMap<const Object *, StringName> global_objects;
+	HashMap<int, StringName> global_indices;
+	HashSet<String> referenced_paths;
+	String error;
+
+	bool fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+		return false;
+	}
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		const uint32_t pos = data.size();
+		data.resize(pos + 4);
+		encode_uint32(p_value, &data[pos]);
+	}
+
+	void put_s32(int32_t p_value) {
+		put_u32((uint32_t)p_value);
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		const uint32_t pos = data.size();
+		data.resize(pos + utf8.length());
+		if (utf8.length() > 0) {
+			memcpy(&data[pos], utf8.get_data(), utf8.length());
+		}
+	}
+
+	void put_name(const StringName &p_name) {
+		put_string(p_name);
+	}
+
+	bool put_script(const Script *p_script) {
+		const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+		if (gdscript == nullptr) {
+			// Scripts from other languages are loaded like any other resource.
+			if (p_script->is_built_in()) {
+				return fail(vformat(R"(Built-in script "%s" can't be referenced from the cache.)", p_script->get_path()));
+			}
+			put_u8(TAG_RESOURCE);
+			put_string(p_script->get_path());
+			return true;
+		}
+
+		Vector<StringName> class_names;
+		const GDScript *root_script = gdscript;
+		while (root_script->_owner != nullptr) {
+			class_names.push_back(root_script->local_name);
+			root_script = root_script->_owner;
+		}
+		if (!root_script->path.is_resource_file()) {
+			return fail(vformat(R"(Built-in script "%s" can't be referenced from the cache.)", root_script->path));
+		}
+		if (root_script != root) {
+			referenced_paths.insert(root_script->path);
+		}
+
+		put_u8(TAG_SCRIPT);
+		put_string(root_script->path);
+		put_u32(class_names.size());
+		for (int i = class_names.size() - 1; i >= 0; i--) {
+			put_name(class_names[i]);
+		}
+		return true;
+	}
+
+	bool put_variant(const Variant &p_value, int p_depth = 0) {
+		if (p_depth > MAX_VARIANT_DEPTH) {
+			return fail("Constant is nested too deeply.");
+		}
+
+		switch (p_value.get_type()) {
+			case Variant::OBJECT: {
+				const Object *object = p_value.get_validated_object();
+				if (object == nullptr) {
+					put_u8(TAG_NULL_OBJECT);
+					return true;
+				}
+				if (const StringName *global = global_objects.getptr(object)) {
+					// Native classes and singletons.
+					put_u8(TAG_GLOBAL);
+					put_name(*global);
+					return true;
+				}
+				if (const Script *script = Object::cast_to<Script>(object)) {
+					return put_script(script);
+				}
+				const Resource *resource = Object::cast_to<Resource>(object);
+				if (resource != nullptr && !resource->is_built_in()) {
+					put_u8(TAG_RESOURCE);
+					put_string(resource->get_path());
+					return true;
+				}
+				return fail(vformat(R"(Constant of type "%s" can't be cached.)", object->get_class()));
+			}
+			case Variant::ARRAY: {
+				const Array array = p_value;
+				put_u8(TAG_ARRAY);
+				put_u32(array.get_typed_builtin());
+				put_name(array.get_typed_class_name());
+				if (!put_variant(array.get_typed_script(), p_depth + 1)) {
+					return false;
+				}
+				put_u8(array.is_read_only());
+				put_u32(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					if (!put_variant(array[i], p_depth + 1)) {
+						return false;
+					}
+				}
+				return true;
+			}
+			case Variant::DICTIONARY: {
+				const Dictionary dictionary = p_value;
+				put_u8(TAG_DICTIONARY);
+				put_u32(dictionary.get_typed_key_builtin());
+				put_name(dictionary.get_typed_key_class_name());
+				if (!put_variant(dictionary.get_typed_key_script(), p_depth + 1)) {
+					return false;
+				}
+				put_u32(dictionary.get_typed_value_builtin());
+				put_name(dictionary.get_typed_value_class_name());
+				if (!put_variant(dictionary.get_typed_value_script(), p_depth + 1)) {
+					return false;
+				}
+				put_u8(dictionary.is_read_only());
+				put_u32(dictionary.size());
+				for (const KeyValue<Variant, Variant> &kv : dictionary) {
+					if (!put_variant(kv.key, p_depth + 1) || !put_variant(kv.value, p_depth + 1)) {
+						return false;
+					}
+				}
+				return true;
+			}
+			case Variant::CALLABLE:
+			case Variant::SIGNAL:
+			case Variant::RID: {
+				return fail(vformat(R"(Constant of type "%s" can't be cached.)", Variant::get_type_name(p_value.get_type())));
+			}
+			default: {
+				int len = 0;
+				Error err = encode_variant(p_value, nullptr, len, false);
+				if (err != OK) {
+					return fail(vformat(R"(Constant of type "%s" can't be encoded.)", Variant::get_type_name(p_value.get_type())));
+				}
+				put_u8(TAG_VALUE);
+				put_u32(len);
+				const uint32_t pos = data.size();
+				data.resize(pos + len);
+				encode_variant(p_value, &data[pos], len, false);
+				return true;
+			}
+		}
+	}
+
+	bool put_data_type(const GDScriptDataType &p_type) {
+		put_u8(p_type.kind);
+		put_u32(p_type.builtin_type);
+		put_name(p_type.native_type);
+		if (p_type.script_type != nullptr) {
+			put_u8(p_type.script_type_ref.is_valid() ? 2 : 1);
+			if (!put_script(p_type.script_type)) {
+				return false;
+			}
+		} else {
+			put_u8(0);
+		}
+		put_u32(p_type.container_element_types.size());
+		for (const GDScriptDataType &element_type : p_type.container_element_types) {
+			if (!put_data_type(element_type)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void put_property_info(const PropertyInfo &p_info) {
+		put_u32(p_info.type);
+		put_string(p_info.name);
+		put_name(p_info.class_name);
+		put_u32(p_info.hint);
+		put_string(p_info.hint_string);
+		put_u32(p_info.usage);
+	}
+
+	bool put_method_info(const MethodInfo &p_info) {
+		put_string(p_info.name);
+		put_property_info(p_info.return_val);
+		put_u32(p_info.flags);
+		put_s32(p_info.id);
+		put_u32(p_info.arguments.size());
+		for (const PropertyInfo &argument : p_info.arguments) {
+			put_property_info(argument);
+		}
+		put_u32(p_info.default_arguments.size());
+		for (const Variant &default_argument : p_info.default_arguments) {
+			if (!put_variant(default_argument)) {
+				return false;
+			}
+		}
+		put_s32(p_info.return_val_metadata);
+		put_u32(p_info.arguments_metadata.size());
+		for (int metadata : p_info.arguments_metadata) {
+			put_s32(metadata);
+		}
+		return true;
+	}
+
+	bool put_member_info(const GDScript::MemberInfo &p_info) {
+		put_s32(p_info.index);
+		put_name(p_info.setter);
+		put_name(p_info.getter);
+		put_property_info(p_info.property_info);
+		return put_data_type(p_info.data_type);
+	}
+
+	bool put_function(const GDScriptFunction *p_function) {
+		put_name(p_function->name);
+		put_name(p_function->source);
+		put_u8(p_function->_static);
+		put_u32(p_function->argument_types.size());
+		for (const GDScriptDataType &argument_type : p_function->argument_types) {
+			if (!put_data_type(argument_type)) {
+				return false;
+			}
+		}
+		if (!put_data_type(p_function->return_type) || !put_method_info(p_function->method_info) || !put_variant(p_function->rpc_config)) {
+			return false;
+		}
+		put_s32(p_function->_initial_line);
+		put_s32(p_function->_argument_count);
+		put_s32(p_function->_vararg_index);
+		put_s32(p_function->_stack_size);
+		put_s32(p_function->_instruction_args_size);
+
+		put_u32(p_function->temporary_slots.size());
+		for (const Pair<int, Variant::Type> &slot : p_function->temporary_slots) {
+			put_s32(slot.first);
+			put_u32(slot.second);
+		}
+
+		put_u32(p_function->stack_debug.size());
+		for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+			put_s32(stack_debug.line);
+			put_s32(stack_debug.pos);
+			put_u8(stack_debug.added);
+			put_name(stack_debug.identifier);
+		}
+
+		put_u32(p_function->code.size());
+		for (int code : p_function->code) {
+			put_s32(code);
+		}
+		put_u32(p_function->default_arguments.size());
+		for (int default_argument : p_function->default_arguments) {
+			put_s32(default_argument);
+		}
+
+		put_u32(p_function->constants.size());
+		for (const Variant &constant : p_function->constants) {
+			if (!put_variant(constant)) {
+				return false;
+			}
+		}
+		put_u32(p_function->constant_map.size());
+		for (const KeyValue<StringName, Variant> &kv : p_function->constant_map) {
+			put_name(kv.key);
+			if (!put_variant(kv.value)) {
+				return false;
+			}
+		}
+		put_u32(p_function->global_names.size());
+		for (const StringName &global_name : p_function->global_names) {
+			put_name(global_name);
+		}
+
+		put_u32(p_function->operator_funcs.size());
+		for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+			const GDScriptBytecodeCacheTables::Operator *op = _lookup(tables->operators, evaluator);
+			if (op == nullptr) {
+				return fail("Unknown validated operator.");
+			}
+			put_u8(op->op);
+			put_u8(op->type_a);
+			put_u8(op->type_b);
+		}
+		put_u32(p_function->setters.size());
+		for (Variant::ValidatedSetter setter : p_function->setters) {
+			const GDScriptBytecodeCacheTables::Member *member = _lookup(tables->setters, setter);
+			if (member == nullptr) {
+				return fail("Unknown validated setter.");
+			}
+			put_u32(member->type);
+			put_name(member->name);
+		}
+		put_u32(p_function->getters.size());
+		for (Variant::ValidatedGetter getter : p_function->getters) {
+			const GDScriptBytecodeCacheTables::Member *member = _lookup(tables->getters, getter);
+			if (member == nullptr) {
+				return fail("Unknown validated getter.");
+			}
+			put_u32(member->type);
+			put_name(member->name);
+		}
+		if (!put_types(p_function->keyed_setters, tables->keyed_setters) ||
+				!put_types(p_function->keyed_getters, tables->keyed_getters) ||
+				!put_types(p_function->indexed_setters, tables->indexed_setters) ||
+				!put_types(p_function->indexed_getters, tables->indexed_getters)) {
+			return fail("Unknown validated keyed or indexed accessor.");
+		}
+		put_u32(p_function->builtin_methods.size());
+		for (Variant::ValidatedBuiltInMethod builtin_method : p_function->builtin_methods) {
+			const GDScriptBytecodeCacheTables::Member *member = _lookup(tables->builtin_methods, builtin_method);
+			if (member == nullptr) {
+				return fail("Unknown validated built-in method.");
+			}
+			put_u32(member->type);
+			put_name(member->name);
+		}
+		put_u32(p_function->constructors.size());
+		for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+			const GDScriptBytecodeCacheTables::Constructor *entry = _lookup(tables->constructors, constructor);
+			if (entry == nullptr) {
+				return fail("Unknown validated constructor.");
+			}
+			put_u32(entry->type);
+			put_s32(entry->index);
+		}
+		put_u32(p_function->utilities.size());
+		for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+			const StringName *name = _lookup(tables->utilities, utility);
+			if (name == nullptr) {
+				return fail("Unknown utility function.");
+			}
+			put_name(*name);
+		}
+		put_u32(p_function->gds_utilities.size());
+		for (GDScriptUtilityFunctions::FunctionPtr gds_utility : p_function->gds_utilities) {
+			const StringName *name = _lookup(tables->gds_utilities, gds_utility);
+			if (name == nullptr) {
+				return fail("Unknown GDScript utility function.");
+			}
+			put_name(*name);
+		}
+		put_u32(p_function->methods.size());
+		for (const MethodBind *method : p_function->methods) {
+			put_name(method->get_instance_class());
+			put_name(method->get_name());
+			put_u32(method->get_hash());
+		}
+
+		put_u32(p_function->global_index_positions.size());
+		for (int position : p_function->global_index_positions) {
+			const StringName *global = global_indices.getptr(p_function->code[position]);
+			if (global == nullptr) {
+				return fail("Unknown global.");
+			}
+			put_s32(position);
+			put_name(*global);
+		}
+
+		put_u32(p_function->lambdas.size());
+		for (const GDScriptFunction *lambda : p_function->lambdas) {
+			const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+			put_s32(info ? info->capture_count : 0);
+			put_u8(info ? info->use_self : false);
+			if (!put_function(lambda)) {
+				return false;
+			}
+		}
+
+#ifdef DEBUG_ENABLED
+		put_name(p_function->profile.signature);
+#else
+		put_name(StringName());
+#endif
+		return true;
+	}
+
+	template <typename T>
+	bool put_types(const Vector<T> &p_functions, const RBMap<T, Variant::Type> &p_table) {
+		put_u32(p_functions.size());
+		for (T function : p_functions) {
+			const Variant::Type *type = _lookup(p_table, function);
+			if (type == nullptr) {
+				return false;
+			}
+			put_u32(*type);
+		}
+		return true;
+	}
+
+	void put_skeleton(const GDScript *p_script) {
+		put_string(p_script->fully_qualified_name);
+		put_name(p_script->local_name);
+		put_name(p_script->global_name);
+		put_string(p_script->simplified_icon_path);
+		put_u32(p_script->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &kv : p_script->subclasses) {
+			put_name(kv.key);
+			put_skeleton(kv.value.ptr());
+		}
+	}
+
+	bool put_optional_function(const GDScriptFunction *p_function) {
+		put_u8(p_function != nullptr);
+		return p_function == nullptr || put_function(p_function);
+	}
+
+	bool put_class(const GDScript *p_script) {
+		put_u8(p_script->tool);
+		put_u8(p_script->_is_abstract);
+		put_name(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+		put_u8(p_script->base.is_valid());
+		if (p_script->base.is_valid() && !put_script(p_script->base.ptr())) {
+			return false;
+		}
+
+		put_u32(p_script->member_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &kv : p_script->member_indices) {
+			put_name(kv.key);
+			if (!put_member_info(kv.value)) {
+				return false;
+			}
+		}
+		put_u32(p_script->members.size());
+		for (const StringName &member : p_script->members) {
+			put_name(member);
+		}
+		put_u32(p_script->static_variables_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &kv : p_script->static_variables_indices) {
+			put_name(kv.key);
+			if (!put_member_info(kv.value)) {
+				return false;
+			}
+		}
+		put_u32(p_script->constants.size());
+		for (const KeyValue<StringName, Variant> &kv : p_script->constants) {
+			put_name(kv.key);
+			if (!put_variant(kv.value)) {
+				return false;
+			}
+		}
+		put_u32(p_script->_signals.size());
+		for (const KeyValue<StringName, MethodInfo> &kv : p_script->_signals) {
+			put_name(kv.key);
+			if (!put_method_info(kv.value)) {
+				return false;
+			}
+		}
+		if (!put_variant(p_script->rpc_config)) {
+			return false;
+		}
+
+		put_u32(p_script->member_functions.size());
+		for (const KeyValue<StringName, GDScriptFunction *> &kv : p_script->member_functions) {
+			if (!put_function(kv.value)) {
+				return false;
+			}
+		}
+		if (!put_optional_function(p_script->implicit_initializer) ||
+				!put_optional_function(p_script->implicit_ready) ||
+				!put_optional_function(p_script->static_initializer)) {
+			return false;
+		}
+
+		put_u32(p_script->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &kv : p_script->subclasses) {
+			put_name(kv.key);
+			if (!put_class(kv.value.ptr())) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+/* READER */
+
+struct GDScriptBytecodeCache::ClassData {
+	GDScript *script = nullptr;
+	bool tool = false;
+	bool is_abstract = false;
+	Ref<GDScriptNativeClass> native;
+	Ref<GDScript> base;
+	HashMap<StringName, GDScript::MemberInfo> member_indices;
+	HashSet<StringName> members;
+	HashMap<StringName, GDScript::MemberInfo> static_variables_indices;
+	HashMap<StringName, Variant> constants;
+	HashMap<StringName, MethodInfo> signals;
+	Dictionary rpc_config;
+	HashMap<StringName, GDScriptFunction *> member_functions;
+	GDScriptFunction *implicit_initializer = nullptr;
+	GDScriptFunction *implicit_ready = nullptr;
+	GDScriptFunction *static_initializer = nullptr;
+	HashMap<GDScriptFunction *, GDScript::LambdaInfo> lambda_info;
+
+	void free_functions() {
+		for (const KeyValue<StringName, GDScriptFunction *> &kv : member_functions) {
+			memdelete(kv.value);
+		}
+		member_functions.clear();
+		if (implicit_initializer) {
+			memdelete(implicit_initializer);
+		}
+		if (implicit_ready) {
+			memdelete(implicit_ready);
+		}
+		if (static_initializer) {
+			memdelete(static_initializer);
+		}
+		implicit_initializer = nullptr;
+		implicit_ready = nullptr;
+		static_initializer = nullptr;
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *ptr = nullptr;
+	uint64_t size = 0;
+	uint64_t pos = 0;
+	bool failed = false;
+	GDScript *root = nullptr;
+	String error;
+	// Members of the class whose functions are being read, bounding member addresses.
+	int member_count = 0;
+
+	// Validated calls read exactly this many arguments, or -1 for vararg functions.
+	struct ValidatedArgumentCounts {
+		LocalVector<int> builtin_methods;
+		LocalVector<int> constructors;
+		LocalVector<int> utilities;
+	};
+
+	Reader(const Vector<uint8_t> &p_buffer) :
+			ptr(p_buffer.ptr()), size(p_buffer.size()) {}
+
+	bool fail(const String &p_error) {
+		if (!failed) {
+			error = p_error;
+		}
+		failed = true;
+		return false;
+	}
+
+	bool can_read(uint64_t p_bytes) {
+		if (failed) {
+			return false;
+		}
+		if (pos + p_bytes > size) {
+			return fail("Unexpected end of data.");
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!can_read(1)) {
+			return 0;
+		}
+		return ptr[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (!can_read(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(ptr + pos);
+		pos += 4;
+		return value;
+	}
+
+	int32_t get_s32() {
+		return (int32_t)get_u32();
+	}
+
+	// Counts are checked against the remaining data so that corrupted entries can't request huge allocations.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		if (count > size - pos) {
+			fail("Invalid element count.");
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		uint32_t len = get_count();
+		if (len == 0 || failed) {
+			return String();
+		}
+		String string = String::utf8((const char *)ptr + pos, len);
+		pos += len;
+		return string;
+	}
+
+	StringName get_name() {
+		return StringName(get_string());
+	}
+
+	void skip_string() {
+		const uint32_t len = get_count();
+		pos += len;
+	}
+
+	Variant::Type get_type() {
+		uint32_t type = get_u32();
+		if (type >= Variant::VARIANT_MAX) {
+			fail("Invalid variant type.");
+			return Variant::NIL;
+		}
+		return (Variant::Type)type;
+	}
+
+	Ref<Script> get_script(uint8_t p_tag) {
+		if (p_tag == TAG_RESOURCE) {
+			const String path = get_string();
+			Ref<Script> script = ResourceLoader::load(path);
+			if (script.is_null()) {
+				fail(vformat(R"(Could not load script "%s".)", path));
+			}
+			return script;
+		}
+
+		const String path = get_string();
+		const uint32_t depth = get_count();
+		if (failed) {
+			return Ref<Script>();
+		}
+
+		Ref<GDScript> script;
+		if (path == root->path) {
+			script = Ref<GDScript>(root);
+		} else {
+			Error err = OK;
+			script = GDScriptCache::get_shallow_script(path, err, root->path);
+			if (script.is_null()) {
+				fail(vformat(R"(Could not load script "%s".)", path));
+				return Ref<Script>();
+			}
+		}
+		for (uint32_t i = 0; i < depth; i++) {
+			const StringName name = get_name();
+			HashMap<StringName, Ref<GDScript>>::Iterator E = script->subclasses.find(name);
+			if (!E) {
+				fail(vformat(R"(Could not find class "%s" in "%s".)", name, path));
+				return Ref<Script>();
+			}
+			script = E->value;
+		}
+		return script;
+	}
+
+	Variant get_variant(int p_depth = 0) {
+		if (p_depth > MAX_VARIANT_DEPTH) {
+			fail("Constant is nested too deeply.");
+			return Variant();
+		}
+
+		const uint8_t tag = get_u8();
+		switch (tag) {
+			case TAG_VALUE: {
+				const uint32_t len = get_count();
+				if (failed) {
+					return Variant();
+				}
+				Variant value;
+				int read = 0;
+				if (decode_variant(value, ptr + pos, len, &read, false) != OK || (uint32_t)read != len) {
+					fail("Invalid constant.");
+					return Variant();
+				}
+				pos += len;
+				return value;
+			}
+			case TAG_ARRAY: {
+				const Variant::Type typed_builtin = get_type();
+				const StringName typed_class_name = get_name();
+				const Variant typed_script = get_variant(p_depth + 1);
+				const bool read_only = get_u8();
+				const uint32_t count = get_count();
+				if (failed) {
+					return Variant();
+				}
+				Array array;
+				if (typed_builtin != Variant::NIL) {
+					array.set_typed(typed_builtin, typed_class_name, typed_script);
+				}
+				array.resize(count);
+				for (uint32_t i = 0; i < count && !failed; i++) {
+					array[i] = get_variant(p_depth + 1);
+				}
+				if (read_only) {
+					array.make_read_only();
+				}
+				return array;
+			}
+			case TAG_DICTIONARY: {
+				const Variant::Type key_builtin = get_type();
+				const StringName key_class_name = get_name();
+				const Variant key_script = get_variant(p_depth + 1);
+				const Variant::Type value_builtin = get_type();
+				const StringName value_class_name = get_name();
+				const Variant value_script = get_variant(p_depth + 1);
+				const bool read_only = get_u8();
+				const uint32_t count = get_count();
+				if (failed) {
+					return Variant();
+				}
+				Dictionary dictionary;
+				if (key_builtin != Variant::NIL || value_builtin != Variant::NIL) {
+					dictionary.set_typed(key_builtin, key_class_name, key_script, value_builtin, value_class_name, value_script);
+				}
+				for (uint32_t i = 0; i < count && !failed; i++) {
+					const Variant key = get_variant(p_depth + 1);
+					dictionary[key] = get_variant(p_depth + 1);
+				}
+				if (read_only) {
+					dictionary.make_read_only();
+				}
+				return dictionary;
+			}
+			case TAG_NULL_OBJECT: {
+				return Variant((Object *)nullptr);
+			}
+			case TAG_SCRIPT: {
+				return get_script(tag);
+			}
+			case TAG_GLOBAL: {
+				const StringName name = get_name();
+				const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+				if (index == nullptr) {
+					fail(vformat(R"(Unknown global "%s".)", name));
+					return Variant();
+				}
+				return GDScriptLanguage::get_singleton()->get_global_array()[*index];
+			}
+			case TAG_RESOURCE: {
+				const String path = get_string();
+				Ref<Resource> resource = ResourceLoader::load(path);
+				if (resource.is_null()) {
+					fail(vformat(R"(Could not load resource "%s".)", path));
+				}
+				return resource;
+			}
+			default: {
+				fail("Invalid constant tag.");
+				return Variant();
+			}
+		}
+	}
+
+	GDScriptDataType get_data_type() {
+		GDScriptDataType type;
+		const uint8_t kind = get_u8();
+		if (kind > GDScriptDataType::GDSCRIPT) {
+			fail("Invalid data type.");
+			return type;
+		}
+		type.kind = (GDScriptDataType::Kind)kind;
+		type.builtin_type = get_type();
+		type.native_type = get_name();
+		const uint8_t script_mode = get_u8();
+		if (script_mode != 0) {
+			const uint8_t tag = get_u8();
+			if (tag != TAG_SCRIPT && tag != TAG_RESOURCE) {
+				fail("Invalid script reference.");
+				return type;
+			}
+			Ref<Script> script = get_script(tag);
+			type.script_type = script.ptr();
+			// Like the compiler, only classes from the same file are referenced weakly.
+			const GDScript *gdscript = Object::cast_to<GDScript>(script.ptr());
+			if (script_mode == 2 || gdscript == nullptr || const_cast<GDScript *>(gdscript)->get_root_script() != root) {
+				type.script_type_ref = script;
+			}
+		}
+		const uint32_t count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			type.set_container_element_type(i, get_data_type());
+		}
+		return type;
+	}
+
+	PropertyInfo get_property_info() {
+		PropertyInfo info;
+		info.type = get_type();
+		info.name = get_string();
+		info.class_name = get_name();
+		info.hint = (PropertyHint)get_u32();
+		info.hint_string = get_string();
+		info.usage = get_u32();
+		return info;
+	}
+
+	MethodInfo get_method_info() {
+		MethodInfo info;
+		info.name = get_string();
+		info.return_val = get_property_info();
+		info.flags = get_u32();
+		info.id = get_s32();
+		uint32_t count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			info.arguments.push_back(get_property_info());
+		}
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			info.default_arguments.push_back(get_variant());
+		}
+		info.return_val_metadata = get_s32();
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			info.arguments_metadata.push_back(get_s32());
+		}
+		return info;
+	}
+
+	GDScript::MemberInfo get_member_info() {
+		GDScript::MemberInfo info;
+		info.index = get_s32();
+		info.setter = get_name();
+		info.getter = get_name();
+		info.property_info = get_property_info();
+		info.data_type = get_data_type();
+		return info;
+	}
+
+	template <typename T>
+	void get_types(Vector<T> &r_functions, T (*p_lookup)(Variant::Type)) {
+		const uint32_t count = get_count();
+		r_functions.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			r_functions.write[i] = p_lookup(get_type());
+			if (r_functions[i] == nullptr) {
+				fail("Unknown validated keyed or indexed accessor.");
+			}
+		}
+	}
+
+	// Returns `nullptr` on failure; partially read functions are freed.
+	GDScriptFunction *get_function(GDScript *p_script, HashMap<GDScriptFunction *, GDScript::LambdaInfo> &r_lambda_info) {
+		GDScriptFunction *function = memnew(GDScriptFunction);
+		function->_script = p_script;
+		if (!_read_function(function, p_script, r_lambda_info)) {
+			for (GDScriptFunction *lambda : function->lambdas) {
+				r_lambda_info.erase(lambda);
+			}
+			memdelete(function);
+			return nullptr;
+		}
+		return function;
+	}
+
+	bool _read_function(GDScriptFunction *p_function, GDScript *p_script, HashMap<GDScriptFunction *, GDScript::LambdaInfo> &r_lambda_info) {
+		p_function->name = get_name();
+		p_function->source = get_name();
+		p_function->_static = get_u8();
+
+		uint32_t count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			p_function->argument_types.push_back(get_data_type());
+		}
+		p_function->return_type = get_data_type();
+		p_function->method_info = get_method_info();
+		p_function->rpc_config = get_variant();
+		p_function->_initial_line = get_s32();
+		p_function->_argument_count = get_s32();
+		p_function->_vararg_index = get_s32();
+		p_function->_stack_size = get_s32();
+		p_function->_instruction_args_size = get_s32();
+
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const int slot = get_s32();
+			p_function->temporary_slots.push_back(Pair(slot, get_type()));
+		}
+
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			GDScriptFunction::StackDebug stack_debug;
+			stack_debug.line = get_s32();
+			stack_debug.pos = get_s32();
+			stack_debug.added = get_u8();
+			stack_debug.identifier = get_name();
+			p_function->stack_debug.push_back(stack_debug);
+		}
+
+		count = get_count();
+		p_function->code.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			p_function->code.write[i] = get_s32();
+		}
+		count = get_count();
+		p_function->default_arguments.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			p_function->default_arguments.write[i] = get_s32();
+		}
+
+		count = get_count();
+		p_function->constants.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			p_function->constants.write[i] = get_variant();
+		}
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName name = get_name();
+			p_function->constant_map.insert(name, get_variant());
+		}
+		count = get_count();
+		p_function->global_names.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			p_function->global_names.write[i] = get_name();
+		}
+
+		count = get_count();
+		p_function->operator_funcs.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const uint8_t op = get_u8();
+			const uint8_t type_a = get_u8();
+			const uint8_t type_b = get_u8();
+			if (op >= Variant::OP_MAX || type_a >= Variant::VARIANT_MAX || type_b >= Variant::VARIANT_MAX) {
+				return fail("Invalid operator.");
+			}
+			p_function->operator_funcs.write[i] = Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)type_a, (Variant::Type)type_b);
+			if (p_function->operator_funcs[i] == nullptr) {
+				return fail("Unknown validated operator.");
+			}
+		}
+		count = get_count();
+		p_function->setters.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const Variant::Type type = get_type();
+			const StringName name = get_name();
+			p_function->setters.write[i] = Variant::get_member_validated_setter(type, name);
+			if (p_function->setters[i] == nullptr) {
+				return fail(vformat(R"(Unknown setter "%s".)", name));
+			}
+		}
+		count = get_count();
+		p_function->getters.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const Variant::Type type = get_type();
+			const StringName name = get_name();
+			p_function->getters.write[i] = Variant::get_member_validated_getter(type, name);
+			if (p_function->getters[i] == nullptr) {
+				return fail(vformat(R"(Unknown getter "%s".)", name));
+			}
+		}
+		get_types(p_function->keyed_setters, &Variant::get_member_validated_keyed_setter);
+		get_types(p_function->keyed_getters, &Variant::get_member_validated_keyed_getter);
+		get_types(p_function->indexed_setters, &Variant::get_member_validated_indexed_setter);
+		get_types(p_function->indexed_getters, &Variant::get_member_validated_indexed_getter);
+
+		ValidatedArgumentCounts argument_counts;
+		count = get_count();
+		p_function->builtin_methods.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const Variant::Type type = get_type();
+			const StringName name = get_name();
+			p_function->builtin_methods.write[i] = Variant::get_validated_builtin_method(type, name);
+			if (p_function->builtin_methods[i] == nullptr) {
+				return fail(vformat(R"(Unknown built-in method "%s".)", name));
+			}
+			argument_counts.builtin_methods.push_back(Variant::is_builtin_method_vararg(type, name) ? -1 : Variant::get_builtin_method_argument_count(type, name));
+		}
+		count = get_count();
+		p_function->constructors.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const Variant::Type type = get_type();
+			const int index = get_s32();
+			if (index < 0 || index >= Variant::get_constructor_count(type)) {
+				return fail("Invalid constructor.");
+			}
+			p_function->constructors.write[i] = Variant::get_validated_constructor(type, index);
+			argument_counts.constructors.push_back(Variant::get_constructor_argument_count(type, index));
+		}
+		count = get_count();
+		p_function->utilities.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName name = get_name();
+			p_function->utilities.write[i] = Variant::get_validated_utility_function(name);
+			if (p_function->utilities[i] == nullptr) {
+				return fail(vformat(R"(Unknown utility function "%s".)", name));
+			}
+			argument_counts.utilities.push_back(Variant::is_utility_function_vararg(name) ? -1 : Variant::get_utility_function_argument_count(name));
+		}
+		count = get_count();
+		p_function->gds_utilities.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName name = get_name();
+			p_function->gds_utilities.write[i] = GDScriptUtilityFunctions::get_function(name);
+			if (p_function->gds_utilities[i] == nullptr) {
+				return fail(vformat(R"(Unknown GDScript utility function "%s".)", name));
+			}
+		}
+		count = get_count();
+		p_function->methods.resize(count);
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName class_name = get_name();
+			const StringName name = get_name();
+			const uint32_t hash = get_u32();
+			const MethodBind *method = ClassDB::get_method(class_name, name);
+			// Validated calls were chosen for this exact signature.
+			if (method == nullptr || method->get_hash() != hash) {
+				return fail(vformat(R"(Method "%s.%s" is missing or changed.)", class_name, name));
+			}
+			p_function->methods.write[i] = method;
+		}
+
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const int position = get_s32();
+			const StringName name = get_name();
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+			if (position < 0 || position >= p_function->code.size() || index == nullptr) {
+				return fail(vformat(R"(Unknown global "%s".)", name));
+			}
+			p_function->code.write[position] = *index;
+			p_function->global_index_positions.push_back(position);
+		}
+
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			GDScript::LambdaInfo info;
+			info.capture_count = get_s32();
+			info.use_self = get_u8();
+			GDScriptFunction *lambda = get_function(p_script, r_lambda_info);
+			if (lambda == nullptr) {
+				return false;
+			}
+			p_function->lambdas.push_back(lambda);
+			r_lambda_info.insert(lambda, info);
+		}
+
+#ifdef DEBUG_ENABLED
+		p_function->profile.signature = get_name();
+#else
+		skip_string();
+#endif
+		if (failed || !_validate_code(p_function, argument_counts)) {
+			return false;
+		}
+
+#ifdef DEBUG_ENABLED
+		p_function->func_cname = (String(p_function->source) + " - " + String(p_function->name)).utf8();
+		p_function->_func_cname = p_function->func_cname.get_data();
+		_fill_debug_names(p_function);
+#endif
+		_finalize(p_function);
+		return true;
+	}
+
+	// The VM trusts the operands it decodes, so cached code is checked against the function's own sizes
+	// before it can run. Instruction layouts follow `GDScriptFunction::call()`.
+	bool _validate_code(GDScriptFunction *p_function, const ValidatedArgumentCounts &p_argument_counts) {
+		const int stack_size = p_function->_stack_size;
+		const int argument_count = p_function->_argument_count;
+		const int vararg_index = p_function->_vararg_index;
+		if (stack_size < GDScriptFunction::FIXED_ADDRESSES_MAX || argument_count < 0 || argument_count > p_function->argument_types.size() ||
+				argument_count > stack_size - GDScriptFunction::FIXED_ADDRESSES_MAX || p_function->_instruction_args_size < 0 ||
+				p_function->default_arguments.size() > argument_count + 1 ||
+				(vararg_index != -1 && (vararg_index < GDScriptFunction::FIXED_ADDRESSES_MAX || vararg_index >= stack_size))) {
+			return fail("Invalid function frame.");
+		}
+		for (const Pair<int, Variant::Type> &slot : p_function->temporary_slots) {
+			if (slot.first < GDScriptFunction::FIXED_ADDRESSES_MAX || slot.first >= stack_size) {
+				return fail("Invalid temporary slot.");
+			}
+		}
+
+		const int code_size = p_function->code.size();
+		int *code = p_function->code.ptrw();
+		const int address_limits[GDScriptFunction::ADDR_TYPE_MAX] = { stack_size, (int)p_function->constants.size(), member_count };
+		LocalVector<bool> starts;
+		starts.resize(code_size);
+		LocalVector<int> jumps;
+
+		int ip = 0;
+		int length = 0;
+		int args = 0;
+		int argc = 0;
+
+		// Offsets are relative to `ip`, like `_code_ptr[ip + offset]` in the VM.
+		auto fits = [&](int p_length) {
+			length = p_length;
+			return p_length <= code_size - ip;
+		};
+		auto index = [&](int p_offset, int p_count) {
+			return code[ip + p_offset] >= 0 && code[ip + p_offset] < p_count;
+		};
+		auto type = [&](int p_offset) {
+			return index(p_offset, Variant::VARIANT_MAX);
+		};
+		auto name = [&](int p_offset) {
+			return index(p_offset, p_function->global_names.size());
+		};
+		auto address = [&](int p_offset) {
+			const int address_type = (code[ip + p_offset] & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+			return address_type >= 0 && address_type < GDScriptFunction::ADDR_TYPE_MAX && (code[ip + p_offset] & GDScriptFunction::ADDR_MASK) < address_limits[address_type];
+		};
+		auto addresses = [&](int p_from, int p_to) {
+			for (int i = p_from; i <= p_to; i++) {
+				if (!address(i)) {
+					return false;
+				}
+			}
+			return true;
+		};
+		auto jump = [&](int p_offset) {
+			jumps.push_back(code[ip + p_offset]);
+			return true;
+		};
+		// Variable-length instructions hold the opcode, the argument count, the arguments and `p_tail` more words.
+		auto arguments = [&](int p_tail) {
+			if (!fits(2)) {
+				return false;
+			}
+			args = code[ip + 1];
+			return args >= 0 && args <= p_function->_instruction_args_size && fits(2 + args + p_tail) && addresses(2, 1 + args);
+		};
+		// Offset of a word after the arguments, like `_code_ptr[ip + p_offset]` once the VM skipped them.
+		auto tail = [&](int p_offset) {
+			return 1 + args + p_offset;
+		};
+		// The arguments hold `p_per_argument` addresses per call argument and `p_extra` more.
+		auto call_arguments = [&](int p_offset, int p_extra, int p_per_argument = 1) {
+			argc = code[ip + tail(p_offset)];
+			return argc >= 0 && int64_t(argc) * p_per_argument + p_extra <= args;
+		};
+		auto method = [&](int p_offset, bool p_validated) {
+			if (!index(p_offset, p_function->methods.size())) {
+				return false;
+			}
+			const MethodBind *method_bind = p_function->methods[code[ip + p_offset]];
+			return !p_validated || (!method_bind->is_vararg() && method_bind->get_argument_count() == argc);
+		};
+		auto validated = [&](int p_offset, const LocalVector<int> &p_counts) {
+			return index(p_offset, p_counts.size()) && p_counts[code[ip + p_offset]] == argc;
+		};
+
+		int opcode = -1;
+		while (ip < code_size) {
+			starts[ip] = true;
+			opcode = code[ip];
+			bool valid = false;
+			switch (opcode) {
+				case GDScriptFunction::OPCODE_OPERATOR: {
+					constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*code);
+					valid = fits(7 + pointer_size) && addresses(1, 3) && index(4, Variant::OP_MAX);
+					if (valid) {
+						// The signature, return type and evaluator are filled in by the first run, never trust them.
+						for (int i = 5; i < length; i++) {
+							code[ip + i] = 0;
+						}
+					}
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+				case GDScriptFunction::OPCODE_OPERATOR_ADD_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_LESS_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_GREATER_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT:
+				case GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT:
+				case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT:
+				case GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT:
+				case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT:
+				case GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT:
+				case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+				case GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT:
+				case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT: {
+					valid = fits(5) && addresses(1, 3) && index(4, p_function->operator_funcs.size());
+				} break;
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_INT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_INT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_FLOAT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_NOT_EQUAL_FLOAT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_FLOAT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_FLOAT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT: {
+					valid = fits(6) && addresses(1, 3) && index(4, p_function->operator_funcs.size()) && jump(5);
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3:
+				case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3_FLOAT: {
+					valid = fits(8) && addresses(1, 3) && addresses(5, 6) && index(4, p_function->operator_funcs.size()) && index(7, p_function->operator_funcs.size());
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+				case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+					valid = fits(4) && addresses(1, 2) && type(3);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+					valid = fits(6) && addresses(1, 3) && type(4) && name(5);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_DICTIONARY:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+					valid = fits(9) && addresses(1, 4) && type(5) && name(6) && type(7) && name(8);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE:
+				case GDScriptFunction::OPCODE_SET_NAMED:
+				case GDScriptFunction::OPCODE_GET_NAMED: {
+					valid = fits(4) && addresses(1, 2) && name(3);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+				case GDScriptFunction::OPCODE_SET_KEYED:
+				case GDScriptFunction::OPCODE_GET_KEYED:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+				case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+				case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+					valid = fits(4) && addresses(1, 3);
+				} break;
+				case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+					valid = fits(5) && addresses(1, 3) && index(4, p_function->keyed_setters.size());
+				} break;
+				case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+					valid = fits(5) && addresses(1, 3) && index(4, p_function->indexed_setters.size());
+				} break;
+				case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+					valid = fits(5) && addresses(1, 3) && index(4, p_function->keyed_getters.size());
+				} break;
+				case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+					valid = fits(5) && addresses(1, 3) && index(4, p_function->indexed_getters.size());
+				} break;
+				case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+					valid = fits(4) && addresses(1, 2) && index(3, p_function->setters.size());
+				} break;
+				case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+					valid = fits(4) && addresses(1, 2) && index(3, p_function->getters.size());
+				} break;
+				case GDScriptFunction::OPCODE_SET_MEMBER:
+				case GDScriptFunction::OPCODE_GET_MEMBER:
+				case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL: {
+					valid = fits(3) && address(1) && name(2);
+				} break;
+				case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+				case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE: {
+					// The variable count belongs to the script in the second operand, it is checked when running.
+					valid = fits(4) && addresses(1, 2) && code[ip + 3] >= 0;
+				} break;
+				case GDScriptFunction::OPCODE_ASSIGN:
+				case GDScriptFunction::OPCODE_ASSERT: {
+					valid = fits(3) && addresses(1, 2);
+				} break;
+				case GDScriptFunction::OPCODE_ASSIGN_NULL:
+				case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+				case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+				case GDScriptFunction::OPCODE_AWAIT_RESUME:
+				case GDScriptFunction::OPCODE_RETURN: {
+					valid = fits(2) && address(1);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT: {
+					valid = arguments(2) && call_arguments(1, 1) && type(tail(2));
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+					valid = arguments(2) && call_arguments(1, 1) && validated(tail(2), p_argument_counts.constructors);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+					valid = arguments(1) && call_arguments(1, 1);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+					valid = arguments(3) && call_arguments(1, 2) && type(tail(2)) && name(tail(3));
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+					valid = arguments(1) && call_arguments(1, 1, 2);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+					valid = arguments(5) && call_arguments(1, 3, 2) && type(tail(2)) && name(tail(3)) && type(tail(4)) && name(tail(5));
+				} break;
+				case GDScriptFunction::OPCODE_CALL:
+				case GDScriptFunction::OPCODE_CALL_UTILITY:
+				case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+					valid = arguments(2) && call_arguments(1, 1) && name(tail(2));
+				} break;
+				case GDScriptFunction::OPCODE_CALL_RETURN:
+				case GDScriptFunction::OPCODE_CALL_ASYNC: {
+					valid = arguments(2) && call_arguments(1, 2) && name(tail(2));
+				} break;
+				case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+					valid = arguments(2) && call_arguments(1, 1) && validated(tail(2), p_argument_counts.utilities);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY: {
+					valid = arguments(2) && call_arguments(1, 1) && index(tail(2), p_function->gds_utilities.size());
+				} break;
+				case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+					valid = arguments(2) && call_arguments(1, 2) && validated(tail(2), p_argument_counts.builtin_methods);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND: {
+					valid = arguments(2) && call_arguments(1, 1) && method(tail(2), false);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET: {
+					valid = arguments(2) && call_arguments(1, 2) && method(tail(2), false);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC: {
+					valid = arguments(3) && type(tail(1)) && name(tail(2)) && call_arguments(3, 1);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC: {
+					valid = arguments(2) && call_arguments(2, 1) && method(tail(1), false);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+					valid = arguments(2) && call_arguments(1, 1) && method(tail(2), true);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+					valid = arguments(2) && call_arguments(1, 2) && method(tail(2), true);
+				} break;
+				case GDScriptFunction::OPCODE_AWAIT: {
+					// Not awaiting reads the target of the `OPCODE_AWAIT_RESUME` that always follows.
+					valid = fits(2) && address(1) && ip + 2 < code_size && code[ip + 2] == GDScriptFunction::OPCODE_AWAIT_RESUME;
+				} break;
+				case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+				case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA: {
+					valid = arguments(2) && call_arguments(1, 1) && index(tail(2), p_function->lambdas.size());
+				} break;
+				case GDScriptFunction::OPCODE_JUMP: {
+					valid = fits(2) && jump(1);
+				} break;
+				case GDScriptFunction::OPCODE_JUMP_IF:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+				case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+					valid = fits(3) && address(1) && jump(2);
+				} break;
+				case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+				case GDScriptFunction::OPCODE_BREAKPOINT:
+				case GDScriptFunction::OPCODE_END: {
+					valid = fits(1);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+					valid = fits(3) && address(1) && type(2);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY: {
+					valid = fits(5) && addresses(1, 2) && type(3) && name(4);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY: {
+					valid = fits(8) && addresses(1, 3) && type(4) && name(5) && type(6) && name(7);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+				case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT: {
+					valid = fits(3) && addresses(1, 2);
+				} break;
+				case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+					valid = fits(7) && addresses(1, 5) && jump(6);
+				} break;
+				case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+					valid = fits(6) && addresses(1, 4) && jump(5);
+				} break;
+				case GDScriptFunction::OPCODE_STORE_GLOBAL: {
+					valid = fits(3) && address(1) && index(2, GDScriptLanguage::get_singleton()->get_global_array_size());
+				} break;
+				case GDScriptFunction::OPCODE_LINE: {
+					valid = fits(2);
+				} break;
+				default: {
+					if ((opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && opcode <= GDScriptFunction::OPCODE_ITERATE_BEGIN_OBJECT) ||
+							(opcode >= GDScriptFunction::OPCODE_ITERATE && opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT)) {
+						valid = fits(5) && addresses(1, 3) && jump(4);
+					} else if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+						valid = fits(2) && address(1);
+					}
+				} break;
+			}
+			if (!valid) {
+				return fail(vformat(R"(Invalid instruction at %d in function "%s".)", ip, p_function->name));
+			}
+			ip += length;
+		}
+
+		// The VM only stops at returns and the final `OPCODE_END`.
+		if (opcode != GDScriptFunction::OPCODE_END) {
+			return fail(vformat(R"(Function "%s" doesn't end with OPCODE_END.)", p_function->name));
+		}
+		for (int default_argument : p_function->default_arguments) {
+			jumps.push_back(default_argument);
+		}
+		for (int to : jumps) {
+			if (to < 0 || to >= code_size || !starts[to]) {
+				return fail(vformat(R"(Invalid jump target %d in function "%s".)", to, p_function->name));
+			}
+		}
+		for (int position : p_function->global_index_positions) {
+			if (position < 2 || !starts[position - 2] || code[position - 2] != GDScriptFunction::OPCODE_STORE_GLOBAL) {
+				return fail(vformat(R"(Invalid global index position in function "%s".)", p_function->name));
+			}
+		}
+		return true;
+	}
+
+#ifdef DEBUG_ENABLED
+	void _fill_debug_names(GDScriptFunction *p_function) {
+		const GDScriptBytecodeCacheTables *tables = _get_reverse_tables();
+		for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+			const GDScriptBytecodeCacheTables::Operator *op = _lookup(tables->operators, evaluator);
+			p_function->operator_names.push_back(op ? Variant::get_operator_name(op->op) : String());
+		}
+		for (Variant::ValidatedSetter setter : p_function->setters) {
+			const GDScriptBytecodeCacheTables::Member *member = _lookup(tables->setters, setter);
+			p_function->setter_names.push_back(member ? String(member->name) : String());
+		}
+		for (Variant::ValidatedGetter getter : p_function->getters) {
+			const GDScriptBytecodeCacheTables::Member *member = _lookup(tables->getters, getter);
+			p_function->getter_names.push_back(member ? String(member->name) : String());
+		}
+		for (Variant::ValidatedBuiltInMethod builtin_method : p_function->builtin_methods) {
+			const GDScriptBytecodeCacheTables::Member *member = _lookup(tables->builtin_methods, builtin_method);
+			p_function->builtin_methods_names.push_back(member ? String(member->name) : String());
+		}
+		for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+			const GDScriptBytecodeCacheTables::Constructor *entry = _lookup(tables->constructors, constructor);
+			p_function->constructors_names.push_back(entry ? Variant::get_type_name(entry->type) : String());
+		}
+		for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+			const StringName *name = _lookup(tables->utilities, utility);
+			p_function->utilities_names.push_back(name ? String(*name) : String());
+		}
+		for (GDScriptUtilityFunctions::FunctionPtr gds_utility : p_function->gds_utilities) {
+			const StringName *name = _lookup(tables->gds_utilities, gds_utility);
+			p_function->gds_utilities_names.push_back(name ? String(*name) : String());
+		}
+	}
+#endif
+
+	// Sets up the raw pointers the VM reads, like `GDScriptByteCodeGenerator::write_end()`.
+	static void _finalize(GDScriptFunction *p_function) {
+		p_function->_code_size = p_function->code.size();
+		p_function->_code_ptr = p_function->code.is_empty() ? nullptr : p_function->code.ptrw();
+		p_function->_default_arg_count = p_function->default_arguments.is_empty() ? 0 : p_function->default_arguments.size() - 1;
+		p_function->_default_arg_ptr = p_function->default_arguments.is_empty() ? nullptr : p_function->default_arguments.ptr();
+		p_function->_constant_count = p_function->constants.size();
+		p_function->_constants_ptr = p_function->constants.is_empty() ? nullptr : p_function->constants.ptrw();
+		p_function->_global_names_count = p_function->global_names.size();
+		p_function->_global_names_ptr = p_function->global_names.is_empty() ? nullptr : p_function->global_names.ptr();
+		p_function->_operator_funcs_count = p_function->operator_funcs.size();
+		p_function->_operator_funcs_ptr = p_function->operator_funcs.is_empty() ? nullptr : p_function->operator_funcs.ptr();
+		p_function->_setters_count = p_function->setters.size();
+		p_function->_setters_ptr = p_function->setters.is_empty() ? nullptr : p_function->setters.ptr();
+		p_function->_getters_count = p_function->getters.size();
+		p_function->_getters_ptr = p_function->getters.is_empty() ? nullptr : p_function->getters.ptr();
+		p_function->_keyed_setters_count = p_function->keyed_setters.size();
+		p_function->_keyed_setters_ptr = p_function->keyed_setters.is_empty() ? nullptr : p_function->keyed_setters.ptr();
+		p_function->_keyed_getters_count = p_function->keyed_getters.size();
+		p_function->_keyed_getters_ptr = p_function->keyed_getters.is_empty() ? nullptr : p_function->keyed_getters.ptr();
+		p_function->_indexed_setters_count = p_function->indexed_setters.size();
+		p_function->_indexed_setters_ptr = p_function->indexed_setters.is_empty() ? nullptr : p_function->indexed_setters.ptr();
+		p_function->_indexed_getters_count = p_function->indexed_getters.size();
+		p_function->_indexed_getters_ptr = p_function->indexed_getters.is_empty() ? nullptr : p_function->indexed_getters.ptr();
+		p_function->_builtin_methods_count = p_function->builtin_methods.size();
+		p_function->_builtin_methods_ptr = p_function->builtin_methods.is_empty() ? nullptr : p_function->builtin_methods.ptr();
+		p_function->_constructors_count = p_function->constructors.size();
+		p_function->_constructors_ptr = p_function->constructors.is_empty() ? nullptr : p_function->constructors.ptr();
+		p_function->_utilities_count = p_function->utilities.size();
+		p_function->_utilities_ptr = p_function->utilities.is_empty() ? nullptr : p_function->utilities.ptr();
+		p_function->_gds_utilities_count = p_function->gds_utilities.size();
+		p_function->_gds_utilities_ptr = p_function->gds_utilities.is_empty() ? nullptr : p_function->gds_utilities.ptr();
+		p_function->_methods_count = p_function->methods.size();
+		p_function->_methods_ptr = p_function->methods.is_empty() ? nullptr : p_function->methods.ptrw();
+		p_function->_lambdas_count = p_function->lambdas.size();
+		p_function->_lambdas_ptr = p_function->lambdas.is_empty() ? nullptr : p_function->lambdas.ptrw();
+	}
+
+	bool get_optional_function(ClassData &r_class, GDScriptFunction *&r_function) {
+		if (!get_u8()) {
+			return !failed;
+		}
+		r_function = get_function(r_class.script, r_class.lambda_info);
+		return r_function != nullptr;
+	}
+
+	// Classes are appended after their inner classes.
+	bool get_class(GDScript *p_script, LocalVector<ClassData> &r_classes) {
+		ClassData data;
+		data.script = p_script;
+		data.tool = get_u8();
+		data.is_abstract = get_u8();
+
+		const StringName native_name = get_name();
+		const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_name);
+		if (native_index != nullptr) {
+			data.native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+		}
+		if (data.native.is_null()) {
+			return fail(vformat(R"(Unknown native class "%s".)", native_name));
+		}
+		if (get_u8()) {
+			const uint8_t tag = get_u8();
+			data.base = tag == TAG_SCRIPT ? Ref<GDScript>(get_script(tag)) : Ref<GDScript>();
+			if (data.base.is_null()) {
+				return fail("Invalid base class.");
+			}
+		}
+
+		uint32_t count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName name = get_name();
+			data.member_indices.insert(name, get_member_info());
+		}
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			data.members.insert(get_name());
+		}
+		// Instances hold one slot per member, inherited ones included.
+		member_count = data.member_indices.size();
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName name = get_name();
+			data.static_variables_indices.insert(name, get_member_info());
+		}
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName name = get_name();
+			data.constants.insert(name, get_variant());
+		}
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName name = get_name();
+			data.signals.insert(name, get_method_info());
+		}
+		data.rpc_config = get_variant();
+		if (failed) {
+			return false;
+		}
+
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			GDScriptFunction *function = get_function(p_script, data.lambda_info);
+			if (function == nullptr) {
+				data.free_functions();
+				return false;
+			}
+			data.member_functions.insert(function->name, function);
+		}
+		if (failed ||
+				!get_optional_function(data, data.implicit_initializer) ||
+				!get_optional_function(data, data.implicit_ready) ||
+				!get_optional_function(data, data.static_initializer)) {
+			data.free_functions();
+			return false;
+		}
+
+		count = get_count();
+		for (uint32_t i = 0; i < count && !failed; i++) {
+			const StringName name = get_name();
+			HashMap<StringName, Ref<GDScript>>::Iterator E = p_script->subclasses.find(name);
+			if (!E) {
+				fail(vformat(R"(Inner class "%s" is missing.)", name));
+				break;
+			}
+			if (!get_class(E->value.ptr(), r_classes)) {
+				break;
+			}
+		}
+		if (failed) {
+			data.free_functions();
+			return false;
+		}
+
+		r_classes.push_back(data);
+		return true;
+	}
+};
+
+/* CACHE */
+
+bool GDScriptBytecodeCache::is_enabled() {
+	if (Engine::get_singleton()->is_editor_hint() || Engine::get_singleton()->is_project_manager_hint()) {
+		return false;
+	}
+	return GLOBAL_GET_CACHED(bool, "application/run/gdscript_bytecode_cache");
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	return "user://gdscript_cache/" + p_script_path.md5_text() + ".gdbc";
+}
+
+String GDScriptBytecodeCache::get_source_digest(const String &p_source_code) {
+	return p_source_code.sha256_text();
+}
+
+String GDScriptBytecodeCache::get_source_digest(const Vector<uint8_t> &p_binary_tokens) {
+	unsigned char digest[32];
+	CryptoCore::sha256(p_binary_tokens.ptr(), p_binary_tokens.size(), digest);
+	return String::hex_encode_buffer(digest, 32);
+}
+
+String GDScriptBytecodeCache::get_source_digest(const GDScript *p_script) {
+	const Vector<uint8_t> &binary_tokens = p_script->get_binary_tokens_source();
+	if (!binary_tokens.is_empty()) {
+		return get_source_digest(binary_tokens);
+	}
+	return get_source_digest(p_script->get_source_code());
+}
+
+uint32_t GDScriptBytecodeCache::_compute_build_hash() {
+	uint32_t hash = hash_murmur3_one_32(FORMAT_VERSION);
+	hash = hash_murmur3_one_32(String(GODOT_VERSION_FULL_BUILD).hash(), hash);
+	hash = hash_murmur3_one_32(String(GODOT_VERSION_HASH).hash(), hash);
+#ifdef DEBUG_ENABLED
+	// Debug builds emit assertions and breakpoints.
+	hash = hash_murmur3_one_32(1, hash);
+#endif
+#ifdef TOOLS_ENABLED
+	hash = hash_murmur3_one_32(2, hash);
+#endif
+	// Local variable debug info is only kept when tracked.
+	hash = hash_murmur3_one_32(GDScriptLanguage::get_singleton()->should_track_locals(), hash);
+	hash = hash_murmur3_one_32(sizeof(void *), hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::FIXED_ADDRESSES_MAX, hash);
+
+	// Autoload singletons are looked up at runtime, other globals are inlined.
+	LocalVector<StringName> autoloads;
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &kv : ProjectSettings::get_singleton()->get_autoload_list()) {
+		if (kv.value.is_singleton) {
+			autoloads.push_back(kv.key);
+		}
+	}
+	autoloads.sort_custom<StringName::AlphCompare>();
+	for (const StringName &autoload : autoloads) {
+		hash = hash_murmur3_one_32(autoload.hash(), hash);
+	}
+
+	// Constants and enums of extension classes are inlined too.
+	for (const String &extension : GDExtensionManager::get_singleton()->get_loaded_extensions()) {
+		hash = hash_murmur3_one_32(extension.hash(), hash);
+	}
+	return hash;
+}
+
+uint32_t GDScriptBytecodeCache::_get_build_hash() {
+	// Autoloads and extensions are set up before any script is loaded, so this only needs to be computed once per run.
+	MutexLock lock(digests_mutex);
+	if (!build_hash_computed) {
+		build_hash = _compute_build_hash();
+		build_hash_computed = true;
+	}
+	return build_hash;
+}
+
+String GDScriptBytecodeCache::_get_dependency_digest(const String &p_path) {
+	{
+		MutexLock lock(digests_mutex);
+		if (const String *digest = source_digests.getptr(p_path)) {
+			return *digest;
+		}
+	}
+
+	String digest;
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (FileAccess::exists(remapped_path)) {
+		if (remapped_path.has_extension("gdc")) {
+			digest = get_source_digest(GDScriptCache::get_binary_tokens(remapped_path));
+		} else {
+			digest = get_source_digest(GDScriptCache::get_source_code(remapped_path));
+		}
+	}
+
+	MutexLock lock(digests_mutex);
+	source_digests.insert(p_path, digest);
+	return digest;
+}
+
+void GDScriptBytecodeCache::_collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_dependencies) {
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &kv : p_parser->get_depended_parsers()) {
+		if (r_dependencies.has(kv.key)) {
+			continue;
+		}
+		r_dependencies.insert(kv.key);
+		// Constants can be folded across several scripts, so dependencies are followed transitively.
+		if (kv.value.is_valid() && kv.value->get_status() != GDScriptParserRef::EMPTY) {
+			_collect_dependencies(kv.value->get_parser(), r_dependencies);
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::_read_header(Reader &p_reader, const String &p_source_digest) {
+	if (p_reader.get_u32() != CACHE_MAGIC || p_reader.get_u32() != FORMAT_VERSION) {
+		return false;
+	}
+	if (p_reader.get_u32() != _get_build_hash()) {
+		return false;
+	}
+	const uint32_t payload_hash = p_reader.get_u32();
+	if (p_reader.failed || hash_djb2_buffer(p_reader.ptr + p_reader.pos, p_reader.size - p_reader.pos) != payload_hash) {
+		return false;
+	}
+	if (p_reader.get_string() != p_source_digest) {
+		return false;
+	}
+
+	const uint32_t dependency_count = p_reader.get_count();
+	for (uint32_t i = 0; i < dependency_count && !p_reader.failed; i++) {
+		const String path = p_reader.get_string();
+		const String digest = p_reader.get_string();
+		if (_get_dependency_digest(path) != digest) {
+			return false;
+		}
+	}
+	return !p_reader.failed;
+}
+
+Error GDScriptBytecodeCache::serialize(const GDScript *p_script, const HashSet<String> &p_dependencies, Vector<uint8_t> &r_buffer) {
+	ERR_FAIL_COND_V(!p_script->is_root_script(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!p_script->is_script_valid(), ERR_INVALID_PARAMETER);
+
+	Writer writer;
+	writer.root = p_script;
+	writer.tables = _get_reverse_tables();
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	for (const KeyValue<StringName, int> &kv : language->get_global_map()) {
+		writer.global_indices.insert(kv.value, kv.key);
+		const Object *object = language->get_global_array()[kv.value].get_validated_object();
+		if (object != nullptr) {
+			writer.global_objects.insert(object, kv.key);
+		}
+	}
+
+	writer.put_u8(GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name) ? FLAG_STATIC_SCRIPT : 0);
+	writer.put_skeleton(p_script);
+	if (!writer.put_class(p_script)) {
+		print_verbose(vformat(R"(GDScript: Not caching "%s": %s)", p_script->path, writer.error));
+		return ERR_UNAVAILABLE;
+	}
+
+	HashSet<String> dependencies(p_dependencies);
+	for (const String &path : writer.referenced_paths) {
+		dependencies.insert(path);
+	}
+	dependencies.erase(p_script->path);
+
+	Writer header;
+	header.put_string(get_source_digest(p_script));
+	header.put_u32(dependencies.size());
+	for (const String &path : dependencies) {
+		header.put_string(path);
+		header.put_string(_get_dependency_digest(path));
+	}
+
+	// The payload hash covers the source digest and everything after it.
+	const uint32_t payload_pos = 16;
+	r_buffer.resize(payload_pos + header.data.size() + writer.data.size());
+	uint8_t *w = r_buffer.ptrw();
+	encode_uint32(CACHE_MAGIC, w);
+	encode_uint32(FORMAT_VERSION, w + 4);
+	encode_uint32(_get_build_hash(), w + 8);
+	memcpy(w + payload_pos, header.data.ptr(), header.data.size());
+	memcpy(w + payload_pos + header.data.size(), writer.data.ptr(), writer.data.size());
+	encode_uint32(hash_djb2_buffer(w + payload_pos, r_buffer.size() - payload_pos), w + 12);
+	return OK;
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	Reader reader(p_buffer);
+	if (!_read_header(reader, get_source_digest(p_script))) {
+		return ERR_INVALID_DATA;
+	}
+	reader.get_u8(); // Flags.
+
+	struct Skeleton {
+		static void read(Reader &p_reader, GDScript *p_script) {
+			p_script->fully_qualified_name = p_reader.get_string();
+			p_script->local_name = p_reader.get_name();
+			p_script->global_name = p_reader.get_name();
+			p_script->simplified_icon_path = p_reader.get_string();
+
+			HashMap<StringName, Ref<GDScript>> old_subclasses(p_script->subclasses);
+			p_script->subclasses.clear();
+			const uint32_t count = p_reader.get_count();
+			for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+				const StringName name = p_reader.get_name();
+				const String fully_qualified_name = p_script->fully_qualified_name + "::" + name;
+
+				Ref<GDScript> subclass;
+				if (old_subclasses.has(name)) {
+					subclass = old_subclasses[name];
+				} else {
+					subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+				}
+				if (subclass.is_null()) {
+					subclass.instantiate();
+				}
+
+				subclass->_owner = p_script;
+				subclass->path = p_script->path;
+				p_script->subclasses.insert(name, subclass);
+
+				read(p_reader, subclass.ptr());
+			}
+		}
+	};
+
+	Skeleton::read(reader, p_script);
+	return reader.failed ? ERR_INVALID_DATA : OK;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V(!p_script->is_root_script(), ERR_INVALID_PARAMETER);
+
+	Reader reader(p_buffer);
+	reader.root = p_script;
+	if (!_read_header(reader, get_source_digest(p_script))) {
+		return ERR_INVALID_DATA;
+	}
+	const uint8_t flags = reader.get_u8();
+
+	// Compiling from source is needed for scripts that already hold code, e.g. when hot-reloading.
+	struct Fresh {
+		static bool check(const GDScript *p_script) {
+			if (p_script->valid || !p_script->member_functions.is_empty() || p_script->implicit_initializer || p_script->static_initializer) {
+				return false;
+			}
+			for (const KeyValue<StringName, Ref<GDScript>> &kv : p_script->subclasses) {
+				if (!check(kv.value.ptr())) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+	if (!Fresh::check(p_script)) {
+		return ERR_ALREADY_IN_USE;
+	}
+	if (make_scripts(p_script, p_buffer) != OK) {
+		return ERR_INVALID_DATA;
+	}
+
+	// Skip the skeleton, which was applied above.
+	struct SkipSkeleton {
+		static void skip(Reader &p_reader) {
+			for (int i = 0; i < 4; i++) {
+				p_reader.skip_string();
+			}
+			const uint32_t count = p_reader.get_count();
+			for (uint32_t i = 0; i < count && !p_reader.failed; i++) {
+				p_reader.skip_string();
+				skip(p_reader);
+			}
+		}
+	};
+	SkipSkeleton::skip(reader);
+
+	LocalVector<ClassData> classes;
+	if (!reader.get_class(p_script, classes)) {
+		for (ClassData &data : classes) {
+			data.free_functions();
+		}
+		print_verbose(vformat(R"(GDScript: Ignoring cached bytecode for "%s": %s)", p_script->path, reader.error));
+		return ERR_INVALID_DATA;
+	}
+
+	for (ClassData &data : classes) {
+		GDScript *script = data.script;
+		script->tool = data.tool;
+		script->_is_abstract = data.is_abstract;
+		script->native = data.native;
+		script->base = data.base;
+		script->member_indices = data.member_indices;
+		script->members = data.members;
+		script->static_variables_indices = data.static_variables_indices;
+		script->static_variables.resize(script->static_variables_indices.size());
+		script->constants = data.constants;
+		script->_signals = data.signals;
+		script->rpc_config = data.rpc_config;
+		script->member_functions = data.member_functions;
+		script->lambda_info = data.lambda_info;
+		script->implicit_initializer = data.implicit_initializer;
+		script->implicit_ready = data.implicit_ready;
+		script->static_initializer = data.static_initializer;
+
+		GDScriptFunction **initializer = script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+		script->initializer = initializer ? *initializer : nullptr;
+	}
+	for (ClassData &data : classes) {
+		data.script->_static_default_init();
+		data.script->valid = true;
+	}
+
+	if (flags & FLAG_STATIC_SCRIPT) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	return OK;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::fetch(const String &p_path, const String &p_source_digest) {
+	const String cache_path = get_cache_path(p_path);
+	if (!FileAccess::exists(cache_path)) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(cache_path);
+	Reader reader(buffer);
+	if (!_read_header(reader, p_source_digest)) {
+		return Vector<uint8_t>();
+	}
+	return buffer;
+}
+
+void GDScriptBytecodeCache::store(const GDScript *p_script, GDScriptParser *p_parser) {
+	HashSet<String> dependencies;
+	_collect_dependencies(p_parser, dependencies);
+
+	Vector<uint8_t> buffer;
+	if (serialize(p_script, dependencies, buffer) != OK) {
+		return;
+	}
+
+	const String cache_path = get_cache_path(p_script->get_script_path());
+	Error err = DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	ERR_FAIL_COND_MSG(err != OK && err != ERR_ALREADY_EXISTS, vformat(R"(Could not create the GDScript bytecode cache directory "%s".)", cache_path.get_base_dir()));
+
+	Ref<FileAccess> file = FileAccess::open(cache_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_MSG(err != OK, vformat(R"(Could not write the GDScript bytecode cache "%s".)", cache_path));
+	file->store_buffer(buffer.ptr(), buffer.size());
+}
+
+void GDScriptBytecodeCache::clear() {
+	{
+		MutexLock lock(digests_mutex);
+		source_digests.clear();
+		build_hash_computed = false;
+	}
+
+	MutexLock lock(reverse_tables_mutex);
+	if (reverse_tables != nullptr) {
+		memdelete(reverse_tables);
+		reverse_tables = nullptr;
+	}
+}
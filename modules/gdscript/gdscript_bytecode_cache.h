@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+class GDScriptParser;
+
+// Stores fully compiled scripts on disk so later runs can skip parsing, analysis
+// and compilation. An entry only matches the build that wrote it, and is rejected
+// once the script or any script it was compiled against changes.
+class GDScriptBytecodeCache {
+	struct Writer;
+	struct Reader;
+	struct ClassData;
+
+	static inline Mutex digests_mutex;
+	static inline HashMap<String, String> source_digests;
+	static inline uint32_t build_hash = 0;
+	static inline bool build_hash_computed = false;
+
+	static uint32_t _compute_build_hash();
+	static uint32_t _get_build_hash();
+	static String _get_dependency_digest(const String &p_path);
+	static void _collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_dependencies);
+	static bool _read_header(Reader &p_reader, const String &p_source_digest);
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 5;
+
+	static bool is_enabled();
+	static String get_cache_path(const String &p_script_path);
+	// SHA-256 of the source code or binary tokens, so an edited script can't pass for the one an entry was compiled from.
+	static String get_source_digest(const String &p_source_code);
+	static String get_source_digest(const Vector<uint8_t> &p_binary_tokens);
+	static String get_source_digest(const GDScript *p_script);
+
+	// `p_dependencies` are the paths of every script the compiled code depends on.
+	static Error serialize(const GDScript *p_script, const HashSet<String> &p_dependencies, Vector<uint8_t> &r_buffer);
+	// Creates the inner class scripts, like `GDScriptCompiler::make_scripts()`.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	// Only fills scripts that were never compiled; on failure they are left uncompiled.
+	static Error deserialize(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+
+	// Returns the cached entry for `p_path`, or an empty buffer if there is none or it is stale.
+	static Vector<uint8_t> fetch(const String &p_path, const String &p_source_digest);
+	static void store(const GDScript *p_script, GDScriptParser *p_parser);
+	static void clear();
+};
@@ -32,11 +32,14 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_set.h"
 #include "core/templates/vector.h"
 
@@ -165,6 +168,7 @@ void GDScriptCache::move_script(const String &p_from, const String &p_to) {
 	}
 
 	remove_parser(p_from);
+	_discard_parsed_script(p_from);
 
 	if (singleton->shallow_gdscript_cache.has(p_from) && !p_from.is_empty()) {
 		singleton->shallow_gdscript_cache[p_to] = singleton->shallow_gdscript_cache[p_from];
@@ -204,6 +208,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 	}
 
 	remove_parser(p_path);
+	_discard_parsed_script(p_path);
 
 	singleton->dependencies.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
@@ -329,9 +334,17 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	bool cached = false;
+	if (GDScriptBytecodeCache::is_enabled()) {
+		const Vector<uint8_t> buffer = GDScriptBytecodeCache::fetch(p_path, GDScriptBytecodeCache::get_source_digest(script.ptr()));
+		cached = !buffer.is_empty() && GDScriptBytecodeCache::make_scripts(script.ptr(), buffer) == OK;
+	}
+
+	if (!cached) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -416,6 +429,127 @@ Ref<GDScript> GDScriptCache::get_cached_script(const String &p_path) {
 	return Ref<GDScript>();
 }
 
+void GDScriptCache::_parse_task(void *p_userdata, uint32_t p_index) {
+	ParseTask &task = static_cast<ParseTask *>(p_userdata)[p_index];
+
+	// Only touches the task, the cache is updated by the waiting thread.
+	if (task.remapped_path.has_extension("gdc")) {
+		const Vector<uint8_t> tokens = get_binary_tokens(task.remapped_path);
+		task.source_digest = GDScriptBytecodeCache::get_source_digest(tokens);
+		task.error = tokens.is_empty() ? ERR_FILE_CANT_READ : task.parser->parse_binary(tokens, task.path);
+	} else {
+		const String source = get_source_code(task.remapped_path);
+		task.source_digest = GDScriptBytecodeCache::get_source_digest(source);
+		task.error = task.parser->parse(source, task.path, false);
+	}
+}
+
+// Parses the scripts on worker threads, so `GDScript::reload()` can skip it when they are compiled one by one.
+// Analysis stays on the calling thread: it reads other scripts through the parser cache and can recurse
+// into cyclic dependencies, so running it concurrently would make the result depend on thread timing.
+Vector<String> GDScriptCache::_parse_concurrently(const Vector<String> &p_paths) {
+	Vector<String> parsed;
+
+	// Scripts are loaded from the bytecode cache instead.
+	if (GDScriptBytecodeCache::is_enabled()) {
+		return parsed;
+	}
+	// Blocking a worker on other tasks could starve the pool, and threaded loading already spreads scripts over threads.
+	if (WorkerThreadPool::get_singleton() == nullptr || WorkerThreadPool::get_singleton()->get_thread_index() != -1) {
+		return parsed;
+	}
+
+	LocalVector<ParseTask> tasks;
+	for (const String &path : p_paths) {
+		if (singleton->full_gdscript_cache.has(path) || singleton->parsed_scripts.has(path)) {
+			continue;
+		}
+		ParseTask task;
+		task.path = path;
+		task.remapped_path = ResourceLoader::path_remap(path);
+		tasks.push_back(task);
+	}
+	if (tasks.size() < 2) {
+		return parsed;
+	}
+
+	// The parser fills some static tables the first time it's used, this must happen before the tasks start.
+	GDScriptParser::get_builtin_type(StringName());
+	for (ParseTask &task : tasks) {
+		task.parser = memnew(GDScriptParser);
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&GDScriptCache::_parse_task, tasks.ptr(), tasks.size(), -1, true, SNAME("GDScriptParse"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (ParseTask &task : tasks) {
+		// Scripts failing to parse are parsed again by `GDScript::reload()`, which reports the errors.
+		if (task.error != OK || singleton->parsed_scripts.has(task.path)) {
+			memdelete(task.parser);
+			continue;
+		}
+		ParsedScript &parsed_script = singleton->parsed_scripts[task.path];
+		parsed_script.parser = task.parser;
+		parsed_script.source_digest = task.source_digest;
+		parsed.push_back(task.path);
+	}
+
+	return parsed;
+}
+
+void GDScriptCache::_discard_parsed_script(const String &p_path) {
+	HashMap<String, ParsedScript>::Iterator E = singleton->parsed_scripts.find(p_path);
+	if (E) {
+		memdelete(E->value.parser);
+		singleton->parsed_scripts.remove(E);
+	}
+}
+
+bool GDScriptCache::take_parsed_script(const String &p_path, const GDScript *p_script, GDScriptParser &r_parser) {
+	MutexLock lock(singleton->mutex);
+
+	HashMap<String, ParsedScript>::Iterator E = singleton->parsed_scripts.find(p_path);
+	if (!E) {
+		return false;
+	}
+	const ParsedScript parsed = E->value;
+	singleton->parsed_scripts.remove(E);
+
+	// The source may have changed since, e.g. when edited but not saved.
+	const bool valid = parsed.source_digest == GDScriptBytecodeCache::get_source_digest(p_script);
+	if (valid) {
+		// Hands over the tree, the same way `GDScriptParser::clear()` does.
+		r_parser = *parsed.parser;
+		*parsed.parser = GDScriptParser();
+	}
+	memdelete(parsed.parser);
+
+	return valid;
+}
+
+void GDScriptCache::_add_to_compile_order(const String &p_path, const HashSet<String> &p_paths, HashSet<String> &r_visited, Vector<String> &r_order) {
+	if (r_visited.has(p_path)) {
+		return;
+	}
+	r_visited.insert(p_path);
+
+	// Known dependencies go first, cycles are cut by the visited set.
+	if (const HashSet<String> *depends = singleton->dependencies.getptr(p_path)) {
+		Vector<String> sorted;
+		for (const String &E : *depends) {
+			if (p_paths.has(E)) {
+				sorted.push_back(E);
+			}
+		}
+		sorted.sort();
+		for (const String &E : sorted) {
+			_add_to_compile_order(E, p_paths, r_visited, r_order);
+		}
+	}
+
+	r_order.push_back(p_path);
+}
+
 Error GDScriptCache::finish_compiling(const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -426,8 +560,22 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 
 	HashSet<String> depends(singleton->dependencies[p_owner]);
 
-	Error err = OK;
+	// Compile in an order which only depends on the scripts, not on the order they were found in.
+	Vector<String> sorted;
 	for (const String &E : depends) {
+		sorted.push_back(E);
+	}
+	sorted.sort();
+	Vector<String> order;
+	HashSet<String> visited;
+	for (const String &E : sorted) {
+		_add_to_compile_order(E, depends, visited, order);
+	}
+
+	const Vector<String> parsed = _parse_concurrently(order);
+
+	Error err = OK;
+	for (const String &E : order) {
 		Error this_err = OK;
 		// No need to save the script. We assume it's already referenced in the owner.
 		get_full_script(E, this_err);
@@ -437,6 +585,11 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 		}
 	}
 
+	// Left over when a script didn't need to reload after all.
+	for (const String &E : parsed) {
+		_discard_parsed_script(E);
+	}
+
 	singleton->dependencies.erase(p_owner);
 
 	return err;
@@ -477,6 +630,11 @@ void GDScriptCache::clear() {
 
 	singleton->abandoned_parser_map.clear();
 
+	for (KeyValue<String, ParsedScript> &E : singleton->parsed_scripts) {
+		memdelete(E.value.parser);
+	}
+	singleton->parsed_scripts.clear();
+
 	RBSet<Ref<GDScriptParserRef>> parser_map_refs;
 	for (KeyValue<String, GDScriptParserRef *> &E : singleton->parser_map) {
 		parser_map_refs.insert(E.value);
@@ -92,7 +92,23 @@ class GDScriptCache {
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
 
+	struct ParsedScript {
+		GDScriptParser *parser = nullptr;
+		String source_digest;
+	};
+	// Dependencies parsed ahead on worker threads by `finish_compiling()`, taken by `GDScript::reload()`.
+	HashMap<String, ParsedScript> parsed_scripts;
+
+	struct ParseTask {
+		String path;
+		String remapped_path;
+		GDScriptParser *parser = nullptr;
+		String source_digest;
+		Error error = OK;
+	};
+
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 	friend class GDScriptTests::TestGDScriptCacheAccessor;
@@ -108,6 +124,11 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	static void _parse_task(void *p_userdata, uint32_t p_index);
+	static Vector<String> _parse_concurrently(const Vector<String> &p_paths);
+	static void _discard_parsed_script(const String &p_path);
+	static void _add_to_compile_order(const String &p_path, const HashSet<String> &p_paths, HashSet<String> &r_visited, Vector<String> &r_order);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
@@ -125,6 +146,7 @@ public:
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
 	static Error finish_compiling(const String &p_owner);
+	static bool take_parsed_script(const String &p_path, const GDScript *p_script, GDScriptParser &r_parser);
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
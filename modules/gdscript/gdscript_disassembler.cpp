@@ -142,6 +142,78 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_ADD_INT:
+			case OPCODE_OPERATOR_SUBTRACT_INT:
+			case OPCODE_OPERATOR_MULTIPLY_INT:
+			case OPCODE_OPERATOR_EQUAL_INT:
+			case OPCODE_OPERATOR_NOT_EQUAL_INT:
+			case OPCODE_OPERATOR_LESS_INT:
+			case OPCODE_OPERATOR_LESS_EQUAL_INT:
+			case OPCODE_OPERATOR_GREATER_INT:
+			case OPCODE_OPERATOR_GREATER_EQUAL_INT:
+			case OPCODE_OPERATOR_ADD_FLOAT:
+			case OPCODE_OPERATOR_SUBTRACT_FLOAT:
+			case OPCODE_OPERATOR_MULTIPLY_FLOAT:
+			case OPCODE_OPERATOR_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_NOT_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_LESS_FLOAT:
+			case OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_GREATER_FLOAT:
+			case OPCODE_OPERATOR_GREATER_EQUAL_FLOAT: {
+				text += opcode >= OPCODE_OPERATOR_ADD_FLOAT ? "float operator " : "int operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 5;
+			} break;
+			case OPCODE_JUMP_IF_NOT_EQUAL_INT:
+			case OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT:
+			case OPCODE_JUMP_IF_NOT_LESS_INT:
+			case OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT:
+			case OPCODE_JUMP_IF_NOT_GREATER_INT:
+			case OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT:
+			case OPCODE_JUMP_IF_NOT_EQUAL_FLOAT:
+			case OPCODE_JUMP_IF_NOT_NOT_EQUAL_FLOAT:
+			case OPCODE_JUMP_IF_NOT_LESS_FLOAT:
+			case OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT:
+			case OPCODE_JUMP_IF_NOT_GREATER_FLOAT:
+			case OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT: {
+				text += opcode >= OPCODE_JUMP_IF_NOT_EQUAL_FLOAT ? "float compare " : "int compare ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += ", jump-if-not to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr += 6;
+			} break;
+			case OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3:
+			case OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3_FLOAT: {
+				text += "multiply-add ";
+
+				text += DADDR(6);
+				text += " = (";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " * ";
+				text += DADDR(2);
+				text += ") + ";
+				text += DADDR(5);
+
+				incr += 8;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -223,6 +223,45 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+struct GDScriptSpecializedOperator {
+	Variant::Operator op;
+	Variant::Type type;
+	GDScriptFunction::Opcode opcode;
+};
+
+static const GDScriptSpecializedOperator specialized_operators[] = {
+	{ Variant::OP_ADD, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_ADD_INT },
+	{ Variant::OP_SUBTRACT, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT },
+	{ Variant::OP_MULTIPLY, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT },
+	{ Variant::OP_EQUAL, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT },
+	{ Variant::OP_NOT_EQUAL, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT },
+	{ Variant::OP_LESS, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_LESS_INT },
+	{ Variant::OP_LESS_EQUAL, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT },
+	{ Variant::OP_GREATER, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_GREATER_INT },
+	{ Variant::OP_GREATER_EQUAL, Variant::INT, GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT },
+	{ Variant::OP_ADD, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT },
+	{ Variant::OP_SUBTRACT, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT },
+	{ Variant::OP_MULTIPLY, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT },
+	{ Variant::OP_EQUAL, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT },
+	{ Variant::OP_NOT_EQUAL, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT },
+	{ Variant::OP_LESS, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT },
+	{ Variant::OP_LESS_EQUAL, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT },
+	{ Variant::OP_GREATER, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT },
+	{ Variant::OP_GREATER_EQUAL, Variant::FLOAT, GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT },
+};
+
+GDScriptFunction::Opcode GDScriptFunction::get_specialized_operator(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type != p_right_type) {
+		return OPCODE_OPERATOR_VALIDATED;
+	}
+	for (const GDScriptSpecializedOperator &specialized : specialized_operators) {
+		if (specialized.op == p_operator && specialized.type == p_left_type) {
+			return specialized.opcode;
+		}
+	}
+	return OPCODE_OPERATOR_VALIDATED;
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
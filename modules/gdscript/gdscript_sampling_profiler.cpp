@@ -0,0 +1,473 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript.h"
+
+#include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+
+#if (defined(LINUXBSD_ENABLED) && defined(CRASH_HANDLER_ENABLED)) || defined(MACOS_ENABLED)
+#define GDSCRIPT_SAMPLING_EXECINFO
+#ifdef MACOS_ENABLED
+#include "platform/macos/stack_trace_macos.h"
+#else
+#include "platform/linuxbsd/stack_trace_linuxbsd.h"
+#endif
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#elif defined(WINDOWS_ENABLED) && !defined(_MSC_VER)
+// Uses the libbacktrace build from `drivers/backtrace`, like the crash handler.
+#define GDSCRIPT_SAMPLING_LIBBACKTRACE
+#include <thirdparty/libbacktrace/backtrace.h>
+
+#include <cxxabi.h>
+#include <windows.h>
+#endif
+
+static constexpr int MAX_NATIVE_FRAMES = 128;
+
+#ifdef GDSCRIPT_SAMPLING_LIBBACKTRACE
+static backtrace_state *native_state = nullptr;
+static CharString native_exec_path; // libbacktrace keeps a pointer to the file name.
+static int64_t native_offset = 0;
+
+struct NativeCapture {
+	void **frames = nullptr;
+	int count = 0;
+	int max = 0;
+};
+
+struct NativeSymbol {
+	String name;
+};
+
+static void _native_error_callback(void *p_data, const char *p_msg, int p_errnum) {}
+
+static int _native_simple_callback(void *p_data, uintptr_t p_pc) {
+	NativeCapture *capture = reinterpret_cast<NativeCapture *>(p_data);
+	capture->frames[capture->count++] = reinterpret_cast<void *>(p_pc);
+	return capture->count >= capture->max ? 1 : 0;
+}
+
+static int _native_pcinfo_callback(void *p_data, uintptr_t p_pc, const char *p_filename, int p_lineno, const char *p_function) {
+	if (p_function) {
+		reinterpret_cast<NativeSymbol *>(p_data)->name = String::utf8(p_function);
+	}
+	return 1;
+}
+
+static int64_t _get_image_file_base(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return 0;
+	}
+	f->seek(0x3c);
+	f->seek(f->get_32());
+	if (f->get_32() != 0x00004550) {
+		return 0;
+	}
+	const int64_t opt_header_pos = f->get_position() + 0x14;
+	f->seek(opt_header_pos);
+	const uint16_t opt_header_magic = f->get_16();
+	if (opt_header_magic == 0x10B) {
+		f->seek(opt_header_pos + 0x1C);
+		return f->get_32();
+	} else if (opt_header_magic == 0x20B) {
+		f->seek(opt_header_pos + 0x18);
+		return f->get_64();
+	}
+	return 0;
+}
+#endif // GDSCRIPT_SAMPLING_LIBBACKTRACE
+
+static String _sanitize_frame(const String &p_frame) {
+	// Semicolons separate frames in the folded format, and newlines separate stacks.
+	return p_frame.replace_char(';', ':').replace_char('\n', ' ');
+}
+
+static String _strip_arguments(const String &p_symbol) {
+	// Demangled names carry the full signature, which only makes flame graphs harder to read.
+	int from = 0;
+	if (p_symbol.begins_with("(anonymous namespace)")) {
+		from = 21;
+	}
+	int template_depth = 0;
+	for (int i = from; i < p_symbol.length(); i++) {
+		const char32_t c = p_symbol[i];
+		if (c == '<') {
+			template_depth++;
+		} else if (c == '>') {
+			template_depth--;
+		} else if (c == '(' && template_depth == 0 && i > 0) {
+			return p_symbol.substr(0, i);
+		}
+	}
+	return p_symbol;
+}
+
+static String _demangle(const char *p_symbol) {
+#if defined(GDSCRIPT_SAMPLING_EXECINFO) || defined(GDSCRIPT_SAMPLING_LIBBACKTRACE)
+	if (p_symbol[0] == '_') {
+		int status = 0;
+		char *demangled = abi::__cxa_demangle(p_symbol, nullptr, nullptr, &status);
+		if (demangled) {
+			String name = status == 0 ? String::utf8(demangled) : String::utf8(p_symbol);
+			free(demangled);
+			return name;
+		}
+	}
+#endif
+	return String::utf8(p_symbol);
+}
+
+bool GDScriptSamplingProfiler::is_native_frames_supported() {
+#if defined(GDSCRIPT_SAMPLING_EXECINFO) || defined(GDSCRIPT_SAMPLING_LIBBACKTRACE)
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool GDScriptSamplingProfiler::_init_native_frames() {
+#if defined(GDSCRIPT_SAMPLING_EXECINFO)
+	return true;
+#elif defined(GDSCRIPT_SAMPLING_LIBBACKTRACE)
+	if (native_state != nullptr) {
+		return true;
+	}
+
+	String exec_path = OS::get_singleton()->get_executable_path();
+	// The image can be relocated by ASLR, libbacktrace expects addresses relative to the preferred base.
+	native_offset = reinterpret_cast<int64_t>(GetModuleHandle(nullptr)) - _get_image_file_base(exec_path);
+	if (FileAccess::exists(exec_path + ".debugsymbols")) {
+		exec_path = exec_path + ".debugsymbols";
+	}
+	native_exec_path = exec_path.replace_char('/', '\\').utf8();
+	native_state = backtrace_create_state(native_exec_path.get_data(), 1, &_native_error_callback, nullptr);
+	return native_state != nullptr;
+#else
+	return false;
+#endif
+}
+
+int GDScriptSamplingProfiler::_capture_native_frames(void **r_frames, int p_max) {
+#if defined(GDSCRIPT_SAMPLING_EXECINFO)
+	return backtrace(r_frames, p_max);
+#elif defined(GDSCRIPT_SAMPLING_LIBBACKTRACE)
+	NativeCapture capture;
+	capture.frames = r_frames;
+	capture.max = p_max;
+	backtrace_simple(native_state, 0, &_native_simple_callback, &_native_error_callback, &capture);
+	return capture.count;
+#else
+	return 0;
+#endif
+}
+
+void GDScriptSamplingProfiler::_set_native_symbol(void *p_address, const String &p_name) {
+	const uint64_t address = reinterpret_cast<uint64_t>(p_address);
+	native_symbols.insert(address, _sanitize_frame(p_name.is_empty() ? vformat("0x%x", address) : p_name));
+}
+
+void GDScriptSamplingProfiler::_resolve_native_symbols(const LocalVector<void *> &p_addresses) {
+	// Called with the symbol mutex locked.
+#if defined(GDSCRIPT_SAMPLING_EXECINFO)
+	// Engine symbols aren't exported, so `dladdr()` only names frames in other libraries. Frames in the executable are
+	// looked up in its debug information instead, with one call to the same tool the crash handler uses.
+	Dl_info self_info;
+	const void *executable_base = dladdr(reinterpret_cast<void *>(&GDScriptSamplingProfiler::take_sample), &self_info) ? self_info.dli_fbase : nullptr;
+	LocalVector<void *> executable_addresses;
+	for (void *address : p_addresses) {
+		String name;
+		Dl_info info;
+		if (dladdr(address, &info)) {
+			if (info.dli_fbase == executable_base && executable_base != nullptr) {
+				executable_addresses.push_back(address);
+				continue;
+			}
+			if (info.dli_sname) {
+				name = _strip_arguments(_demangle(info.dli_sname));
+			} else if (info.dli_fname) {
+				name = vformat("%s+0x%x", String::utf8(info.dli_fname).get_file(), reinterpret_cast<uint64_t>(address) - reinterpret_cast<uint64_t>(info.dli_fbase));
+			}
+		}
+		_set_native_symbol(address, name);
+	}
+	if (executable_addresses.is_empty()) {
+		return;
+	}
+
+	String exec_path = OS::get_singleton()->get_executable_path();
+	if (FileAccess::exists(exec_path + ".debugsymbols")) {
+		exec_path = exec_path + ".debugsymbols";
+	}
+#ifdef MACOS_ENABLED
+	const Vector<String> lines = StackTraceMacOS::symbolize_with_atos(exec_path, executable_base, executable_addresses.ptr(), executable_addresses.size());
+#else
+	const Vector<String> lines = StackTraceLinuxBSD::symbolize_with_addr2line(exec_path, executable_addresses.ptr(), executable_addresses.size());
+#endif
+	for (uint32_t i = 0; i < executable_addresses.size(); i++) {
+		String name;
+		if (lines.size() == int(executable_addresses.size())) {
+			// addr2line prints "function at file:line" and atos "function (in module) (file:line)".
+			// Addresses they can't resolve are printed as "??" and as the address itself.
+			name = lines[i].get_slice(" at ", 0).get_slice(" (in ", 0).strip_edges();
+			name = (name.begins_with("??") || name.begins_with("0x")) ? String() : _strip_arguments(name);
+		}
+		if (name.is_empty()) {
+			name = vformat("%s+0x%x", exec_path.get_file(), reinterpret_cast<uint64_t>(executable_addresses[i]) - reinterpret_cast<uint64_t>(executable_base));
+		}
+		_set_native_symbol(executable_addresses[i], name);
+	}
+#elif defined(GDSCRIPT_SAMPLING_LIBBACKTRACE)
+	for (void *address : p_addresses) {
+		NativeSymbol symbol;
+		backtrace_pcinfo(native_state, reinterpret_cast<uint64_t>(address) - native_offset, &_native_pcinfo_callback, &_native_error_callback, &symbol);
+		_set_native_symbol(address, symbol.name.is_empty() ? String() : _strip_arguments(_demangle(symbol.name.utf8().get_data())));
+	}
+#else
+	for (void *address : p_addresses) {
+		_set_native_symbol(address, String());
+	}
+#endif
+}
+
+String GDScriptSamplingProfiler::_fold_stack(const Stack &p_stack) {
+	// Called with the symbol mutex locked, after the native frames of the stack were resolved.
+	String folded = p_stack.thread;
+
+	// Each native `GDScriptFunction::call` frame stands for one script frame, so engine frames between
+	// script calls (signals, callbacks, notifications) end up where they happened. Frames inside the
+	// innermost one belong to the profiler itself and are dropped.
+	const int native_count = p_stack.native_frames.size();
+	int innermost_call = -1;
+	for (int i = 0; i < native_count; i++) {
+		if (native_symbols[reinterpret_cast<uint64_t>(p_stack.native_frames[i])] == "GDScriptFunction::call") {
+			innermost_call = i;
+			break;
+		}
+	}
+
+	int script_index = int(p_stack.script_frames.size()) - 1;
+	if (innermost_call != -1) {
+		for (int i = native_count - 1; i > innermost_call; i--) {
+			const String &symbol = native_symbols[reinterpret_cast<uint64_t>(p_stack.native_frames[i])];
+			if (symbol != "GDScriptFunction::call") {
+				folded += ";" + symbol;
+			} else if (script_index > 0) {
+				folded += ";" + p_stack.script_frames[script_index--];
+			}
+		}
+	}
+	for (; script_index >= 0; script_index--) {
+		folded += ";" + p_stack.script_frames[script_index];
+	}
+	return folded;
+}
+
+void GDScriptSamplingProfiler::_timer_thread_func(void *p_userdata) {
+	while (running.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		sample_request.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::take_sample() {
+	// The sample stands for every tick since the previous one on this thread, but not for ticks from before
+	// the profiler started. Ticks spent outside of script code are skipped by `enter_script()`.
+	const uint32_t request = sample_request.get();
+	const uint32_t ticks = MIN(request - sample_seen, request - start_request);
+	sample_seen = request;
+	if (!running.is_set() || ticks == 0) {
+		return;
+	}
+
+	// Called from the VM on its own thread, so the thread local call stack can be walked as is.
+	// The innermost frame is still on the line that just finished executing, which is where the time went.
+	Stack sample;
+	for (const GDScriptLanguage::CallLevel *cl = GDScriptLanguage::_call_stack; cl != nullptr; cl = cl->prev) {
+		if (cl->function == nullptr) {
+			continue;
+		}
+		sample.script_frames.push_back(_sanitize_frame(vformat("%s (%s:%d)", cl->function->get_name(), cl->function->get_source(), *cl->line)));
+	}
+	if (sample.script_frames.is_empty()) {
+		return;
+	}
+
+	void *native[MAX_NATIVE_FRAMES];
+	const int native_count = native_frames ? _capture_native_frames(native, MAX_NATIVE_FRAMES) : 0;
+
+	sample.thread = Thread::is_main_thread() ? String("main") : vformat("thread %d", (uint64_t)Thread::get_caller_id());
+	String key = sample.thread;
+	for (const String &frame : sample.script_frames) {
+		key += ";" + frame;
+	}
+	for (int i = 0; i < native_count; i++) {
+		key += ";" + String::num_uint64(reinterpret_cast<uint64_t>(native[i]), 16);
+		sample.native_frames.push_back(native[i]);
+	}
+
+	MutexLock lock(mutex);
+	HashMap<String, Stack>::Iterator E = stacks.find(key);
+	if (!E) {
+		E = stacks.insert(key, sample);
+	}
+	E->value.ticks += ticks;
+	sample_count += ticks;
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec, bool p_native_frames) {
+	ERR_FAIL_COND_MSG(running.is_set(), "The GDScript sampling profiler is already running.");
+
+	interval_usec = MAX(p_interval_usec, (uint64_t)50);
+	native_frames = p_native_frames && _init_native_frames();
+	if (p_native_frames && !native_frames) {
+		WARN_PRINT("Native stack traces are not available in this build, the GDScript sampling profiler will only record script frames.");
+	}
+
+	start_request = sample_request.get();
+	running.set();
+	timer_thread.start(&GDScriptSamplingProfiler::_timer_thread_func, nullptr);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+	running.clear();
+	timer_thread.wait_to_finish();
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+String GDScriptSamplingProfiler::get_folded_stacks() {
+	LocalVector<Stack> samples;
+	{
+		MutexLock lock(mutex);
+		for (const KeyValue<String, Stack> &E : stacks) {
+			samples.push_back(E.value);
+		}
+	}
+
+	// Symbols are looked up outside of the sampling mutex, since that may take a while.
+	MutexLock symbol_lock(symbol_mutex);
+	HashSet<void *> pending;
+	for (const Stack &sample : samples) {
+		for (void *address : sample.native_frames) {
+			if (!native_symbols.has(reinterpret_cast<uint64_t>(address))) {
+				pending.insert(address);
+			}
+		}
+	}
+	if (!pending.is_empty()) {
+		LocalVector<void *> addresses;
+		for (void *address : pending) {
+			addresses.push_back(address);
+		}
+		_resolve_native_symbols(addresses);
+	}
+
+	// Different addresses in the same functions fold into the same stack.
+	HashMap<String, uint64_t> folded_stacks;
+	for (const Stack &sample : samples) {
+		folded_stacks[_fold_stack(sample)] += sample.ticks;
+	}
+	Vector<String> lines;
+	for (const KeyValue<String, uint64_t> &E : folded_stacks) {
+		lines.push_back(vformat("%s %d", E.key, E.value));
+	}
+	if (lines.is_empty()) {
+		return String();
+	}
+	lines.sort();
+	return String("\n").join(lines) + "\n";
+}
+
+Error GDScriptSamplingProfiler::save_folded_stacks(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot save GDScript sampling profile to \"%s\".", p_path));
+	f->store_string(get_folded_stacks());
+	return OK;
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	stacks.clear();
+	sample_count = 0;
+}
+
+void GDScriptSamplingProfiler::_profiler_toggle(void *p_user, bool p_enable, const Array &p_opts) {
+	if (p_enable) {
+		if (is_running()) {
+			return; // Already started from the command line, keep adding to the same profile.
+		}
+		clear();
+		const uint64_t interval = p_opts.size() > 0 ? uint64_t(p_opts[0]) : uint64_t(GLOBAL_GET("debug/settings/gdscript/sampling_profiler_interval_usec"));
+		const bool native = p_opts.size() > 1 ? bool(p_opts[1]) : bool(GLOBAL_GET("debug/settings/gdscript/sampling_profiler_native_frames"));
+		start(interval, native);
+		return;
+	}
+
+	if (cli_output_path.is_empty()) {
+		stop();
+	}
+	if (EngineDebugger::get_singleton()) {
+		EngineDebugger::get_singleton()->send_message("gdscript_sampling:folded", Array{ get_folded_stacks(), get_sample_count() });
+	}
+}
+
+void GDScriptSamplingProfiler::register_debugger_profiler() {
+	if (EngineDebugger::has_profiler("gdscript_sampling")) {
+		return;
+	}
+	EngineDebugger::register_profiler("gdscript_sampling", EngineDebugger::Profiler(nullptr, &GDScriptSamplingProfiler::_profiler_toggle, nullptr, nullptr));
+}
+
+void GDScriptSamplingProfiler::unregister_debugger_profiler() {
+	if (EngineDebugger::has_profiler("gdscript_sampling")) {
+		EngineDebugger::unregister_profiler("gdscript_sampling");
+	}
+}
+
+#endif // DEBUG_ENABLED
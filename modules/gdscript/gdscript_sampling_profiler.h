@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG_ENABLED
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class Array;
+
+// Statistical profiler for GDScript, meant to stay cheap enough to leave running on hot code.
+// The timer thread never reads another thread's stack: it only bumps a tick counter,
+// and every thread running script code records its own stack at the next line it executes.
+// That sample is weighted by the number of ticks since the thread's previous one.
+class GDScriptSamplingProfiler {
+	static inline SafeNumeric<uint32_t> sample_request{ 0 };
+	static inline thread_local uint32_t sample_seen = 0;
+	static inline uint32_t start_request = 0;
+
+	static inline SafeFlag running{ false };
+	static inline bool native_frames = false;
+	static inline uint64_t interval_usec = 1000;
+	static inline Thread timer_thread;
+
+	// Native frames are kept as addresses while sampling, and only looked up when the profile is exported.
+	struct Stack {
+		String thread;
+		LocalVector<String> script_frames; // Innermost first.
+		LocalVector<void *> native_frames; // Innermost first.
+		uint64_t ticks = 0;
+	};
+
+	static inline Mutex mutex;
+	static inline HashMap<String, Stack> stacks;
+	static inline uint64_t sample_count = 0;
+
+	static inline Mutex symbol_mutex;
+	static inline HashMap<uint64_t, String> native_symbols;
+
+	static void _timer_thread_func(void *p_userdata);
+	static bool _init_native_frames();
+	static int _capture_native_frames(void **r_frames, int p_max);
+	static void _resolve_native_symbols(const LocalVector<void *> &p_addresses);
+	static void _set_native_symbol(void *p_address, const String &p_name);
+	static String _fold_stack(const Stack &p_stack);
+	static void _profiler_toggle(void *p_user, bool p_enable, const Array &p_opts);
+
+public:
+	static inline String cli_output_path; // Set with the `--script-profile <file>` command line argument.
+
+	// Called from the VM on every line, so this must stay a couple of loads and a compare.
+	_FORCE_INLINE_ static bool is_sample_requested() { return unlikely(sample_request.get() != sample_seen); }
+	static void take_sample();
+	// Called when a thread starts running script code, so the time it spent elsewhere isn't charged to its next sample.
+	_FORCE_INLINE_ static void enter_script() { sample_seen = sample_request.get(); }
+
+	static bool is_native_frames_supported();
+	static void start(uint64_t p_interval_usec, bool p_native_frames);
+	static void stop();
+	_FORCE_INLINE_ static bool is_running() { return running.is_set(); }
+
+	// Sum of the sample weights, in timer ticks.
+	static uint64_t get_sample_count();
+	// One line per distinct stack, "outermost;...;innermost count", as consumed by `flamegraph.pl` and compatible viewers.
+	static String get_folded_stacks();
+	static Error save_folded_stacks(const String &p_path);
+	static void clear();
+
+	static void register_debugger_profiler();
+	static void unregister_debugger_profiler();
+};
+
+#endif // DEBUG_ENABLED
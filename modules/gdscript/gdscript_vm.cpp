@@ -31,6 +31,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/object/class_db.h"
 #include "core/os/os.h"
@@ -256,6 +257,38 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR, \
 		&&OPCODE_OPERATOR_VALIDATED, \
+		&&OPCODE_OPERATOR_ADD_INT, \
+		&&OPCODE_OPERATOR_SUBTRACT_INT, \
+		&&OPCODE_OPERATOR_MULTIPLY_INT, \
+		&&OPCODE_OPERATOR_EQUAL_INT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT, \
+		&&OPCODE_OPERATOR_LESS_INT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT, \
+		&&OPCODE_OPERATOR_GREATER_INT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT, \
+		&&OPCODE_OPERATOR_ADD_FLOAT, \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT, \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT, \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_LESS_FLOAT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_GREATER_FLOAT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_INT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_INT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_NOT_EQUAL_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3, \
+		&&OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3_FLOAT, \
 		&&OPCODE_TYPE_TEST_BUILTIN, \
 		&&OPCODE_TYPE_TEST_ARRAY, \
 		&&OPCODE_TYPE_TEST_DICTIONARY, \
@@ -666,6 +699,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	String err_text;
 #endif
 
+#ifdef DEBUG_ENABLED
+	if (GDScriptLanguage::_call_stack_size == 0) {
+		GDScriptSamplingProfiler::enter_script();
+	}
+#endif
+
 	GDScriptLanguage::CallLevel call_level;
 	GDScriptLanguage::get_singleton()->enter_function(&call_level, p_instance, this, stack, &ip, &line);
 
@@ -859,6 +898,102 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_SPECIALIZED(m_name, m_v_type, m_c_type, m_ret_type, m_op) \
+	OPCODE(OPCODE_OPERATOR_##m_name##_##m_v_type) { \
+		CHECK_SPACE(5); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		VariantInternalAccessor<m_ret_type>::get(dst) = VariantInternalAccessor<m_c_type>::get(a) m_op VariantInternalAccessor<m_c_type>::get(b); \
+		ip += 5; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_SPECIALIZED(ADD, INT, int64_t, int64_t, +);
+			OPCODE_OPERATOR_SPECIALIZED(SUBTRACT, INT, int64_t, int64_t, -);
+			OPCODE_OPERATOR_SPECIALIZED(MULTIPLY, INT, int64_t, int64_t, *);
+			OPCODE_OPERATOR_SPECIALIZED(EQUAL, INT, int64_t, bool, ==);
+			OPCODE_OPERATOR_SPECIALIZED(NOT_EQUAL, INT, int64_t, bool, !=);
+			OPCODE_OPERATOR_SPECIALIZED(LESS, INT, int64_t, bool, <);
+			OPCODE_OPERATOR_SPECIALIZED(LESS_EQUAL, INT, int64_t, bool, <=);
+			OPCODE_OPERATOR_SPECIALIZED(GREATER, INT, int64_t, bool, >);
+			OPCODE_OPERATOR_SPECIALIZED(GREATER_EQUAL, INT, int64_t, bool, >=);
+			OPCODE_OPERATOR_SPECIALIZED(ADD, FLOAT, double, double, +);
+			OPCODE_OPERATOR_SPECIALIZED(SUBTRACT, FLOAT, double, double, -);
+			OPCODE_OPERATOR_SPECIALIZED(MULTIPLY, FLOAT, double, double, *);
+			OPCODE_OPERATOR_SPECIALIZED(EQUAL, FLOAT, double, bool, ==);
+			OPCODE_OPERATOR_SPECIALIZED(NOT_EQUAL, FLOAT, double, bool, !=);
+			OPCODE_OPERATOR_SPECIALIZED(LESS, FLOAT, double, bool, <);
+			OPCODE_OPERATOR_SPECIALIZED(LESS_EQUAL, FLOAT, double, bool, <=);
+			OPCODE_OPERATOR_SPECIALIZED(GREATER, FLOAT, double, bool, >);
+			OPCODE_OPERATOR_SPECIALIZED(GREATER_EQUAL, FLOAT, double, bool, >=);
+
+#define OPCODE_JUMP_IF_NOT_SPECIALIZED(m_name, m_v_type, m_c_type, m_op) \
+	OPCODE(OPCODE_JUMP_IF_NOT_##m_name##_##m_v_type) { \
+		CHECK_SPACE(6); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		const bool result = VariantInternalAccessor<m_c_type>::get(a) m_op VariantInternalAccessor<m_c_type>::get(b); \
+		VariantInternalAccessor<bool>::get(dst) = result; \
+		if (!result) { \
+			int to = _code_ptr[ip + 5]; \
+			GD_ERR_BREAK(to < 0 || to > _code_size); \
+			ip = to; \
+		} else { \
+			ip += 6; \
+		} \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(EQUAL, INT, int64_t, ==);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(NOT_EQUAL, INT, int64_t, !=);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(LESS, INT, int64_t, <);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(LESS_EQUAL, INT, int64_t, <=);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(GREATER, INT, int64_t, >);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(GREATER_EQUAL, INT, int64_t, >=);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(EQUAL, FLOAT, double, ==);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(NOT_EQUAL, FLOAT, double, !=);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(LESS, FLOAT, double, <);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(LESS_EQUAL, FLOAT, double, <=);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(GREATER, FLOAT, double, >);
+			OPCODE_JUMP_IF_NOT_SPECIALIZED(GREATER_EQUAL, FLOAT, double, >=);
+
+			OPCODE(OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3) {
+				CHECK_SPACE(8);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(product, 2);
+				GET_VARIANT_PTR(c, 4);
+				GET_VARIANT_PTR(dst, 5);
+
+				// The product is still stored, so the result is the same as running both operators.
+				const Vector3 result = VariantInternalAccessor<Vector3>::get(a) * VariantInternalAccessor<Vector3>::get(b);
+				VariantInternalAccessor<Vector3>::get(product) = result;
+				VariantInternalAccessor<Vector3>::get(dst) = result + VariantInternalAccessor<Vector3>::get(c);
+
+				ip += 8;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_MULTIPLY_ADD_VECTOR3_FLOAT) {
+				CHECK_SPACE(8);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(product, 2);
+				GET_VARIANT_PTR(c, 4);
+				GET_VARIANT_PTR(dst, 5);
+
+				const Vector3 result = VariantInternalAccessor<Vector3>::get(a) * VariantInternalAccessor<double>::get(b);
+				VariantInternalAccessor<Vector3>::get(product) = result;
+				VariantInternalAccessor<Vector3>::get(dst) = result + VariantInternalAccessor<Vector3>::get(c);
+
+				ip += 8;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -3921,6 +4056,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+#ifdef DEBUG_ENABLED
+				// Sampled before moving on, so the time is charged to the line that just ran.
+				if (GDScriptSamplingProfiler::is_sample_requested()) {
+					GDScriptSamplingProfiler::take_sample();
+				}
+#endif
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -31,6 +31,7 @@
 #include "register_types.h"
 
 #include "gdscript.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_resource_format.h"
@@ -191,6 +192,7 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 		resource_saver_gd.unref();
 
 		GDScriptParser::cleanup();
+		GDScriptBytecodeCache::clear();
 		GDScriptUtilityFunctions::unregister_functions();
 	}
 
@@ -54,6 +54,10 @@ public:
 	static bool has_full(String p_path) {
 		return GDScriptCache::singleton->full_gdscript_cache.has(p_path);
 	}
+
+	static int get_parsed_script_count() {
+		return GDScriptCache::singleton->parsed_scripts.size();
+	}
 };
 
 // TODO: Handle some cases failing on release builds. See: https://github.com/godotengine/godot/pull/88452
@@ -113,6 +117,35 @@ TEST_CASE("[Modules][GDScript] Loading keeps ResourceCache and GDScriptCache in
 	CHECK(TestGDScriptCacheAccessor::has_full(path));
 }
 
+TEST_CASE("[Modules][GDScript] Dependencies parsed ahead compile like the others") {
+	GDScriptLanguage::get_singleton()->init();
+	const String main_path = TestUtils::get_temp_path("gdscript_parse_main.gd");
+	const String a_path = TestUtils::get_temp_path("gdscript_parse_a.gd");
+	const String b_path = TestUtils::get_temp_path("gdscript_parse_b.gd");
+	const String c_path = TestUtils::get_temp_path("gdscript_parse_c.gd");
+
+	const auto write_script = [](const String &p_path, const String &p_source) {
+		Ref<FileAccess> fa = FileAccess::open(p_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string(p_source);
+		fa->close();
+	};
+	write_script(a_path, "extends RefCounted\n\nfunc value() -> int:\n\treturn 1\n");
+	write_script(b_path, "extends RefCounted\n\nfunc value() -> int:\n\treturn 10\n");
+	write_script(c_path, vformat("extends \"%s\"\n\nfunc value() -> int:\n\treturn super() + 100\n", b_path));
+	write_script(main_path, vformat("extends RefCounted\n\nconst A = preload(\"%s\")\nconst C = preload(\"%s\")\n\nfunc run() -> int:\n\treturn A.new().value() + C.new().value()\n", a_path, c_path));
+
+	Ref<GDScript> loaded = ResourceLoader::load(main_path);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->is_script_valid());
+	CHECK(TestGDScriptCacheAccessor::has_full(a_path));
+	CHECK(TestGDScriptCacheAccessor::has_full(c_path));
+	CHECK_MESSAGE(TestGDScriptCacheAccessor::get_parsed_script_count() == 0, "Scripts parsed ahead should be taken or dropped once their dependent compiled.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(loaded);
+	CHECK(int64_t(ref_counted->call("run")) == 111);
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,218 @@
+/**************************************************************************/
+/*  test_bytecode_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+static const char *bytecode_cache_test_source = R"(
+extends RefCounted
+
+class Inner:
+	var value := 2
+
+	func twice() -> int:
+		return value * 2
+
+const NAMES = ["a", "b"]
+static var created := 0
+var counter := 0
+
+func _init():
+	created += 1
+	var inner := Inner.new()
+	var add := func(x: int) -> int: return x + counter + inner.twice()
+	counter = 10
+	set_meta("result", add.call(NAMES.size()) + int(Vector2(3, 4).length()))
+)";
+
+static Ref<GDScript> bytecode_cache_make_script(const String &p_path, const String &p_source) {
+	Ref<GDScript> gdscript;
+	gdscript.instantiate();
+	gdscript->set_source_code(p_source);
+	gdscript->set_path_cache(p_path);
+	return gdscript;
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache round trip") {
+	GDScriptLanguage::get_singleton()->init();
+	const String path = "res://bytecode_cache_round_trip.gd";
+
+	Ref<GDScript> compiled = bytecode_cache_make_script(path, bytecode_cache_test_source);
+	ERR_PRINT_OFF;
+	const Error error = compiled->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Vector<uint8_t> buffer;
+	REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), HashSet<String>(), buffer) == OK);
+	CHECK(buffer.size() > 0);
+
+	Ref<GDScript> loaded = bytecode_cache_make_script(path, bytecode_cache_test_source);
+	REQUIRE(GDScriptBytecodeCache::deserialize(loaded.ptr(), buffer) == OK);
+	CHECK(loaded->is_script_valid());
+	CHECK(loaded->get_subclasses().has("Inner"));
+	CHECK(loaded->get_lambda_info().size() == 1);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(loaded);
+	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 21, "Code loaded from the cache should run like freshly compiled code.");
+	CHECK(int(loaded->get("created")) == 1);
+
+	SUBCASE("Compiled scripts are not overwritten") {
+		CHECK(GDScriptBytecodeCache::deserialize(compiled.ptr(), buffer) == ERR_ALREADY_IN_USE);
+	}
+
+	SUBCASE("Stale entries are rejected") {
+		Ref<GDScript> changed = bytecode_cache_make_script(path, String(bytecode_cache_test_source) + "\nvar extra := 1\n");
+		CHECK(GDScriptBytecodeCache::deserialize(changed.ptr(), buffer) == ERR_INVALID_DATA);
+		CHECK(!changed->is_script_valid());
+	}
+
+	SUBCASE("Corrupted entries are rejected") {
+		Vector<uint8_t> corrupted = buffer;
+		corrupted.write[corrupted.size() / 2] ^= 0xFF;
+		Ref<GDScript> fresh = bytecode_cache_make_script(path, bytecode_cache_test_source);
+		CHECK(GDScriptBytecodeCache::deserialize(fresh.ptr(), corrupted) == ERR_INVALID_DATA);
+
+		Vector<uint8_t> truncated = buffer;
+		truncated.resize(buffer.size() - 8);
+		CHECK(GDScriptBytecodeCache::deserialize(fresh.ptr(), truncated) == ERR_INVALID_DATA);
+		CHECK(!fresh->is_script_valid());
+	}
+
+	GDScriptCache::remove_script(path);
+}
+
+#ifdef DEBUG_ENABLED
+static void _bytecode_cache_print_disassembly(void *p_instructions, const String &p_message, bool p_error, bool p_rich) {
+	((Vector<String> *)p_instructions)->push_back(p_message.strip_edges());
+}
+
+// Returns the code position of the first instruction starting with `p_prefix`, or -1.
+static int _bytecode_cache_find_instruction(const Vector<String> &p_instructions, const String &p_prefix) {
+	for (const String &instruction : p_instructions) {
+		const int separator = instruction.find(": ");
+		if (instruction.substr(separator + 2).begins_with(p_prefix)) {
+			return instruction.substr(0, separator).to_int();
+		}
+	}
+	return -1;
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache rejects invalid code") {
+	GDScriptLanguage::get_singleton()->init();
+	const String path = "res://bytecode_cache_invalid_code.gd";
+	const String source = R"(
+extends RefCounted
+
+func marker(count: int) -> String:
+	var text := "bytecode_cache_marker"
+	while count > 0:
+		count -= 1
+	return text
+)";
+
+	Ref<GDScript> compiled = bytecode_cache_make_script(path, source);
+	ERR_PRINT_OFF;
+	const Error error = compiled->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Vector<uint8_t> buffer;
+	REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), HashSet<String>(), buffer) == OK);
+
+	Vector<String> instructions;
+	PrintHandlerList handler;
+	handler.printfunc = _bytecode_cache_print_disassembly;
+	handler.userdata = &instructions;
+	add_print_handler(&handler);
+	const bool stdout_enabled = OS::get_singleton()->is_stdout_enabled();
+	OS::get_singleton()->set_stdout_enabled(false);
+	compiled->get_member_functions()["marker"]->disassemble(Vector<String>());
+	OS::get_singleton()->set_stdout_enabled(stdout_enabled);
+	remove_print_handler(&handler);
+
+	const int code_size = _bytecode_cache_find_instruction(instructions, "== END ==") + 1;
+	const int jump = _bytecode_cache_find_instruction(instructions, "jump ");
+	const int ret = _bytecode_cache_find_instruction(instructions, "return");
+	REQUIRE(code_size > 0);
+	REQUIRE(jump >= 0);
+	REQUIRE(ret >= 0);
+
+	// The string constant is the first one, written right after the code and the (empty) default arguments:
+	// the argument count, the constant count, a tag, a length, and the encoded variant's type and length.
+	const CharString marker = String("bytecode_cache_marker").utf8();
+	int marker_pos = -1;
+	for (int i = 0; i + marker.length() <= buffer.size() && marker_pos == -1; i++) {
+		if (memcmp(buffer.ptr() + i, marker.get_data(), marker.length()) == 0) {
+			marker_pos = i;
+		}
+	}
+	REQUIRE(marker_pos > 0);
+	const int code_pos = marker_pos - 21 - code_size * 4;
+	REQUIRE(code_pos >= 4);
+	REQUIRE(decode_uint32(buffer.ptr() + code_pos - 4) == uint32_t(code_size));
+
+	// Deserializes a copy with one code word replaced, keeping the payload hash valid.
+	auto load_with = [&](int p_word, int p_value) {
+		Vector<uint8_t> changed = buffer;
+		encode_uint32(p_value, changed.ptrw() + code_pos + p_word * 4);
+		encode_uint32(hash_djb2_buffer(changed.ptr() + 16, changed.size() - 16), changed.ptrw() + 12);
+		Ref<GDScript> fresh = bytecode_cache_make_script(path, source);
+		const Error result = GDScriptBytecodeCache::deserialize(fresh.ptr(), changed);
+		CHECK(fresh->is_script_valid() == (result == OK));
+		return result;
+	};
+
+	const int jump_target = decode_uint32(buffer.ptr() + code_pos + (jump + 1) * 4);
+	CHECK_MESSAGE(load_with(jump + 1, jump_target) == OK, "Rewriting a word with its own value should keep the entry valid.");
+	CHECK_MESSAGE(load_with(jump + 1, code_size + 8) == ERR_INVALID_DATA, "Jumps past the end should be rejected.");
+	CHECK_MESSAGE(load_with(jump + 1, jump + 1) == ERR_INVALID_DATA, "Jumps into an instruction should be rejected.");
+	CHECK_MESSAGE(load_with(ret + 1, 1000) == ERR_INVALID_DATA, "Stack addresses past the stack size should be rejected.");
+	CHECK_MESSAGE(load_with(ret + 1, (GDScriptFunction::ADDR_TYPE_CONSTANT << GDScriptFunction::ADDR_BITS) | 1000) == ERR_INVALID_DATA, "Missing constants should be rejected.");
+	CHECK_MESSAGE(load_with(ret + 1, GDScriptFunction::ADDR_TYPE_MAX << GDScriptFunction::ADDR_BITS) == ERR_INVALID_DATA, "Unknown address types should be rejected.");
+	CHECK_MESSAGE(load_with(code_size - 1, GDScriptFunction::OPCODE_JUMP) == ERR_INVALID_DATA, "Instructions running past the end should be rejected.");
+	CHECK_MESSAGE(load_with(code_size - 1, GDScriptFunction::OPCODE_END + 1) == ERR_INVALID_DATA, "Unknown opcodes should be rejected.");
+
+	GDScriptCache::remove_script(path);
+}
+#endif // DEBUG_ENABLED
+
+} // namespace GDScriptTests
@@ -0,0 +1,172 @@
+/**************************************************************************/
+/*  test_sampling_profiler.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG_ENABLED
+
+#include "../gdscript.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+static Ref<RefCounted> _create_sampled_instance() {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func inner(count: int) -> int:
+	var total := 0
+	for i in count:
+		total += i % 7
+	return total
+
+func outer(count: int) -> int:
+	var total := 0
+	for i in 10:
+		total += inner(count)
+	return total
+
+func slow() -> int:
+	OS.delay_msec(50)
+	return 0
+
+func fast() -> int:
+	var value := 1
+	return value
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	CHECK(error == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	return ref_counted;
+}
+
+static void _run_until_sampled(const Ref<RefCounted> &p_instance) {
+	// Samples are only taken on line boundaries, keep the script busy until a few have been recorded.
+	const uint64_t begin = OS::get_singleton()->get_ticks_msec();
+	while (GDScriptSamplingProfiler::get_sample_count() < 10 && OS::get_singleton()->get_ticks_msec() - begin < 5000) {
+		p_instance->call("outer", 1000);
+	}
+}
+
+static uint64_t _get_sampled_ticks(const String &p_folded, const String &p_frame) {
+	uint64_t ticks = 0;
+	for (const String &line : p_folded.split("\n", false)) {
+		if (line.contains(";" + p_frame + " (")) {
+			ticks += line.substr(line.rfind_char(' ') + 1).to_int();
+		}
+	}
+	return ticks;
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler records script stacks") {
+	Ref<RefCounted> ref_counted = _create_sampled_instance();
+
+	SUBCASE("Script frames only") {
+		GDScriptSamplingProfiler::clear();
+		GDScriptSamplingProfiler::start(100, false);
+		_run_until_sampled(ref_counted);
+		GDScriptSamplingProfiler::stop();
+
+		CHECK(GDScriptSamplingProfiler::get_sample_count() >= 10);
+		const String folded = GDScriptSamplingProfiler::get_folded_stacks();
+		CHECK(folded.contains(";outer ("));
+		CHECK(folded.contains(";inner ("));
+
+		uint64_t total = 0;
+		for (const String &line : folded.split("\n", false)) {
+			CHECK_MESSAGE(line.begins_with("main;"), "Stacks are rooted at the thread they were sampled on.");
+			const int space = line.rfind_char(' ');
+			REQUIRE(space != -1);
+			total += line.substr(space + 1).to_int();
+			// Callers come first, as expected by flame graph tools.
+			if (line.contains("inner (")) {
+				CHECK(line.find("outer (") < line.find("inner ("));
+			}
+		}
+		CHECK(total == GDScriptSamplingProfiler::get_sample_count());
+	}
+
+	SUBCASE("Native frames") {
+		GDScriptSamplingProfiler::clear();
+		ERR_PRINT_OFF;
+		GDScriptSamplingProfiler::start(100, true);
+		ERR_PRINT_ON;
+		_run_until_sampled(ref_counted);
+		GDScriptSamplingProfiler::stop();
+
+		// Whether or not native symbols can be resolved, script frames must be kept in order.
+		const String folded = GDScriptSamplingProfiler::get_folded_stacks();
+		CHECK(folded.contains(";outer ("));
+		CHECK(folded.contains(";inner ("));
+		CHECK_FALSE(folded.contains("GDScriptFunction::call"));
+		if (GDScriptSamplingProfiler::is_native_frames_supported()) {
+			CHECK_MESSAGE(folded.contains(";Object::callp;"), "Engine frames between the test and the script should be named.");
+		}
+	}
+
+	SUBCASE("Samples are weighted by elapsed time") {
+		GDScriptSamplingProfiler::clear();
+		GDScriptSamplingProfiler::start(1000, false);
+		ref_counted->call("slow");
+		// Time spent outside of scripts must not be charged to the next line that runs.
+		OS::get_singleton()->delay_usec(50'000);
+		ref_counted->call("fast");
+		GDScriptSamplingProfiler::stop();
+
+		const String folded = GDScriptSamplingProfiler::get_folded_stacks();
+		const uint64_t slow_ticks = _get_sampled_ticks(folded, "slow");
+		const uint64_t fast_ticks = _get_sampled_ticks(folded, "fast");
+		CHECK_MESSAGE(slow_ticks >= 10, "A line blocking for 50 msec should stand for many ticks, not a single sample.");
+		CHECK(fast_ticks < slow_ticks / 2);
+	}
+
+	SUBCASE("Nothing is recorded once stopped") {
+		GDScriptSamplingProfiler::clear();
+		GDScriptSamplingProfiler::start(100, false);
+		GDScriptSamplingProfiler::stop();
+		GDScriptSamplingProfiler::clear();
+		ref_counted->call("outer", 1000);
+		CHECK(GDScriptSamplingProfiler::get_sample_count() == 0);
+		CHECK(GDScriptSamplingProfiler::get_folded_stacks().is_empty());
+	}
+}
+
+} // namespace GDScriptTests
+
+#endif // DEBUG_ENABLED
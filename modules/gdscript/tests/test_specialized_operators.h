@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  test_specialized_operators.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+TEST_CASE("[Modules][GDScript] Specialized operators keep typed results") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func sum(count: int) -> int:
+	var total := 0
+	var i := 0
+	while i < count:
+		if i != 3 and i * 2 >= 4:
+			total += i * i - 1
+		i += 1
+	return total
+
+func lerp_steps(steps: int) -> float:
+	var value := 0.5
+	for i in steps:
+		if value <= 100.0 and value > -1.0:
+			value = value * 1.5 - 0.25 + 0.125
+	return value
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	int64_t expected_sum = 0;
+	for (int64_t i = 0; i < 50; i++) {
+		if (i != 3 && i * 2 >= 4) {
+			expected_sum += i * i - 1;
+		}
+	}
+	CHECK(int64_t(ref_counted->call("sum", 50)) == expected_sum);
+
+	double expected_lerp = 0.5;
+	for (int i = 0; i < 20; i++) {
+		if (expected_lerp <= 100.0 && expected_lerp > -1.0) {
+			expected_lerp = expected_lerp * 1.5 - 0.25 + 0.125;
+		}
+	}
+	CHECK(double(ref_counted->call("lerp_steps", 20)) == expected_lerp);
+}
+
+} // namespace GDScriptTests
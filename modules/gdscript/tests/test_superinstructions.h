@@ -0,0 +1,316 @@
+/**************************************************************************/
+/*  test_superinstructions.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_byte_codegen.h"
+#include "../gdscript_function.h"
+
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+static Ref<GDScript> _compile_superinstruction_script(const String &p_source, bool p_fuse = true) {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	GDScriptByteCodeGenerator::superinstructions_enabled = p_fuse;
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	GDScriptByteCodeGenerator::superinstructions_enabled = true;
+	CHECK(error == OK);
+	return gdscript;
+}
+
+#ifdef DEBUG_ENABLED
+static void _print_disassembly(void *p_instructions, const String &p_message, bool p_error, bool p_rich) {
+	((Vector<String> *)p_instructions)->push_back(p_message);
+}
+
+// Returns the disassembled instructions of a member function, without their code positions.
+static Vector<String> _disassemble_superinstruction_function(const Ref<GDScript> &p_script, const StringName &p_function) {
+	Vector<String> instructions;
+	const GDScriptFunction *function = p_script->get_member_functions()[p_function];
+	REQUIRE(function != nullptr);
+
+	PrintHandlerList handler;
+	handler.printfunc = _print_disassembly;
+	handler.userdata = &instructions;
+	add_print_handler(&handler);
+	const bool stdout_enabled = OS::get_singleton()->is_stdout_enabled();
+	OS::get_singleton()->set_stdout_enabled(false);
+	function->disassemble(Vector<String>());
+	OS::get_singleton()->set_stdout_enabled(stdout_enabled);
+	remove_print_handler(&handler);
+
+	for (int i = 0; i < instructions.size(); i++) {
+		instructions.write[i] = instructions[i].substr(instructions[i].find(": ") + 2);
+	}
+	return instructions;
+}
+
+static int _count_instructions(const Vector<String> &p_instructions, const String &p_prefix) {
+	int count = 0;
+	for (const String &instruction : p_instructions) {
+		count += instruction.begins_with(p_prefix) ? 1 : 0;
+	}
+	return count;
+}
+#endif // DEBUG_ENABLED
+
+TEST_CASE("[Modules][GDScript] Fused instructions keep results") {
+	Ref<GDScript> gdscript = _compile_superinstruction_script(R"(
+extends RefCounted
+
+func count_branches(count: int) -> int:
+	var hits := 0
+	var i := 0
+	while i < count:
+		if i == 3:
+			hits += 100
+		elif i >= count - 2:
+			hits += 10
+		elif i != 5:
+			hits += 1
+		i += 1
+	return hits
+
+func compare_floats(a: float, b: float) -> int:
+	var result := 0
+	if a < b:
+		result += 1
+	if a <= b:
+		result += 2
+	if a > b:
+		result += 4
+	if a >= b:
+		result += 8
+	if a == b:
+		result += 16
+	if a != b:
+		result += 32
+	return result
+
+func step(steps: int, delta: float) -> Vector3:
+	var position := Vector3(1, 2, 3)
+	var velocity := Vector3(0.5, -1, 2)
+	var scale := Vector3(1, 0.5, 2)
+	for i in steps:
+		position += velocity * delta
+		position = delta * velocity + position
+		position = position * scale + velocity * delta
+		velocity -= Vector3(0, 0.25, 0)
+	return position
+
+func accumulate(count: int) -> float:
+	var value := 1.5
+	var sum := 0.0
+	for i in count:
+		value *= 1.01
+		sum += value
+		sum -= 0.5
+	return sum
+)");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	int64_t expected_hits = 0;
+	for (int64_t i = 0; i < 20; i++) {
+		if (i == 3) {
+			expected_hits += 100;
+		} else if (i >= 18) {
+			expected_hits += 10;
+		} else if (i != 5) {
+			expected_hits += 1;
+		}
+	}
+	CHECK(int64_t(ref_counted->call("count_branches", 20)) == expected_hits);
+	CHECK(int64_t(ref_counted->call("count_branches", 0)) == 0);
+
+	CHECK(int64_t(ref_counted->call("compare_floats", 1.0, 2.0)) == 1 + 2 + 32);
+	CHECK(int64_t(ref_counted->call("compare_floats", 2.0, 2.0)) == 2 + 8 + 16);
+	CHECK(int64_t(ref_counted->call("compare_floats", 3.0, 2.0)) == 4 + 8 + 32);
+	CHECK_MESSAGE(int64_t(ref_counted->call("compare_floats", Math::NaN, 2.0)) == 32, "Comparisons with NaN should only take the not equal branch.");
+
+	const double delta = 0.1;
+	Vector3 position(1, 2, 3);
+	Vector3 velocity(0.5, -1, 2);
+	const Vector3 scale(1, 0.5, 2);
+	for (int i = 0; i < 10; i++) {
+		position += velocity * delta;
+		position = delta * velocity + position;
+		position = position * scale + velocity * delta;
+		velocity -= Vector3(0, 0.25, 0);
+	}
+	CHECK(Vector3(ref_counted->call("step", 10, delta)) == position);
+
+	double value = 1.5;
+	double sum = 0.0;
+	for (int i = 0; i < 30; i++) {
+		value *= 1.01;
+		sum += value;
+		sum -= 0.5;
+	}
+	CHECK(double(ref_counted->call("accumulate", 30)) == sum);
+}
+
+TEST_CASE("[Modules][GDScript] Assignments are only fused into typed operands") {
+	Ref<GDScript> gdscript = _compile_superinstruction_script(R"(
+extends RefCounted
+
+func declare(a: int, b: int) -> int:
+	var sum: int = a + b
+	var other := sum * 2
+	return other
+
+func untyped(a: int) -> Variant:
+	var value = "text"
+	value = a + 1
+	return value
+
+func narrowing(a: float) -> int:
+	var value := 1
+	@warning_ignore("narrowing_conversion")
+	value += a
+	return value
+)");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	CHECK(int64_t(ref_counted->call("declare", 2, 3)) == 10);
+	const Variant untyped = ref_counted->call("untyped", 4);
+	CHECK(untyped.get_type() == Variant::INT);
+	CHECK(int64_t(untyped) == 5);
+	CHECK(int64_t(ref_counted->call("narrowing", 2.5)) == 3);
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Superinstructions are emitted") {
+	const String source = R"(
+extends RefCounted
+
+func count_branches(count: int) -> int:
+	var hits := 0
+	var i := 0
+	while i < count:
+		if i == 3:
+			hits += 100
+		elif i >= count - 2:
+			hits += 10
+		i += 1
+	return hits
+
+func step(steps: int, delta: float) -> Vector3:
+	var position := Vector3(1, 2, 3)
+	var velocity := Vector3(0.5, -1, 2)
+	for i in steps:
+		position += velocity * delta
+	return position
+)";
+	Ref<GDScript> fused = _compile_superinstruction_script(source);
+	Ref<GDScript> unfused = _compile_superinstruction_script(source, false);
+
+	const Vector<String> count_branches = _disassemble_superinstruction_function(fused, "count_branches");
+	const Vector<String> count_branches_unfused = _disassemble_superinstruction_function(unfused, "count_branches");
+	CHECK_MESSAGE(_count_instructions(count_branches, "int compare ") == 3, "The loop condition and both branches should compare and jump in one instruction.");
+	CHECK(_count_instructions(count_branches, "jump-if-not ") == 0);
+	CHECK(_count_instructions(count_branches_unfused, "int compare ") == 0);
+	CHECK(_count_instructions(count_branches_unfused, "jump-if-not ") == 3);
+
+	// `hits += 100`, `hits += 10` and `i += 1` write their result in place instead of through a temporary.
+	CHECK(_count_instructions(count_branches_unfused, "assign ") - _count_instructions(count_branches, "assign ") == 3);
+	bool found_increment = false;
+	for (int i = 0; i < count_branches.size(); i++) {
+		const String &instruction = count_branches[i];
+		if (!instruction.begins_with("int operator ") || !instruction.ends_with(" + const(1)")) {
+			continue;
+		}
+		// The target and the left operand are both `i`.
+		const String target = instruction.trim_prefix("int operator ").get_slicec(' ', 0);
+		if (!instruction.contains(" = " + target + " + ")) {
+			continue;
+		}
+		found_increment = true;
+		CHECK_MESSAGE((i + 1 == count_branches.size() || !count_branches[i + 1].begins_with("assign ")), "No assignment should follow the fused increment.");
+	}
+	CHECK(found_increment);
+
+	const Vector<String> step = _disassemble_superinstruction_function(fused, "step");
+	const Vector<String> step_unfused = _disassemble_superinstruction_function(unfused, "step");
+	CHECK(_count_instructions(step, "multiply-add ") == 1);
+	CHECK(_count_instructions(step_unfused, "multiply-add ") == 0);
+	CHECK(_count_instructions(step_unfused, "assign ") - _count_instructions(step, "assign ") == 1);
+}
+#endif // DEBUG_ENABLED
+
+BENCHMARK_CASE("[Modules][GDScript][Benchmark] Fused instructions") {
+	// The same code compiled without superinstructions gives the baseline.
+	const String source = R"(
+extends RefCounted
+
+func loop(count: int) -> int:
+	var total := 0
+	var i := 0
+	while i < count:
+		if i > 10:
+			total += 2
+		i += 1
+	return total
+
+func integrate(count: int) -> Vector3:
+	var position := Vector3()
+	var velocity := Vector3(1, 2, 3)
+	var delta := 0.016
+	for i in count:
+		position += velocity * delta
+	return position
+)";
+	Ref<RefCounted> fused = memnew(RefCounted);
+	fused->set_script(_compile_superinstruction_script(source));
+	Ref<RefCounted> unfused = memnew(RefCounted);
+	unfused->set_script(_compile_superinstruction_script(source, false));
+
+	const int iterations = 5'000'000;
+	for (const StringName &method : { StringName("loop"), StringName("integrate") }) {
+		const uint64_t unfused_usec = TestBenchmark::measure_usec([&]() { unfused->call(method, iterations); });
+		const uint64_t fused_usec = TestBenchmark::measure_usec([&]() { fused->call(method, iterations); });
+		CHECK(fused->call(method, iterations) == unfused->call(method, iterations));
+		TestBenchmark::report_comparison(vformat("%s, unfused before, fused after", method), unfused_usec, fused_usec);
+	}
+}
+
+} // namespace GDScriptTests
@@ -684,6 +684,19 @@ void GodotPhysicsServer3D::body_set_state(RID p_body, PS3DE::BodyState p_state,
 	body->set_state(p_state, p_variant);
 }
 
+void GodotPhysicsServer3D::bodies_set_state(const Vector<RID> &p_bodies, PS3DE::BodyState p_state, const Vector<Variant> &p_values) {
+	ERR_FAIL_COND(p_bodies.size() != p_values.size());
+
+	const RID *bodies = p_bodies.ptr();
+	const Variant *values = p_values.ptr();
+	for (int i = 0; i < p_bodies.size(); i++) {
+		GodotBody3D *body = body_owner.get_or_null(bodies[i]);
+		ERR_CONTINUE(!body);
+
+		body->set_state(p_state, values[i]);
+	}
+}
+
 Variant GodotPhysicsServer3D::body_get_state(RID p_body, PS3DE::BodyState p_state) const {
 	GodotBody3D *body = body_owner.get_or_null(p_body);
 	ERR_FAIL_NULL_V(body, Variant());
@@ -206,6 +206,7 @@ public:
 	virtual void body_reset_mass_properties(RID p_body) override;
 
 	virtual void body_set_state(RID p_body, PS3DE::BodyState p_state, const Variant &p_variant) override;
+	virtual void bodies_set_state(const Vector<RID> &p_bodies, PS3DE::BodyState p_state, const Vector<Variant> &p_values) override;
 	virtual Variant body_get_state(RID p_body, PS3DE::BodyState p_state) const override;
 
 	virtual void body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) override;
@@ -35,6 +35,9 @@
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
+	// Setting up a single constraint is cheap, so threads take several at once.
+	static const uint32_t CONSTRAINT_SETUP_GRAIN_SIZE = 16;
+
 	uint64_t _step = 1;
 
 	int iterations = 0;
@@ -46,9 +49,9 @@ class GodotStep3D {
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _setup_constraint(uint32_t p_constraint_index);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _solve_island(uint32_t p_island_index);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
@@ -44,40 +44,16 @@
 #endif
 
 #ifdef CRASH_HANDLER_ENABLED
+#include "stack_trace_linuxbsd.h"
+
 #include <cxxabi.h>
 #include <dlfcn.h>
 #include <execinfo.h>
-#include <link.h>
 
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
 
-inline String find_addr2line_executable() {
-	List<String> args;
-	args.push_back("--version");
-	String output;
-	OS *os = OS::get_singleton();
-	int ret = 0;
-	Error err = OK;
-	// First, check for addr2line in the home directory's cargo bin.
-	if (os->has_environment("HOME")) {
-		// Faster implementation from gimli-rs/addr2line.
-		const String cargo_addr2line = os->get_environment("HOME").path_join(String("/.cargo/bin/addr2line"));
-		err = os->execute(cargo_addr2line, args, &output, &ret);
-		if (err == OK && ret == 0) {
-			return cargo_addr2line;
-		}
-	}
-	// Otherwise, check for llvm-addr2line.
-	err = os->execute(String("llvm-addr2line"), args, &output, &ret);
-	if (err == OK && ret == 0) {
-		return String("llvm-addr2line");
-	}
-	// Fallback guess if none of the above returned a definitive result.
-	return String("addr2line");
-}
-
 static void handle_crash(int sig) {
 	signal(SIGSEGV, SIG_DFL);
 	signal(SIGFPE, SIG_DFL);
@@ -121,14 +97,6 @@ static void handle_crash(int sig) {
 	}
 	print_error(vformat("Dumping the backtrace. %s", msg));
 	char **strings = backtrace_symbols(bt_buffer, size);
-	// PIE executable relocation, zero for non-PIE executables
-#ifdef __GLIBC__
-	// This is a glibc only thing apparently.
-	uintptr_t relocation = _r_debug.r_map->l_addr;
-#else
-	// Non glibc systems apparently don't give PIE relocation info.
-	uintptr_t relocation = 0;
-#endif //__GLIBC__
 
 	void *load_addr = nullptr;
 	{
@@ -141,27 +109,9 @@ static void handle_crash(int sig) {
 	print_error(vformat("Load address: %x\n", (uint64_t)load_addr));
 
 	if (strings) {
-		int ret;
-		const String exe_name = find_addr2line_executable();
-
-		List<String> args;
-		for (size_t i = 0; i < size; i++) {
-			char str[1024];
-			snprintf(str, 1024, "%p", (void *)((uintptr_t)bt_buffer[i] - relocation));
-			args.push_back(str);
-		}
-		args.push_back("-e");
-		args.push_back(exec_path);
-		args.push_back("-f");
-		args.push_back("-p");
-		args.push_back("-C");
-
 		// Try to get the file/line number using addr2line
-		String addr2line_output;
-		Error err = OS::get_singleton()->execute(exe_name, args, &addr2line_output, &ret);
-		if (err == OK) {
-			Vector<String> addr2line_results = addr2line_output.substr(0, addr2line_output.length() - 1).split("\n", false);
-
+		const Vector<String> addr2line_results = StackTraceLinuxBSD::symbolize_with_addr2line(exec_path, bt_buffer, size);
+		if (addr2line_results.size() >= (int)size) {
 			for (size_t i = 1; i < size; i++) {
 				String output = addr2line_results[i].replace("/./", "/");
 				String mod_name = "main";
@@ -35,6 +35,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/callable_mp.h"
 #include "core/object/class_db.h"
+#include "core/os/frame_arena.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
 #include "scene/animation/animation_player.h"
@@ -758,7 +759,7 @@ bool AnimationMixer::_update_caches() {
 
 						track_value->is_using_angle = anim->track_get_interpolation_type(i) == Animation::INTERPOLATION_LINEAR_ANGLE || anim->track_get_interpolation_type(i) == Animation::INTERPOLATION_CUBIC_ANGLE;
 
-						track_value->subpath = leftover_path;
+						track_value->subpath = PropertyPath(leftover_path);
 
 						track = track_value;
 
@@ -1686,7 +1687,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 							value = post_process_key_value(a, i, value, t->object_id);
 							Object *t_obj = ObjectDB::get_instance(t->object_id);
 							if (t_obj) {
-								t_obj->set_indexed(t->subpath, value);
+								t->subpath.set(t_obj, value);
 							}
 						} else {
 							LocalVector<int> indices;
@@ -1697,7 +1698,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 								value = post_process_key_value(a, i, value, t->object_id);
 								Object *t_obj = ObjectDB::get_instance(t->object_id);
 								if (t_obj) {
-									t_obj->set_indexed(t->subpath, value);
+									t->subpath.set(t_obj, value);
 								}
 							}
 						}
@@ -2017,7 +2018,7 @@ void AnimationMixer::_blend_apply() {
 
 				Object *t_obj = ObjectDB::get_instance(t->object_id);
 				if (t_obj) {
-					t_obj->set_indexed(t->subpath, Animation::cast_from_blendwise(t->value, t->init_value.get_type()));
+					t->subpath.set(t_obj, Animation::cast_from_blendwise(t->value, t->init_value.get_type()));
 				}
 
 			} break;
@@ -2025,11 +2026,11 @@ void AnimationMixer::_blend_apply() {
 				TrackCacheAudio *t = static_cast<TrackCacheAudio *>(track);
 
 				// Audio ending process.
-				LocalVector<ObjectID> erase_maps;
+				FrameLocalVector<ObjectID> erase_maps;
 				for (KeyValue<ObjectID, PlayingAudioTrackInfo> &L : t->playing_streams) {
 					PlayingAudioTrackInfo &track_info = L.value;
 					float db = Math::linear_to_db(track_info.use_blend ? track_info.volume : 1.0);
-					LocalVector<int> erase_streams;
+					FrameLocalVector<int> erase_streams;
 					AHashMap<int, PlayingAudioStreamInfo> &map = track_info.stream_info;
 					for (const KeyValue<int, PlayingAudioStreamInfo> &M : map) {
 						PlayingAudioStreamInfo pasi = M.value;
@@ -2243,7 +2244,7 @@ void AnimationMixer::_build_backup_track_cache() {
 				TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 				Object *t_obj = ObjectDB::get_instance(t->object_id);
 				if (t_obj) {
-					t->value = Animation::cast_to_blendwise(t_obj->get_indexed(t->subpath));
+					t->value = Animation::cast_to_blendwise(t->subpath.get(t_obj));
 				}
 				t->use_continuous = true;
 				t->use_discrete = false;
@@ -2287,7 +2288,7 @@ Ref<AnimatedValuesBackup> AnimationMixer::make_backup() {
 	make_animation_instance(SceneStringName(RESET), pi);
 	_build_backup_track_cache();
 
-	backup->set_data(AHashMap<Animation::TrackCacheID, TrackCache *, HashHasher>(track_cache));
+	backup->set_data(SwissHashMap<Animation::TrackCacheID, TrackCache *, HashHasher>(track_cache));
 	clear_animation_instances();
 
 	return backup;
@@ -2319,7 +2320,7 @@ void AnimationMixer::restore(const Ref<AnimatedValuesBackup> &p_backup) {
 	ERR_FAIL_COND(p_backup.is_null());
 	track_cache = p_backup->get_data();
 	_blend_apply();
-	track_cache = AHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher>();
+	track_cache = SwissHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher>();
 	cache_valid = false;
 }
 
@@ -2380,7 +2381,7 @@ void AnimationMixer::capture(const StringName &p_name, double p_duration, Tween:
 			TrackCacheValue *t = static_cast<TrackCacheValue *>(track_cache[reference_animation->track_get_unique_id(i)]);
 			Object *t_obj = ObjectDB::get_instance(t->object_id);
 			if (t_obj) {
-				Variant value = t_obj->get_indexed(t->subpath);
+				Variant value = t->subpath.get(t_obj);
 				int inserted_idx = capture_cache.animation->add_track(Animation::TYPE_VALUE);
 				capture_cache.animation->track_set_path(inserted_idx, reference_animation->track_get_path(i));
 				capture_cache.animation->track_insert_key(inserted_idx, 0, value);
@@ -2567,7 +2568,7 @@ AnimationMixer::AnimationMixer() {
 AnimationMixer::~AnimationMixer() {
 }
 
-void AnimatedValuesBackup::set_data(const AHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> &p_data) {
+void AnimatedValuesBackup::set_data(const SwissHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> &p_data) {
 	clear_data();
 
 	for (const KeyValue<Animation::TrackCacheID, AnimationMixer::TrackCache *> &E : p_data) {
@@ -2580,8 +2581,8 @@ void AnimatedValuesBackup::set_data(const AHashMap<Animation::TrackCacheID, Anim
 	}
 }
 
-AHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> AnimatedValuesBackup::get_data() const {
-	AHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> ret;
+SwissHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> AnimatedValuesBackup::get_data() const {
+	SwissHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> ret;
 	for (const KeyValue<Animation::TrackCacheID, AnimationMixer::TrackCache *> &E : data) {
 		AnimationMixer::TrackCache *track = get_cache_copy(E.value);
 		ERR_CONTINUE(!track); // Backup shouldn't contain tracks that cannot be copied, this is a mistake.
@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "core/object/property_path.h"
 #include "core/templates/a_hash_map.h"
+#include "core/templates/swiss_hash_map.h"
 #include "scene/animation/tween.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
@@ -223,7 +225,7 @@ protected:
 	struct TrackCacheValue : public TrackCache {
 		Variant init_value;
 		Variant value;
-		Vector<StringName> subpath;
+		PropertyPath subpath;
 
 		// TODO: There are many boolean, can be packed into one integer.
 		bool is_init = false;
@@ -304,7 +306,7 @@ protected:
 	};
 
 	RootMotionCache root_motion_cache;
-	AHashMap<Animation::TrackCacheID, TrackCache *, HashHasher> track_cache;
+	SwissHashMap<Animation::TrackCacheID, TrackCache *, HashHasher> track_cache;
 	AHashMap<Ref<Animation>, LocalVector<TrackCache *>> animation_track_num_to_track_cache;
 	HashSet<TrackCache *> playing_caches;
 	Vector<Node *> playing_audio_stream_players;
@@ -489,11 +491,11 @@ public:
 class AnimatedValuesBackup : public RefCounted {
 	GDCLASS(AnimatedValuesBackup, RefCounted);
 
-	AHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> data;
+	SwissHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> data;
 
 public:
-	void set_data(const AHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> &p_data);
-	AHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> get_data() const;
+	void set_data(const SwissHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> &p_data);
+	SwissHashMap<Animation::TrackCacheID, AnimationMixer::TrackCache *, HashHasher> get_data() const;
 
 	void clear_data();
 
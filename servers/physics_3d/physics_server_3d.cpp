@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/ref_counted.h"
+#include "core/variant/typed_array.h"
 
 PhysicsServer3D *PhysicsServer3D::singleton = nullptr;
 
@@ -51,6 +52,31 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, RequiredParam<PhysicsTestMot
 	return body_test_motion(p_body, parameters->get_parameters(), result_ptr);
 }
 
+void PhysicsServer3D::_bodies_set_state_bind(const TypedArray<RID> &p_bodies, PS3DE::BodyState p_state, const Array &p_values) {
+	ERR_FAIL_COND(p_bodies.size() != p_values.size());
+	Vector<RID> bodies;
+	Vector<Variant> values;
+	bodies.resize(p_bodies.size());
+	values.resize(p_values.size());
+	RID *bodies_ptr = bodies.ptrw();
+	Variant *values_ptr = values.ptrw();
+	for (int i = 0; i < p_bodies.size(); i++) {
+		bodies_ptr[i] = p_bodies[i];
+		values_ptr[i] = p_values[i];
+	}
+	bodies_set_state(bodies, p_state, values);
+}
+
+void PhysicsServer3D::bodies_set_state(const Vector<RID> &p_bodies, PS3DE::BodyState p_state, const Vector<Variant> &p_values) {
+	ERR_FAIL_COND(p_bodies.size() != p_values.size());
+
+	const RID *bodies = p_bodies.ptr();
+	const Variant *values = p_values.ptr();
+	for (int i = 0; i < p_bodies.size(); i++) {
+		body_set_state(bodies[i], p_state, values[i]);
+	}
+}
+
 RID PhysicsServer3D::shape_create(PS3DE::ShapeType p_shape) {
 	switch (p_shape) {
 		case PS3DE::SHAPE_WORLD_BOUNDARY:
@@ -184,6 +210,7 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("body_reset_mass_properties", "body"), &PhysicsServer3D::body_reset_mass_properties);
 
 	ClassDB::bind_method(D_METHOD("body_set_state", "body", "state", "value"), &PhysicsServer3D::body_set_state);
+	ClassDB::bind_method(D_METHOD("bodies_set_state", "bodies", "state", "values"), &PhysicsServer3D::_bodies_set_state_bind);
 	ClassDB::bind_method(D_METHOD("body_get_state", "body", "state"), &PhysicsServer3D::body_get_state);
 
 	ClassDB::bind_method(D_METHOD("body_apply_central_impulse", "body", "impulse"), &PhysicsServer3D::body_apply_central_impulse);
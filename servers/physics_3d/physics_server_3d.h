@@ -54,6 +54,7 @@ class PhysicsServer3D : public Object {
 	static PhysicsServer3D *singleton;
 
 	virtual bool _body_test_motion(RID p_body, RequiredParam<PhysicsTestMotionParameters3D> p_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
+	void _bodies_set_state_bind(const TypedArray<RID> &p_bodies, PS3DE::BodyState p_state, const Array &p_values);
 
 protected:
 	static void _bind_methods();
@@ -200,6 +201,8 @@ public:
 	//state
 
 	virtual void body_set_state(RID p_body, PS3DE::BodyState p_state, const Variant &p_variant) = 0;
+	// Sets the same state on many bodies with a single queued command, one value per body.
+	virtual void bodies_set_state(const Vector<RID> &p_bodies, PS3DE::BodyState p_state, const Vector<Variant> &p_values);
 	virtual Variant body_get_state(RID p_body, PS3DE::BodyState p_state) const = 0;
 
 	virtual void body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) = 0;
@@ -222,6 +222,7 @@ public:
 	FUNC1(body_reset_mass_properties, RID);
 
 	FUNC3(body_set_state, RID, PS3DE::BodyState, const Variant &);
+	FUNC3(bodies_set_state, const Vector<RID> &, PS3DE::BodyState, const Vector<Variant> &);
 	FUNC2RC(Variant, body_get_state, RID, PS3DE::BodyState);
 
 	FUNC2(body_apply_torque_impulse, RID, const Vector3 &);
@@ -107,6 +107,36 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+void RenderingServer::_instances_set_transforms_bind(const TypedArray<RID> &p_instances, const TypedArray<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	instances.resize(p_instances.size());
+	transforms.resize(p_transforms.size());
+	RID *instances_ptr = instances.ptrw();
+	Transform3D *transforms_ptr = transforms.ptrw();
+	for (int i = 0; i < p_instances.size(); i++) {
+		instances_ptr[i] = p_instances[i];
+		transforms_ptr[i] = p_transforms[i];
+	}
+	instances_set_transforms(instances, transforms);
+}
+
+void RenderingServer::_canvas_items_set_transforms_bind(const TypedArray<RID> &p_items, const TypedArray<Transform2D> &p_transforms) {
+	ERR_FAIL_COND(p_items.size() != p_transforms.size());
+	Vector<RID> items;
+	Vector<Transform2D> transforms;
+	items.resize(p_items.size());
+	transforms.resize(p_transforms.size());
+	RID *items_ptr = items.ptrw();
+	Transform2D *transforms_ptr = transforms.ptrw();
+	for (int i = 0; i < p_items.size(); i++) {
+		items_ptr[i] = p_items[i];
+		transforms_ptr[i] = p_transforms[i];
+	}
+	canvas_items_set_transforms(items, transforms);
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -3224,6 +3254,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_pivot_data", "instance", "sorting_offset", "use_aabb_center"), &RenderingServer::instance_set_pivot_data);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &RenderingServer::_instances_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &RenderingServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_override_material", "instance", "surface", "material"), &RenderingServer::instance_set_surface_override_material);
@@ -3328,6 +3359,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_item_set_light_mask", "item", "mask"), &RenderingServer::canvas_item_set_light_mask);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_visibility_layer", "item", "visibility_layer"), &RenderingServer::canvas_item_set_visibility_layer);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_transform", "item", "transform"), &RenderingServer::canvas_item_set_transform);
+	ClassDB::bind_method(D_METHOD("canvas_items_set_transforms", "items", "transforms"), &RenderingServer::_canvas_items_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_clip", "item", "clip"), &RenderingServer::canvas_item_set_clip);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_distance_field_mode", "item", "enabled"), &RenderingServer::canvas_item_set_distance_field_mode);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_custom_rect", "item", "use_custom_rect", "rect"), &RenderingServer::canvas_item_set_custom_rect, DEFVAL(Rect2()));
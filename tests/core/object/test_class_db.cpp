@@ -34,6 +34,8 @@ TEST_FORCE_LINK(test_class_db)
 
 #include "core/config/engine.h"
 #include "core/core_constants.h"
+#include "core/io/image.h"
+#include "core/io/resource.h"
 #include "core/object/class_db.h"
 
 namespace TestClassDB {
@@ -886,6 +888,69 @@ TEST_SUITE("[ClassDB]") {
 			}
 		}
 	}
+
+	TEST_CASE("[ClassDB] Method resolution with compatibility hashes") {
+		const MethodBind *set_name = ClassDB::get_method("Resource", "set_name");
+		REQUIRE(set_name != nullptr);
+
+		bool exists = false;
+		bool deprecated = false;
+		CHECK(ClassDB::get_method_with_compatibility("Resource", "set_name", set_name->get_hash(), &exists, &deprecated) == set_name);
+		CHECK(exists);
+		CHECK_FALSE(deprecated);
+
+		// Inherited methods resolve through the flattened candidates, and repeated lookups hit the cache.
+		for (int i = 0; i < 2; i++) {
+			exists = false;
+			CHECK(ClassDB::get_method_with_compatibility("Image", "set_name", set_name->get_hash(), &exists) == set_name);
+			CHECK(exists);
+		}
+
+		exists = false;
+		CHECK(ClassDB::get_method_with_compatibility("Image", "set_name", set_name->get_hash() + 1, &exists) == nullptr);
+		CHECK(exists);
+
+		exists = false;
+		CHECK(ClassDB::get_method_with_compatibility("Image", "_nonexistent_method", 0, &exists) == nullptr);
+		CHECK_FALSE(exists);
+	}
+
+	TEST_CASE("[ClassDB] Prepared property accessors") {
+		ClassDB::PropertyAccessor accessor = ClassDB::prepare_property("Resource", "resource_name");
+		REQUIRE(accessor.is_valid());
+		CHECK(accessor.get_name() == "resource_name");
+		CHECK(accessor.is_settable());
+
+		Ref<Image> image;
+		image.instantiate();
+		CHECK(accessor.set(image.ptr(), "prepared"));
+		CHECK(image->get_name() == "prepared");
+		CHECK(accessor.get(image.ptr()) == Variant("prepared"));
+
+		Variant value;
+		CHECK(ClassDB::prepare_property("Resource", "changed").get(image.ptr(), value));
+		CHECK(value.get_type() == Variant::SIGNAL);
+		CHECK_FALSE(ClassDB::prepare_property("Resource", "changed").set(image.ptr(), value));
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(ClassDB::prepare_property("Resource", "_nonexistent_property").is_valid());
+		CHECK_FALSE(ClassDB::prepare_property("_NonexistentClass", "resource_name").is_valid());
+
+		Ref<RefCounted> unrelated;
+		unrelated.instantiate();
+		CHECK_FALSE(accessor.set(unrelated.ptr(), "unrelated"));
+		CHECK_FALSE(accessor.get(unrelated.ptr(), value));
+		ERR_PRINT_ON;
+
+		SUBCASE("Stale accessors are rejected after ClassDB changes") {
+			ClassDB::_invalidate_resolution_cache();
+			CHECK_FALSE(accessor.is_valid());
+			ERR_PRINT_OFF;
+			CHECK_FALSE(accessor.set(image.ptr(), "stale"));
+			ERR_PRINT_ON;
+			CHECK(image->get_name() == "prepared");
+		}
+	}
 }
 
 } // namespace TestClassDB
@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*  test_message_queue.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_message_queue)
+
+#include "core/object/callable_mp.h"
+#include "core/object/message_queue.h"
+#include "core/object/object.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+namespace TestMessageQueue {
+
+class MessageQueueTarget : public Object {
+	GDCLASS(MessageQueueTarget, Object);
+
+public:
+	LocalVector<int> order;
+	LocalVector<int> last_sequence;
+	int errors = 0;
+	int calls = 0;
+
+	void append(int p_value) {
+		order.push_back(p_value);
+	}
+
+	void record(int p_producer, int p_sequence) {
+		calls++;
+		errors += p_sequence != last_sequence[p_producer] + 1;
+		last_sequence[p_producer] = p_sequence;
+	}
+};
+
+TEST_CASE("[MessageQueue] Calls keep push order") {
+	CallQueue queue;
+	MessageQueueTarget target;
+	const Callable append = callable_mp(&target, &MessageQueueTarget::append);
+
+	CHECK_FALSE(queue.has_messages());
+	for (int i = 0; i < 1000; i++) {
+		if (i % 2) {
+			queue.push_callable(append, i);
+		} else {
+			// Variant arguments take the other message layout.
+			const Variant arg = i;
+			const Variant *args[1] = { &arg };
+			queue.push_callablep(append, args, 1);
+		}
+	}
+	CHECK(queue.has_messages());
+	CHECK(queue.get_max_buffer_usage() > CallQueue::PAGE_SIZE_BYTES);
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(target.order.size() == 1000);
+	bool in_order = true;
+	for (int i = 0; i < 1000; i++) {
+		in_order = in_order && target.order[i] == i;
+	}
+	CHECK(in_order);
+}
+
+#ifdef THREADS_ENABLED
+struct MessageQueueProducers {
+	CallQueue *queue = nullptr;
+	Callable record;
+	int calls_per_producer = 0;
+	SafeNumeric<int> next_producer;
+	SafeNumeric<int> push_errors;
+
+	void produce() {
+		const int producer = next_producer.postincrement();
+		for (int i = 0; i < calls_per_producer; i++) {
+			if (queue->push_callable(record, producer, i) != OK) {
+				push_errors.increment();
+			}
+		}
+	}
+
+	static void produce_thread(void *p_userdata) {
+		((MessageQueueProducers *)p_userdata)->produce();
+	}
+
+	// Pushes from `p_producer_count` threads while flushing on this one.
+	// Returns the time it took, in microseconds.
+	uint64_t run(MessageQueueTarget &r_target, int p_producer_count) {
+		CallQueue call_queue;
+		queue = &call_queue;
+		record = callable_mp(&r_target, &MessageQueueTarget::record);
+		next_producer.set(0);
+		r_target.last_sequence.clear();
+		r_target.last_sequence.resize_initialized(p_producer_count);
+		for (int &sequence : r_target.last_sequence) {
+			sequence = -1;
+		}
+
+		TightLocalVector<Thread> threads;
+		threads.resize(p_producer_count);
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (Thread &thread : threads) {
+			thread.start(&MessageQueueProducers::produce_thread, this);
+		}
+		while (r_target.calls + push_errors.get() < calls_per_producer * p_producer_count) {
+			call_queue.flush();
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		queue = nullptr;
+		return usec;
+	}
+};
+
+TEST_CASE("[MessageQueue] Calls pushed from several threads keep per-thread order") {
+	MessageQueueTarget target;
+	MessageQueueProducers producers;
+	producers.calls_per_producer = 5000;
+	producers.run(target, 4);
+
+	CHECK(producers.push_errors.get() == 0);
+	CHECK(target.calls == 4 * 5000);
+	CHECK(target.errors == 0);
+	for (int sequence : target.last_sequence) {
+		CHECK(sequence == 4999);
+	}
+}
+
+static void push_once_thread(void *p_userdata) {
+	MessageQueueProducers *producers = (MessageQueueProducers *)p_userdata;
+	if (producers->queue->push_callable(producers->record, 0, 0) != OK) {
+		producers->push_errors.increment();
+	}
+}
+
+TEST_CASE("[MessageQueue] Buffers of exited threads are reclaimed") {
+	// Each buffer keeps a page, so without reclaiming them the dead threads alone would use up all pages.
+	CallQueue queue(nullptr, 4);
+	MessageQueueTarget target;
+	target.last_sequence.resize_initialized(1);
+	MessageQueueProducers producers;
+	producers.queue = &queue;
+	producers.record = callable_mp(&target, &MessageQueueTarget::record);
+
+	for (int i = 0; i < 8; i++) {
+		target.last_sequence[0] = -1;
+		Thread thread;
+		thread.start(&push_once_thread, &producers);
+		thread.wait_to_finish();
+		CHECK(queue.flush() == OK);
+	}
+	CHECK(producers.push_errors.get() == 0);
+	CHECK(target.calls == 8);
+
+	// Needs more than one page, which fails if the exited threads still hold theirs.
+	const Callable append = callable_mp(&target, &MessageQueueTarget::append);
+	int push_errors = 0;
+	for (int i = 0; i < CallQueue::PAGE_SIZE_BYTES / 16; i++) {
+		push_errors += queue.push_callable(append, i) != OK;
+	}
+	CHECK(push_errors == 0);
+	CHECK(queue.flush() == OK);
+	CHECK(target.order.size() == CallQueue::PAGE_SIZE_BYTES / 16);
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestMessageQueue
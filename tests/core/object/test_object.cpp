@@ -36,7 +36,10 @@ TEST_FORCE_LINK(test_object)
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 #include "tests/signal_watcher.h"
+#include "tests/test_benchmark.h"
 
 namespace TestObject {
 
@@ -326,6 +329,15 @@ public:
 	void callback3(Variant p_arg1, Variant p_arg2, Variant p_arg3) {
 		received_args = Vector<Variant>{ p_arg1, p_arg2, p_arg3 };
 	}
+
+	int typed_calls = 0;
+	int64_t typed_sum = 0;
+
+	void typed_callback(int p_value, const String &p_text) {
+		typed_calls++;
+		typed_sum += p_value;
+		received_args = Vector<Variant>{ p_value, p_text };
+	}
 };
 
 TEST_CASE("[Object] Signals") {
@@ -512,6 +524,57 @@ TEST_CASE("[Object] Signals") {
 		CHECK_EQ(target.received_args, Vector<Variant>{ "emit_arg", &object });
 		object.disconnect("my_custom_signal", callable_mp(&target, &SignalReceiver::callback2));
 	}
+
+	SUBCASE("Typed native targets are called with and without argument conversion") {
+		SignalReceiver target;
+		const Callable callable = callable_mp(&target, &SignalReceiver::typed_callback);
+		object.connect("my_custom_signal", callable);
+
+		// Exact argument types go through ptrcall.
+		const Variant value = 7;
+		const Variant text = "text";
+		const Variant *args[2] = { &value, &text };
+		CHECK(callable.try_ptrcallp(args, 2));
+		CHECK_EQ(target.received_args, Vector<Variant>{ 7, "text" });
+
+		object.emit_signal("my_custom_signal", 3, "emit_arg");
+		CHECK_EQ(target.received_args, Vector<Variant>{ 3, "emit_arg" });
+
+		// Convertible arguments still work through the regular call.
+		const Variant float_value = 5.0;
+		const Variant string_name = StringName("string_name");
+		const Variant *convertible_args[2] = { &float_value, &string_name };
+		CHECK_FALSE(callable.try_ptrcallp(convertible_args, 2));
+		object.emit_signal("my_custom_signal", 5.0, StringName("string_name"));
+		CHECK_EQ(target.received_args, Vector<Variant>{ 5, "string_name" });
+		CHECK_FALSE(callable.try_ptrcallp(args, 1));
+
+		object.disconnect("my_custom_signal", callable);
+		CHECK_EQ(target.typed_calls, 3);
+	}
+
+	SUBCASE("Connection changes during emission apply to the next emission") {
+		SignalReceiver targets[3];
+		object.connect("my_custom_signal", callable_mp(&targets[0], &SignalReceiver::typed_callback));
+		object.connect("my_custom_signal", callable_mp(&targets[1], &SignalReceiver::typed_callback), Object::CONNECT_ONE_SHOT);
+
+		object.emit_signal("my_custom_signal", 1, "");
+		CHECK_EQ(targets[0].typed_calls, 1);
+		CHECK_EQ(targets[1].typed_calls, 1);
+
+		object.connect("my_custom_signal", callable_mp(&targets[2], &SignalReceiver::typed_callback));
+		object.emit_signal("my_custom_signal", 2, "");
+		CHECK_EQ(targets[0].typed_calls, 2);
+		CHECK_EQ(targets[1].typed_calls, 1);
+		CHECK_EQ(targets[2].typed_calls, 1);
+
+		object.disconnect("my_custom_signal", callable_mp(&targets[0], &SignalReceiver::typed_callback));
+		object.emit_signal("my_custom_signal", 3, "");
+		CHECK_EQ(targets[0].typed_calls, 2);
+		CHECK_EQ(targets[2].typed_calls, 2);
+		CHECK_EQ(targets[2].typed_sum, 5);
+		object.disconnect("my_custom_signal", callable_mp(&targets[2], &SignalReceiver::typed_callback));
+	}
 }
 
 class NotificationObjectSuperclass : public Object {
@@ -691,4 +754,129 @@ TEST_CASE("[Object] RequiredResult") {
 	CHECK_EQ(ref, var);
 }
 
+TEST_CASE("[ObjectDB] Stale instance IDs stay invalid when slots are reused") {
+	LocalVector<ObjectID> stale_ids;
+	for (int i = 0; i < 100; i++) {
+		Object *object = memnew(Object);
+		stale_ids.push_back(object->get_instance_id());
+		memdelete(object);
+	}
+
+	// Enough to reuse the freed slots and to allocate a new slot page.
+	LocalVector<Object *> objects;
+	for (int i = 0; i < 5000; i++) {
+		objects.push_back(memnew(Object));
+	}
+
+	bool all_stale = true;
+	for (const ObjectID &id : stale_ids) {
+		all_stale &= ObjectDB::get_instance(id) == nullptr;
+	}
+	CHECK(all_stale);
+
+	bool all_found = true;
+	for (Object *object : objects) {
+		all_found &= ObjectDB::get_instance(object->get_instance_id()) == object;
+	}
+	CHECK(all_found);
+
+	for (Object *object : objects) {
+		memdelete(object);
+	}
+}
+
+#ifdef THREADS_ENABLED
+struct ObjectDBLookupTester {
+	LocalVector<Object *> objects;
+	LocalVector<ObjectID> ids;
+	LocalVector<ObjectID> stale_ids;
+	SafeNumeric<uint32_t> errors;
+	SafeFlag done;
+	int rounds = 0;
+
+	ObjectDBLookupTester(int p_rounds) {
+		rounds = p_rounds;
+		for (int i = 0; i < 1000; i++) {
+			Object *object = memnew(Object);
+			objects.push_back(object);
+			ids.push_back(object->get_instance_id());
+			Object *stale = memnew(Object);
+			stale_ids.push_back(stale->get_instance_id());
+			memdelete(stale);
+		}
+	}
+
+	~ObjectDBLookupTester() {
+		for (Object *object : objects) {
+			memdelete(object);
+		}
+	}
+
+	void resolve() {
+		uint32_t local_errors = 0;
+		for (int round = 0; round < rounds; round++) {
+			for (uint32_t i = 0; i < ids.size(); i++) {
+				local_errors += ObjectDB::get_instance(ids[i]) != objects[i];
+				local_errors += ObjectDB::get_instance(stale_ids[i]) != nullptr;
+			}
+		}
+		errors.add(local_errors);
+	}
+
+	static void resolve_thread(void *p_userdata) {
+		((ObjectDBLookupTester *)p_userdata)->resolve();
+	}
+
+	void run(uint32_t p_thread_count) {
+		TightLocalVector<Thread> threads;
+		threads.resize(p_thread_count);
+		for (Thread &thread : threads) {
+			thread.start(&ObjectDBLookupTester::resolve_thread, this);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+};
+
+TEST_CASE("[ObjectDB] Lookups from many threads while objects are created and freed") {
+	ObjectDBLookupTester tester(200);
+
+	// Churn slots on another thread, so stale IDs get their slots reused while being resolved.
+	Thread churn;
+	churn.start(
+			[](void *p_userdata) {
+				ObjectDBLookupTester *t = (ObjectDBLookupTester *)p_userdata;
+				while (!t->done.is_set()) {
+					Object *objects[64];
+					for (Object *&object : objects) {
+						object = memnew(Object);
+					}
+					for (Object *object : objects) {
+						memdelete(object);
+					}
+				}
+			},
+			&tester);
+	tester.run(MAX(4, OS::get_singleton()->get_processor_count() - 1));
+	tester.done.set();
+	churn.wait_to_finish();
+
+	CHECK(tester.errors.get() == 0);
+}
+
+BENCHMARK_CASE("[ObjectDB][Benchmark] Instance ID lookups per second") {
+	const int rounds = 2000;
+	ObjectDBLookupTester tester(rounds);
+	const uint32_t max_threads = OS::get_singleton()->get_processor_count();
+	for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		const uint64_t usec = TestBenchmark::measure_usec([&]() { tester.run(thread_count); });
+		// Each round resolves every valid and every stale ID.
+		const double lookups = double(rounds) * tester.ids.size() * 2 * thread_count;
+		TestBenchmark::report(vformat("%d threads", thread_count), usec, lookups);
+	}
+	CHECK(tester.errors.get() == 0);
+}
+#endif // THREADS_ENABLED
+
 } // namespace TestObject
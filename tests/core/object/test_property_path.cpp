@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*  test_property_path.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_property_path)
+
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/object/property_path.h"
+
+namespace TestPropertyPath {
+
+class _TestPropertyPathObject : public Object {
+	GDCLASS(_TestPropertyPathObject, Object);
+
+	Vector2 offset;
+	Transform2D transform;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_offset", "offset"), &_TestPropertyPathObject::set_offset);
+		ClassDB::bind_method(D_METHOD("get_offset"), &_TestPropertyPathObject::get_offset);
+		ClassDB::bind_method(D_METHOD("set_transform", "transform"), &_TestPropertyPathObject::set_transform);
+		ClassDB::bind_method(D_METHOD("get_transform"), &_TestPropertyPathObject::get_transform);
+		ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+		ADD_PROPERTY(PropertyInfo(Variant::TRANSFORM2D, "transform"), "set_transform", "get_transform");
+	}
+
+public:
+	void set_offset(const Vector2 &p_offset) { offset = p_offset; }
+	Vector2 get_offset() const { return offset; }
+	void set_transform(const Transform2D &p_transform) { transform = p_transform; }
+	Transform2D get_transform() const { return transform; }
+};
+
+TEST_CASE("[PropertyPath] Native properties and built-in members") {
+	GDREGISTER_CLASS(_TestPropertyPathObject);
+	_TestPropertyPathObject object;
+	bool valid = false;
+
+	PropertyPath offset(Vector<StringName>{ "offset" });
+	offset.set(&object, Vector2(1, 2), &valid);
+	CHECK(valid);
+	CHECK(object.get_offset() == Vector2(1, 2));
+	CHECK(offset.get(&object, &valid) == Variant(Vector2(1, 2)));
+	CHECK(valid);
+
+	PropertyPath offset_x(Vector<StringName>{ "offset", "x" });
+	offset_x.set(&object, 5.0, &valid);
+	CHECK(valid);
+	CHECK(object.get_offset() == Vector2(5, 2));
+	// Values of another type are converted like Object::set_indexed() does.
+	offset_x.set(&object, 7, &valid);
+	CHECK(valid);
+	CHECK(object.get_offset() == Vector2(7, 2));
+	CHECK(offset_x.get(&object, &valid) == Variant(7.0));
+	CHECK(valid);
+
+	PropertyPath origin_y(Vector<StringName>{ "transform", "origin", "y" });
+	for (int i = 0; i < 3; i++) {
+		origin_y.set(&object, 10.0 + i, &valid);
+		CHECK(valid);
+		CHECK(object.get_transform().get_origin() == Vector2(0, 10 + i));
+		CHECK(origin_y.get(&object) == object.get_indexed(Vector<StringName>{ "transform", "origin", "y" }));
+	}
+
+	SUBCASE("Paths can be reused on other instances of the class") {
+		_TestPropertyPathObject other;
+		origin_y.set(&other, 3.0, &valid);
+		CHECK(valid);
+		CHECK(other.get_transform().get_origin() == Vector2(0, 3));
+		CHECK(object.get_transform().get_origin() == Vector2(0, 12));
+	}
+
+	SUBCASE("Generic properties go through Object::set()") {
+		PropertyPath meta_x(Vector<StringName>{ "metadata/value", "x" });
+		object.set_meta("value", Vector2(1, 1));
+		meta_x.set(&object, 4.0, &valid);
+		CHECK(valid);
+		CHECK(object.get_meta("value") == Variant(Vector2(4, 1)));
+		CHECK(meta_x.get(&object) == Variant(4.0));
+	}
+
+	SUBCASE("Invalid paths") {
+		PropertyPath missing_member(Vector<StringName>{ "offset", "z" });
+		CHECK(missing_member.get(&object, &valid) == Variant());
+		CHECK_FALSE(valid);
+		missing_member.set(&object, 1.0, &valid);
+		CHECK_FALSE(valid);
+		CHECK(object.get_offset() == Vector2(7, 2));
+
+		PropertyPath missing_property(Vector<StringName>{ "_nonexistent", "x" });
+		missing_property.set(&object, 1.0, &valid);
+		CHECK_FALSE(valid);
+		missing_property.get(&object, &valid);
+		CHECK_FALSE(valid);
+
+		PropertyPath empty;
+		CHECK(empty.is_empty());
+		empty.set(&object, 1.0, &valid);
+		CHECK_FALSE(valid);
+	}
+}
+
+} // namespace TestPropertyPath
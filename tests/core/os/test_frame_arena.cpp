@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  test_frame_arena.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_frame_arena)
+
+#include "core/os/frame_arena.h"
+#include "core/os/thread.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations are aligned and memory is reused once everything is freed") {
+	uint8_t *a = static_cast<uint8_t *>(FrameArena::alloc(3));
+	uint8_t *b = static_cast<uint8_t *>(FrameArena::alloc(100));
+	CHECK(a != b);
+	CHECK((uintptr_t)a % Memory::MAX_ALIGN == 0);
+	CHECK((uintptr_t)b % Memory::MAX_ALIGN == 0);
+	CHECK(FrameArena::get_thread_usage() > 0);
+
+	// Out of order, so the arena can only rewind on the next allocation.
+	FrameArena::free(a);
+	FrameArena::free(b);
+
+	uint8_t *c = static_cast<uint8_t *>(FrameArena::alloc(3));
+	CHECK(c == a);
+	FrameArena::free(c);
+}
+
+TEST_CASE("[FrameArena] Realloc grows the last allocation in place and keeps contents") {
+	uint8_t *a = static_cast<uint8_t *>(FrameArena::alloc(16));
+	for (uint8_t i = 0; i < 16; i++) {
+		a[i] = i;
+	}
+	uint8_t *grown = static_cast<uint8_t *>(FrameArena::realloc(a, 256));
+	CHECK(grown == a);
+
+	uint8_t *b = static_cast<uint8_t *>(FrameArena::alloc(16));
+	uint8_t *moved = static_cast<uint8_t *>(FrameArena::realloc(grown, 512));
+	CHECK(moved != grown);
+	for (uint8_t i = 0; i < 16; i++) {
+		CHECK(moved[i] == i);
+	}
+
+	// Larger than a block.
+	uint8_t *large = static_cast<uint8_t *>(FrameArena::alloc_zeroed(FrameArena::BLOCK_SIZE * 2));
+	CHECK(large[0] == 0);
+	CHECK(large[FrameArena::BLOCK_SIZE * 2 - 1] == 0);
+
+	FrameArena::free(large);
+	FrameArena::free(b);
+	FrameArena::free(moved);
+}
+
+TEST_CASE("[FrameArena] Frame containers") {
+	{
+		FrameLocalVector<int> vector;
+		FrameAHashMap<int, int> map;
+		for (int i = 0; i < 1000; i++) {
+			vector.push_back(i);
+			map.insert(i, i * 2);
+		}
+		CHECK(vector.size() == 1000);
+		CHECK(map.size() == 1000);
+		for (int i = 0; i < 1000; i++) {
+			CHECK(vector[i] == i);
+			CHECK(map[i] == i * 2);
+		}
+
+		FrameLocalVector<int> copy(vector);
+		CHECK(copy.size() == 1000);
+		CHECK(copy[999] == 999);
+	}
+
+	FrameArena::end_frame();
+	CHECK(FrameArena::get_thread_usage() == 0);
+	CHECK(FrameArena::get_frame_high_water() >= 1000 * sizeof(int) * 2);
+	CHECK(FrameArena::get_max_high_water() >= FrameArena::get_frame_high_water());
+	CHECK(FrameArena::get_reserved_memory() >= FrameArena::get_frame_high_water());
+}
+
+TEST_CASE("[FrameArena] Memory can be freed from another thread") {
+	void *mem = nullptr;
+	Thread thread;
+	thread.start([](void *p_userdata) {
+		*static_cast<void **>(p_userdata) = FrameArena::alloc(64);
+	},
+			&mem);
+	thread.wait_to_finish();
+
+	REQUIRE(mem != nullptr);
+	memset(mem, 0xAB, 64);
+	FrameArena::free(mem);
+}
+
+} // namespace TestFrameArena
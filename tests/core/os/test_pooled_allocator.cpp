@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  test_pooled_allocator.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_pooled_allocator)
+
+#include "core/os/pooled_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "tests/test_benchmark.h"
+
+#include <cstdlib>
+
+namespace TestPooledAllocator {
+
+TEST_CASE("[PooledAllocator] Size classes") {
+	CHECK(PooledAllocator::get_size_class(0) == 0);
+	CHECK(PooledAllocator::get_class_size(0) == 16);
+	CHECK(PooledAllocator::get_size_class(PooledAllocator::MAX_POOLED_SIZE) == PooledAllocator::CLASS_COUNT - 1);
+	CHECK(PooledAllocator::get_class_size(PooledAllocator::CLASS_COUNT - 1) == PooledAllocator::MAX_POOLED_SIZE);
+
+	bool fits = true;
+	bool tight = true;
+	for (size_t size = 1; size <= PooledAllocator::MAX_POOLED_SIZE; size++) {
+		const uint32_t size_class = PooledAllocator::get_size_class(size);
+		fits = fits && PooledAllocator::get_class_size(size_class) >= size && PooledAllocator::get_class_size(size_class) % 16 == 0;
+		tight = tight && (size_class == 0 || PooledAllocator::get_class_size(size_class - 1) < size);
+	}
+	CHECK_MESSAGE(fits, "Every size fits into its class.");
+	CHECK_MESSAGE(tight, "Every size uses the smallest class that fits.");
+}
+
+TEST_CASE("[PooledAllocator] Allocation, reallocation and reuse") {
+	uint8_t *mem = static_cast<uint8_t *>(PooledAllocator::alloc(20));
+	REQUIRE(mem != nullptr);
+	CHECK((uintptr_t)mem % 16 == 0);
+	for (uint8_t i = 0; i < 20; i++) {
+		mem[i] = i;
+	}
+
+	// Same class, stays in place.
+	CHECK(PooledAllocator::realloc(mem, 20, 30) == mem);
+
+	uint8_t *grown = static_cast<uint8_t *>(PooledAllocator::realloc(mem, 30, 1000));
+	CHECK(grown != mem);
+	uint8_t *large = static_cast<uint8_t *>(PooledAllocator::realloc(grown, 1000, PooledAllocator::MAX_POOLED_SIZE * 2));
+	bool preserved = true;
+	for (uint8_t i = 0; i < 20; i++) {
+		preserved = preserved && large[i] == i;
+	}
+	CHECK(preserved);
+	PooledAllocator::free(large, PooledAllocator::MAX_POOLED_SIZE * 2);
+
+	// Freed memory is handed out again by the same thread.
+	void *a = PooledAllocator::alloc(100);
+	PooledAllocator::free(a, 100);
+	CHECK(PooledAllocator::alloc(100) == a);
+	PooledAllocator::free(a, 100);
+
+	uint8_t *zeroed = static_cast<uint8_t *>(PooledAllocator::alloc_zeroed(256));
+	bool zero = true;
+	for (int i = 0; i < 256; i++) {
+		zero = zero && zeroed[i] == 0;
+	}
+	CHECK(zero);
+	PooledAllocator::free(zeroed, 256);
+}
+
+TEST_CASE("[PooledAllocator] Memory freed by another thread") {
+	constexpr int COUNT = 10000;
+	LocalVector<void *> allocations;
+	allocations.resize(COUNT);
+
+	Thread thread;
+	thread.start([](void *p_userdata) {
+		LocalVector<void *> &list = *static_cast<LocalVector<void *> *>(p_userdata);
+		for (uint32_t i = 0; i < list.size(); i++) {
+			list[i] = PooledAllocator::alloc(16 + (i % 64) * 8);
+			memset(list[i], 0xCD, 16 + (i % 64) * 8);
+		}
+	},
+			&allocations);
+	thread.wait_to_finish();
+
+	for (uint32_t i = 0; i < allocations.size(); i++) {
+		PooledAllocator::free(allocations[i], 16 + (i % 64) * 8);
+	}
+	CHECK(PooledAllocator::get_reserved_memory() > 0);
+}
+
+struct Backend {
+	void *(*alloc)(size_t p_bytes);
+	void *(*realloc)(void *p_memory, size_t p_old_bytes, size_t p_bytes);
+	void (*free)(void *p_memory, size_t p_bytes);
+};
+
+static const Backend system_backend = {
+	[](size_t p_bytes) { return malloc(p_bytes); },
+	[](void *p_memory, size_t p_old_bytes, size_t p_bytes) { return realloc(p_memory, p_bytes); },
+	[](void *p_memory, size_t p_bytes) { free(p_memory); },
+};
+
+static const Backend pooled_backend = {
+	PooledAllocator::alloc,
+	PooledAllocator::realloc,
+	PooledAllocator::free,
+};
+
+// Roughly what instantiating a scene does: objects of a few hundred bytes, each with some
+// strings and a growing array, all kept alive and then freed in a different order.
+static void run_scene_workload(const Backend &p_backend) {
+	constexpr int NODES = 20000;
+	LocalVector<void *> live;
+	LocalVector<size_t> sizes;
+	live.reserve(NODES * 6);
+	sizes.reserve(NODES * 6);
+
+	for (int i = 0; i < NODES; i++) {
+		const size_t object_size = 400 + (i % 5) * 96;
+		live.push_back(p_backend.alloc(object_size));
+		sizes.push_back(object_size);
+		for (int j = 0; j < 4; j++) {
+			const size_t string_size = 24 + ((i + j) % 8) * 12;
+			live.push_back(p_backend.alloc(string_size));
+			sizes.push_back(string_size);
+		}
+		size_t array_size = 16;
+		void *array = p_backend.alloc(array_size);
+		for (int j = 0; j < 5; j++) {
+			array = p_backend.realloc(array, array_size, array_size * 2);
+			array_size *= 2;
+		}
+		live.push_back(array);
+		sizes.push_back(array_size);
+	}
+	for (uint32_t i = 0; i < live.size(); i += 2) {
+		p_backend.free(live[i], sizes[i]);
+	}
+	for (uint32_t i = 1; i < live.size(); i += 2) {
+		p_backend.free(live[i], sizes[i]);
+	}
+}
+
+// Roughly what a script loop does: short-lived temporaries and string concatenation.
+static void run_script_loop_workload(const Backend &p_backend) {
+	constexpr int ITERATIONS = 500000;
+	for (int i = 0; i < ITERATIONS; i++) {
+		void *a = p_backend.alloc(24);
+		void *b = p_backend.alloc(48 + (i % 4) * 16);
+		size_t string_size = 32;
+		void *string = p_backend.alloc(string_size);
+		string = p_backend.realloc(string, string_size, string_size + 40);
+		string_size += 40;
+		p_backend.free(b, 48 + (i % 4) * 16);
+		p_backend.free(a, 24);
+		p_backend.free(string, string_size);
+	}
+}
+
+BENCHMARK_CASE("[PooledAllocator][Benchmark] Compared to the system allocator") {
+	const uint64_t scene_system = TestBenchmark::measure_usec([]() { run_scene_workload(system_backend); });
+	const uint64_t scene_pooled = TestBenchmark::measure_usec([]() { run_scene_workload(pooled_backend); });
+	TestBenchmark::report_comparison("Scene instantiation, system versus pooled", scene_system, scene_pooled);
+
+	const uint64_t loop_system = TestBenchmark::measure_usec([]() { run_script_loop_workload(system_backend); });
+	const uint64_t loop_pooled = TestBenchmark::measure_usec([]() { run_script_loop_workload(pooled_backend); });
+	TestBenchmark::report_comparison("Script loop, system versus pooled", loop_system, loop_pooled);
+}
+
+} // namespace TestPooledAllocator
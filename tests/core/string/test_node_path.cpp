@@ -33,6 +33,7 @@
 TEST_FORCE_LINK(test_node_path)
 
 #include "core/string/node_path.h"
+#include "tests/test_benchmark.h"
 
 namespace TestNodePath {
 
@@ -222,4 +223,42 @@ TEST_CASE("[NodePath] Slice") {
 			"Slice of an empty absolute path should be an empty absolute path.");
 }
 
+TEST_CASE("[NodePath] Parsing separators") {
+	const NodePath repeated = NodePath("Parent//Child/:position:x:");
+	REQUIRE(repeated.get_name_count() == 2);
+	CHECK(repeated.get_name(0) == "Parent");
+	CHECK(repeated.get_name(1) == "Child");
+	REQUIRE(repeated.get_subname_count() == 2);
+	CHECK(repeated.get_subname(0) == "position");
+	CHECK(repeated.get_subname(1) == "x");
+
+	const NodePath names_only = NodePath("/root/");
+	CHECK(names_only.is_absolute());
+	REQUIRE(names_only.get_name_count() == 1);
+	CHECK(names_only.get_name(0) == "root");
+	CHECK(names_only.get_subname_count() == 0);
+
+	// Names come from the same interning table as any other StringName.
+	CHECK(NodePath("Parent/Child").get_name(1) == StringName("Child"));
+
+	ERR_PRINT_OFF;
+	CHECK(NodePath("Parent:a::b").is_empty());
+	ERR_PRINT_ON;
+}
+
+BENCHMARK_CASE("[NodePath][Benchmark] Parsing") {
+	const int iterations = 200000;
+	const String path = "../Level/Enemies/Goblin/AnimationPlayer:position:x";
+
+	int64_t total_names = 0;
+	const uint64_t usec = TestBenchmark::measure_usec([&]() {
+		total_names = 0;
+		for (int i = 0; i < iterations; i++) {
+			total_names += NodePath(path).get_name_count();
+		}
+	});
+	TestBenchmark::report("NodePath(String)", usec, iterations);
+	CHECK(total_names == int64_t(iterations) * 5);
+}
+
 } // namespace TestNodePath
@@ -33,6 +33,7 @@
 TEST_FORCE_LINK(test_string)
 
 #include "core/string/ustring.h"
+#include "tests/test_benchmark.h"
 
 namespace TestString {
 
@@ -891,6 +892,24 @@ TEST_CASE("[String] format") {
 	String value = value_format.format(value_dictionary, "$_");
 
 	CHECK(value == "red=\"10\" green=\"20\" blue=\"bla\" alpha=\"0.4\"");
+
+	// Keys without a placeholder in the string are left out.
+	value_dictionary["unused"] = 30;
+	CHECK(value_format.format(value_dictionary, "$_") == value);
+
+	Array value_array = { "first", 2, "third" };
+	CHECK(String("{0}, {1}, {2}, {0}").format(value_array) == "first, 2, third, first");
+	CHECK(String("{0} {5}").format(value_array) == "first {5}");
+	CHECK(String("%, %").format(value_array, "%") == "first, 2");
+}
+
+TEST_CASE("[String] path_join") {
+	CHECK(String("res://a").path_join("b.tscn") == "res://a/b.tscn");
+	CHECK(String("res://a/").path_join("b.tscn") == "res://a/b.tscn");
+	CHECK(String("res://a").path_join("/b.tscn") == "res://a/b.tscn");
+	CHECK(String("res://a").path_join("") == "res://a/");
+	CHECK(String().path_join("b.tscn") == "b.tscn");
+	CHECK(String("res://a").path_join("b").length() == 9);
 }
 
 TEST_CASE("[String] sprintf") {
@@ -1892,6 +1911,36 @@ TEST_CASE("[String] hash") {
 	CHECK(a.hash64() != c.hash64());
 }
 
+TEST_CASE("[String] Cached hash follows changes") {
+	String a = "Test";
+	const uint32_t test_hash = String::hash("Test");
+	CHECK(a.hash() == test_hash);
+
+	// Copies share the buffer, and with it the cached hash.
+	String b = a;
+	b[0] = 'W';
+	CHECK(b.hash() == String::hash("West"));
+	CHECK(a.hash() == test_hash);
+
+	a += "s";
+	CHECK(a.hash() == String::hash("Tests"));
+	a.remove_at(4);
+	CHECK(a.hash() == test_hash);
+	a.ptrw()[1] = 'a';
+	CHECK(a.hash() == String::hash("Tast"));
+
+	// Writes to a buffer that is not shared must clear the hash too.
+	a[0] = 'L';
+	CHECK(a.hash() == String::hash("Last"));
+	a.set(3, 'h');
+	CHECK(a.hash() == String::hash("Lash"));
+	a.resize_uninitialized(4);
+	a.set(3, 0);
+	CHECK(a.hash() == String::hash("Las"));
+	a.clear();
+	CHECK(a.hash() == String::hash(""));
+}
+
 TEST_CASE("[String] uri_encode/unescape") {
 	String s = "Godot Engine:'docs'";
 	String t = "Godot%20Engine%3A%27docs%27";
@@ -2273,4 +2322,31 @@ TEST_CASE("[String][URL] Parse URL") {
 #undef CHECK_URL
 }
 
+BENCHMARK_CASE("[String][Benchmark] Formatting and joining") {
+	const int iterations = 200000;
+	const String format = "{name} has {hp} hit points at {position}.";
+	Dictionary values;
+	values["name"] = "Godot";
+	values["hp"] = 100;
+	values["position"] = Vector2(10, 20);
+	values["unused"] = 1.5;
+
+	int64_t total_length = 0;
+	uint64_t usec = TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < iterations; i++) {
+			total_length += format.format(values).length();
+		}
+	});
+	TestBenchmark::report("String::format", usec, iterations);
+
+	const String base = "res://assets/characters";
+	usec = TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < iterations; i++) {
+			total_length += base.path_join("player.tscn").length();
+		}
+	});
+	TestBenchmark::report("String::path_join", usec, iterations);
+	CHECK(total_length > 0);
+}
+
 } // namespace TestString
@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  test_string_name.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_string_name)
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "tests/test_benchmark.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "string_name_test";
+	const StringName b = String("string_name_test");
+	const StringName c = StringName(String("string_name_") + "test");
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a.hash() == String::hash("string_name_test"));
+	CHECK(a != StringName("string_name_test_2"));
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Interning from a span") {
+	const String source = "prefix/string_name_span/suffix";
+	const StringName a = StringName(Span(source.ptr() + 7, 16));
+	CHECK(a == "string_name_span");
+	CHECK(a.data_unique_pointer() == StringName("string_name_span").data_unique_pointer());
+	CHECK(a.hash() == String::hash("string_name_span"));
+	CHECK(StringName(Span(source.ptr(), 0)).is_empty());
+}
+
+TEST_CASE("[StringName] Released names can be created again") {
+	const String name = "string_name_released";
+	{
+		StringName a = name;
+		CHECK(a == name);
+	}
+	StringName b = name;
+	CHECK(b == name);
+	CHECK(b == StringName(name));
+}
+
+#ifdef THREADS_ENABLED
+struct StressData {
+	static const int NAME_COUNT = 256;
+
+	LocalVector<String> strings;
+	LocalVector<StringName> canonical;
+	SafeNumeric<uint32_t> mismatches;
+	int iterations = 0;
+
+	// Every other name is only referenced by the threads, so its refcount
+	// keeps dropping to zero while other threads look it up.
+	void run(uint32_t p_thread) {
+		for (int i = 0; i < iterations; i++) {
+			const int index = (i * 7 + p_thread * 13) % NAME_COUNT;
+			const StringName name = strings[index];
+			if (index % 2 == 0) {
+				if (name != canonical[index / 2]) {
+					mismatches.increment();
+				}
+			} else if (name.string() != strings[index] || name.hash() != strings[index].hash()) {
+				mismatches.increment();
+			}
+		}
+	}
+
+	StressData(int p_iterations) {
+		iterations = p_iterations;
+		for (int i = 0; i < NAME_COUNT; i++) {
+			strings.push_back(vformat("string_name_stress_%d", i));
+			if (i % 2 == 0) {
+				canonical.push_back(strings[i]);
+			}
+		}
+	}
+};
+
+static uint64_t run_stress(StressData &p_data, uint32_t p_thread_count) {
+	TightLocalVector<Thread> threads;
+	threads.resize(p_thread_count);
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		threads[i].start(
+				[](void *p_userdata) {
+					StressData *data = (StressData *)p_userdata;
+					data->run(Thread::get_caller_id() % 64);
+				},
+				&p_data);
+	}
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		threads[i].wait_to_finish();
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+TEST_CASE("[StringName] Creating and releasing names from many threads") {
+	StressData data(50000);
+	run_stress(data, MAX(4, OS::get_singleton()->get_processor_count()));
+	CHECK(data.mismatches.get() == 0);
+}
+
+BENCHMARK_CASE("[StringName][Benchmark] Scaling of lookups with thread count") {
+	const uint32_t max_threads = OS::get_singleton()->get_processor_count();
+	const int iterations = 2000000;
+	for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		// Same amount of work per thread, so perfect scaling keeps the time constant.
+		StressData data(iterations);
+		const uint64_t usec = TestBenchmark::measure_usec([&]() { run_stress(data, thread_count); }, 1);
+		CHECK(data.mismatches.get() == 0);
+		TestBenchmark::report(vformat("%d threads", thread_count), usec, double(iterations) * thread_count);
+	}
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestStringName
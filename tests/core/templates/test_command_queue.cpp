@@ -37,6 +37,7 @@ TEST_FORCE_LINK(test_command_queue)
 #include "core/os/os.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "tests/test_benchmark.h"
 
 namespace TestCommandQueue {
 
@@ -519,4 +520,119 @@ TEST_CASE("[CommandQueue] Test Parameter Passing Semantics") {
 	sts.destroy_threads();
 }
 
+#ifdef THREADS_ENABLED
+// Several producer threads push at once while a reader thread keeps flushing.
+// Commands from each producer must run in push order, and a command must never
+// run before one whose push had already returned when it was pushed.
+class MultiProducerState {
+public:
+	static constexpr uint32_t MAX_PRODUCERS = 64;
+
+	CommandQueueMT command_queue;
+	LocalVector<Thread> producer_threads;
+	Thread reader_thread;
+	uint32_t commands_per_producer = 0;
+	SafeNumeric<uint32_t> next_producer_idx;
+	std::atomic<bool> producing = false;
+	std::atomic<uint64_t> pushes_returned = 0;
+
+	// Only touched by commands, which run one at a time.
+	uint64_t executed = 0;
+	uint32_t last_seq[MAX_PRODUCERS] = {};
+	int errors = 0;
+	SafeNumeric<uint32_t> ret_errors;
+
+	void command(uint32_t p_producer, uint32_t p_seq, uint64_t p_pushes_before, Transform3D p_transform) {
+		if (p_seq != last_seq[p_producer] + 1 || executed < p_pushes_before || p_transform.origin.x != p_seq) {
+			errors++;
+		}
+		last_seq[p_producer] = p_seq;
+		executed++;
+	}
+
+	uint32_t command_ret(uint32_t p_value) {
+		executed++;
+		return p_value + 1;
+	}
+
+	static void producer_func(void *p_userdata) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_userdata);
+		const uint32_t producer_idx = state->next_producer_idx.postincrement();
+		Transform3D transform;
+		for (uint32_t seq = 1; seq <= state->commands_per_producer; seq++) {
+			const uint64_t pushes_before = state->pushes_returned.load();
+			transform.origin.x = seq;
+			state->command_queue.push(state, &MultiProducerState::command, producer_idx, seq, pushes_before, transform);
+			state->pushes_returned.fetch_add(1);
+			if (seq % 1000 == 0) {
+				uint32_t ret = 0;
+				state->command_queue.push_and_ret(state, &MultiProducerState::command_ret, &ret, seq);
+				if (ret != seq + 1) {
+					state->ret_errors.increment();
+				}
+				state->pushes_returned.fetch_add(1);
+			}
+		}
+	}
+
+	static void reader_func(void *p_userdata) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_userdata);
+		while (state->producing.load()) {
+			state->command_queue.flush_all();
+			Thread::yield();
+		}
+		state->command_queue.flush_all();
+	}
+
+	void run(uint32_t p_producer_count, uint32_t p_commands_per_producer) {
+		commands_per_producer = p_commands_per_producer;
+		next_producer_idx.set(0);
+		for (uint32_t i = 0; i < MAX_PRODUCERS; i++) {
+			last_seq[i] = 0;
+		}
+
+		producing.store(true);
+		reader_thread.start(&MultiProducerState::reader_func, this);
+		producer_threads.resize(p_producer_count);
+		for (Thread &thread : producer_threads) {
+			thread.start(&MultiProducerState::producer_func, this);
+		}
+		for (Thread &thread : producer_threads) {
+			thread.wait_to_finish();
+		}
+		producing.store(false);
+		reader_thread.wait_to_finish();
+	}
+};
+
+TEST_CASE("[CommandQueue] Multiple producers keep push order") {
+	MultiProducerState state;
+	const uint32_t producer_count = CLAMP(OS::get_singleton()->get_processor_count(), 2, (int)MultiProducerState::MAX_PRODUCERS);
+	const uint32_t commands_per_producer = 5000;
+	state.run(producer_count, commands_per_producer);
+
+	CHECK(state.errors == 0);
+	CHECK(state.ret_errors.get() == 0);
+	// Every producer also pushes one command with a return value per thousand commands.
+	CHECK(state.executed == uint64_t(producer_count) * (commands_per_producer + commands_per_producer / 1000));
+	for (uint32_t i = 0; i < producer_count; i++) {
+		CHECK(state.last_seq[i] == commands_per_producer);
+	}
+}
+
+BENCHMARK_CASE("[CommandQueue][Benchmark] Commands per second with multiple producers") {
+	const uint32_t commands_per_producer = 100000;
+	for (uint32_t producer_count : { 1, 4, 16 }) {
+		int errors = 0;
+		const uint64_t usec = TestBenchmark::measure_usec([&]() {
+			MultiProducerState state;
+			state.run(producer_count, commands_per_producer);
+			errors += state.errors + state.ret_errors.get();
+		});
+		TestBenchmark::report(vformat("%d producers", producer_count), usec, double(producer_count) * commands_per_producer);
+		CHECK(errors == 0);
+	}
+}
+#endif // THREADS_ENABLED
+
 } // namespace TestCommandQueue
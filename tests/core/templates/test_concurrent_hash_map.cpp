@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*  test_concurrent_hash_map.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_concurrent_hash_map)
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/concurrent_hash_map.h"
+
+namespace TestConcurrentHashMap {
+
+TEST_CASE("[ConcurrentHashMap] Insert, replace and erase") {
+	ConcurrentHashMap<int, int> map;
+	CHECK(map.is_empty());
+	CHECK(!map.has(1));
+
+	map.insert(1, 10);
+	map.insert(2, 20);
+	map.insert(1, 30);
+	CHECK(map.size() == 2);
+
+	int value = 0;
+	CHECK(map.lookup(1, value));
+	CHECK(value == 30);
+	CHECK(!map.lookup(3, value));
+
+	CHECK(!map.erase_if(2, [](int p_value) { return p_value == 21; }));
+	CHECK(map.erase_if(2, [](int p_value) { return p_value == 20; }));
+	CHECK(!map.has(2));
+	CHECK(map.erase(1));
+	CHECK(!map.erase(1));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[ConcurrentHashMap] Lookup with another key type") {
+	ConcurrentHashMap<String, int> map;
+	map.insert("hello", 1);
+	CHECK(map.has("hello"));
+	CHECK(!map.has("world"));
+	CHECK(map.has(String("hello")));
+}
+
+TEST_CASE("[ConcurrentHashMap] Find or insert") {
+	ConcurrentHashMap<int, int> map;
+	const auto accept_positive = [](int &p_value) { return p_value > 0; };
+
+	int *value = map.find_or_insert(7, accept_positive, [](int &r_value) { r_value = -1; });
+	CHECK(*value == -1);
+	CHECK(map.size() == 1);
+
+	// The rejected element is kept, and the new one is found first.
+	int *value2 = map.find_or_insert(7, accept_positive, [](int &r_value) { r_value = 5; });
+	CHECK(value2 != value);
+	CHECK(*value2 == 5);
+	CHECK(map.size() == 2);
+	CHECK(map.find_or_insert(7, accept_positive, [](int &r_value) { r_value = 9; }) == value2);
+
+	int found = 0;
+	CHECK(map.lookup(7, found));
+	CHECK(found == 5);
+
+	// Values don't move while other elements come and go.
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i + 100, i);
+	}
+	CHECK(*value == -1);
+	CHECK(map.erase_if(7, [value](const int &p_value) { return &p_value == value; }));
+	CHECK(*value2 == 5);
+	CHECK(map.size() == 1001);
+}
+
+TEST_CASE("[ConcurrentHashMap] Many elements") {
+	ConcurrentHashMap<int, int> map;
+	for (int i = 0; i < 10000; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == 10000);
+
+	bool all_found = true;
+	for (int i = 0; i < 10000; i++) {
+		int value = 0;
+		all_found &= map.lookup(i, value) && value == i * 2;
+	}
+	CHECK(all_found);
+
+	for (int i = 0; i < 10000; i += 2) {
+		map.erase(i);
+	}
+	CHECK(map.size() == 5000);
+
+	uint32_t count = 0;
+	bool all_odd = true;
+	map.for_each([&](const int &p_key, int &p_value) {
+		count++;
+		all_odd &= p_key % 2 == 1 && p_value == p_key * 2;
+	});
+	CHECK(count == 5000);
+	CHECK(all_odd);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(1));
+}
+
+#ifdef THREADS_ENABLED
+TEST_CASE("[ConcurrentHashMap] Readers see consistent values while writers churn") {
+	static const int KEY_COUNT = 2000;
+	static const int ROUNDS = 20;
+
+	struct ChurnTester {
+		ConcurrentHashMap<int, int> map;
+		SafeFlag writers_done;
+		SafeNumeric<uint32_t> bad_reads;
+		SafeNumeric<uint32_t> writers_left;
+	};
+
+	ChurnTester tester;
+	for (int i = 0; i < KEY_COUNT; i++) {
+		tester.map.insert(i, i * 3);
+	}
+
+	// Writers only ever store `key * 3`, so readers can check every value they find.
+	TightLocalVector<Thread> threads;
+	threads.resize(MAX(4, OS::get_singleton()->get_processor_count()));
+	tester.writers_left.set(threads.size() / 2);
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (i % 2 == 0) {
+			threads[i].start(
+					[](void *p_data) {
+						ChurnTester *ct = (ChurnTester *)p_data;
+						for (int round = 0; round < ROUNDS; round++) {
+							for (int key = 0; key < KEY_COUNT; key++) {
+								if ((key + round) % 3 == 0) {
+									ct->map.erase(key);
+								} else {
+									ct->map.insert(key, key * 3);
+								}
+							}
+						}
+						if (ct->writers_left.decrement() == 0) {
+							ct->writers_done.set();
+						}
+					},
+					&tester);
+		} else {
+			threads[i].start(
+					[](void *p_data) {
+						ChurnTester *ct = (ChurnTester *)p_data;
+						while (!ct->writers_done.is_set()) {
+							for (int key = 0; key < KEY_COUNT; key++) {
+								int value = 0;
+								if (ct->map.lookup(key, value) && value != key * 3) {
+									ct->bad_reads.increment();
+								}
+							}
+						}
+					},
+					&tester);
+		}
+	}
+
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK(tester.bad_reads.get() == 0);
+	uint32_t count = 0;
+	tester.map.for_each([&count](const int &p_key, int &p_value) {
+		count++;
+	});
+	CHECK(count == tester.map.size());
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestConcurrentHashMap
@@ -37,6 +37,7 @@ TEST_FORCE_LINK(test_rid)
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
+#include "tests/test_benchmark.h"
 
 #ifdef TSAN_ENABLED
 #include <sanitizer/tsan_interface.h>
@@ -105,7 +106,89 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
 
+TEST_CASE("[RID_Owner] Thread-safe allocation and counting") {
+	RID_Owner<uint64_t, true> owner;
+	LocalVector<RID> rids;
+	for (uint64_t i = 0; i < 100; i++) {
+		rids.push_back(owner.make_rid(i));
+	}
+	CHECK(owner.get_rid_count() == 100);
+
+	for (uint32_t i = 0; i < rids.size(); i += 2) {
+		owner.free(rids[i]);
+	}
+	CHECK(owner.get_rid_count() == 50);
+	CHECK(owner.get_owned_list().size() == 50);
+
+	bool ok = true;
+	for (uint32_t i = 0; i < rids.size(); i++) {
+		const bool freed = i % 2 == 0;
+		uint64_t *value = owner.get_or_null(rids[i]);
+		if (owner.owns(rids[i]) == freed || (value == nullptr) != freed || (value && *value != i)) {
+			ok = false;
+		}
+	}
+	CHECK(ok);
+
+	// Reused slots must not validate the RIDs previously stored in them.
+	LocalVector<RID> new_rids;
+	for (uint64_t i = 0; i < 50; i++) {
+		new_rids.push_back(owner.make_rid(i));
+	}
+	CHECK(owner.get_rid_count() == 100);
+	for (uint32_t i = 0; i < rids.size(); i += 2) {
+		CHECK_FALSE(owner.owns(rids[i]));
+	}
+
+	for (uint32_t i = 1; i < rids.size(); i += 2) {
+		owner.free(rids[i]);
+	}
+	for (const RID &rid : new_rids) {
+		owner.free(rid);
+	}
+	CHECK(owner.get_rid_count() == 0);
+}
+
 #ifdef THREADS_ENABLED
+static void allocate_and_free_rids(void *p_userdata) {
+	RID_Owner<uint32_t, true> *owner = (RID_Owner<uint32_t, true> *)p_userdata;
+	LocalVector<RID> rids;
+	for (uint32_t i = 0; i < 32; i++) {
+		rids.push_back(owner->make_rid(i));
+	}
+	// Most of these stay in this thread's cache.
+	for (const RID &rid : rids) {
+		owner->free(rid);
+	}
+}
+
+TEST_CASE("[RID_Owner] Indices cached by other threads are reused at the limit") {
+	// 16 elements per chunk, and room for 3 chunks.
+	RID_Owner<uint32_t, true> owner(16 * sizeof(uint32_t), 32);
+	const uint32_t capacity = 48;
+
+	Thread thread;
+	thread.start(&allocate_and_free_rids, &owner);
+	thread.wait_to_finish();
+	CHECK(owner.get_rid_count() == 0);
+
+	LocalVector<RID> rids;
+	for (uint32_t i = 0; i < capacity; i++) {
+		rids.push_back(owner.make_rid(i));
+	}
+	bool all_valid = true;
+	for (const RID &rid : rids) {
+		all_valid = all_valid && rid.is_valid();
+	}
+	CHECK(all_valid);
+	CHECK(owner.get_rid_count() == capacity);
+
+	for (const RID &rid : rids) {
+		owner.free(rid);
+	}
+	CHECK(owner.get_rid_count() == 0);
+}
+
 // This case would let sanitizers realize data races.
 // Additionally, on purely weakly ordered architectures, it would detect synchronization issues
 // if RID_Alloc failed to impose proper memory ordering and the test's threads are distributed
@@ -241,6 +324,112 @@ TEST_CASE("[RID_Owner] Thread safety") {
 		tester.test();
 	}
 }
+
+// Each thread repeatedly creates a batch of RIDs, checks them, hands half of
+// them to the next thread to free and frees the other half itself.
+struct RIDChurnTester {
+	static constexpr uint32_t BATCH_SIZE = 64;
+
+	RID_Owner<uint64_t, true> rid_owner;
+	LocalVector<Thread> threads;
+	LocalVector<std::atomic<uint64_t>> handoff;
+	uint32_t rounds = 0;
+	SafeNumeric<uint32_t> next_thread_idx;
+	SafeNumeric<uint32_t> errors;
+
+	static void _thread_func(void *p_userdata) {
+		RIDChurnTester *tester = (RIDChurnTester *)p_userdata;
+		const uint32_t thread_idx = tester->next_thread_idx.postincrement();
+		const uint32_t thread_count = tester->threads.size();
+		const uint32_t next_idx = (thread_idx + 1) % thread_count;
+		RID rids[BATCH_SIZE];
+
+		for (uint32_t round = 0; round < tester->rounds; round++) {
+			for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+				rids[i] = tester->rid_owner.make_rid((uint64_t(thread_idx) << 32) | i);
+			}
+			for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+				uint64_t *value = tester->rid_owner.get_or_null(rids[i]);
+				if (!value || *value != ((uint64_t(thread_idx) << 32) | i)) {
+					tester->errors.increment();
+				}
+			}
+			for (uint32_t i = 0; i < BATCH_SIZE / 2; i++) {
+				tester->handoff[thread_idx * BATCH_SIZE / 2 + i].store(rids[i].get_id(), std::memory_order_release);
+			}
+			for (uint32_t i = BATCH_SIZE / 2; i < BATCH_SIZE; i++) {
+				tester->rid_owner.free(rids[i]);
+				if (tester->rid_owner.get_or_null(rids[i])) {
+					tester->errors.increment();
+				}
+			}
+			// Free what the next thread handed over, waiting for it if needed.
+			for (uint32_t i = 0; i < BATCH_SIZE / 2; i++) {
+				std::atomic<uint64_t> &slot = tester->handoff[next_idx * BATCH_SIZE / 2 + i];
+				uint64_t id;
+				while ((id = slot.exchange(0, std::memory_order_acquire)) == 0) {
+					Thread::yield();
+				}
+				tester->rid_owner.free(RID::from_uint64(id));
+			}
+			// Don't start the next round until our own slots have been emptied.
+			for (uint32_t i = 0; i < BATCH_SIZE / 2; i++) {
+				while (tester->handoff[thread_idx * BATCH_SIZE / 2 + i].load(std::memory_order_acquire) != 0) {
+					Thread::yield();
+				}
+			}
+		}
+	}
+
+	void run(uint32_t p_thread_count) {
+		next_thread_idx.set(0);
+		threads.resize(p_thread_count);
+		handoff.resize(p_thread_count * BATCH_SIZE / 2);
+		for (std::atomic<uint64_t> &slot : handoff) {
+			slot.store(0, std::memory_order_relaxed);
+		}
+
+		for (Thread &thread : threads) {
+			thread.start(_thread_func, this);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+
+	explicit RIDChurnTester(uint32_t p_rounds) :
+			rounds(p_rounds) {}
+};
+
+TEST_CASE("[RID_Owner] Concurrent creation and freeing") {
+	RIDChurnTester tester(200);
+	const uint32_t thread_count = MAX(2, OS::get_singleton()->get_processor_count());
+	tester.run(thread_count);
+	CHECK(tester.errors.get() == 0);
+	CHECK(tester.rid_owner.get_rid_count() == 0);
+
+	// All slots went back to the free lists, so the owner can be filled up again.
+	LocalVector<RID> rids;
+	for (uint32_t i = 0; i < thread_count * RIDChurnTester::BATCH_SIZE; i++) {
+		rids.push_back(tester.rid_owner.make_rid(i));
+	}
+	CHECK(tester.rid_owner.get_rid_count() == rids.size());
+	for (const RID &rid : rids) {
+		tester.rid_owner.free(rid);
+	}
+}
+
+BENCHMARK_CASE("[RID_Owner][Benchmark] RID creation and freeing per second") {
+	const uint32_t rounds = 5000;
+	RIDChurnTester tester(rounds);
+	const uint32_t max_threads = OS::get_singleton()->get_processor_count();
+	for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		const uint64_t usec = TestBenchmark::measure_usec([&]() { tester.run(thread_count); });
+		TestBenchmark::report(vformat("%d threads", thread_count), usec, double(rounds) * RIDChurnTester::BATCH_SIZE * thread_count);
+	}
+	CHECK(tester.errors.get() == 0);
+	CHECK(tester.rid_owner.get_rid_count() == 0);
+}
 #endif // THREADS_ENABLED
 
 } // namespace TestRID
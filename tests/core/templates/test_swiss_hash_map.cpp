@@ -0,0 +1,257 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_swiss_hash_map)
+
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/swiss_hash_map.h"
+#include "tests/test_benchmark.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] Group matching") {
+	uint8_t ctrl[SwissHashMapGroup::SIZE];
+	for (uint32_t i = 0; i < SwissHashMapGroup::SIZE; i++) {
+		ctrl[i] = i % 4 == 0 ? SwissHashMapGroup::EMPTY : (i % 4 == 1 ? SwissHashMapGroup::DELETED : 0x2A);
+	}
+	ctrl[15] = 0x7F;
+
+	CHECK(SwissHashMapGroup::match(ctrl, 0x2A) == 0b0100110011001100);
+	CHECK(SwissHashMapGroup::match(ctrl, 0x7F) == 0b1000000000000000);
+	CHECK(SwissHashMapGroup::match(ctrl, 0x00) == 0);
+	CHECK(SwissHashMapGroup::match_empty(ctrl) == 0b0001000100010001);
+	CHECK(SwissHashMapGroup::match_empty_or_deleted(ctrl) == 0b0011001100110011);
+	CHECK(SwissHashMapGroup::lowest_bit_index(0b0100110011001000) == 3);
+}
+
+TEST_CASE("[SwissHashMap] Insert, overwrite and erase") {
+	SwissHashMap<int, int> map{ { 1, 10 }, { 2, 20 }, { 1, 30 } };
+	CHECK(map.size() == 2);
+	CHECK(map[1] == 30);
+
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map.has(42));
+	CHECK(map.getptr(43) == nullptr);
+
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map.erase(1));
+	CHECK(!map.erase(1));
+	CHECK(map.size() == 1);
+	CHECK(map.get(2) == 20);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(2));
+}
+
+TEST_CASE("[SwissHashMap] Insert, iterate and remove many elements") {
+	const int elem_max = 12343;
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+
+	// Insertion order is kept while nothing is erased.
+	int idx = 0;
+	bool in_order = true;
+	for (const KeyValue<int, int> &E : map) {
+		in_order = in_order && E.key == idx && E.value == idx;
+		idx++;
+	}
+	CHECK(in_order);
+	CHECK(idx == elem_max);
+
+	for (int i = 0; i < elem_max; i += 2) {
+		CHECK(map.erase(i));
+	}
+	CHECK(map.size() == elem_max / 2);
+
+	bool lookups = true;
+	for (int i = 0; i < elem_max; i++) {
+		lookups = lookups && map.has(i) == (i % 2 == 1);
+	}
+	CHECK(lookups);
+
+	// Churn through DELETED markers without growing.
+	const uint32_t capacity = map.get_capacity();
+	for (int round = 0; round < 10; round++) {
+		for (int i = 0; i < 1000; i++) {
+			map.insert(elem_max + i, i);
+		}
+		for (int i = 0; i < 1000; i++) {
+			map.erase(elem_max + i);
+		}
+	}
+	CHECK(map.get_capacity() == capacity);
+	CHECK(map.size() == elem_max / 2);
+}
+
+struct CollidingHasher {
+	static uint32_t hash(int p_key) { return (uint32_t)(p_key % 3); }
+};
+
+TEST_CASE("[SwissHashMap] Colliding hashes") {
+	SwissHashMap<int, int, CollidingHasher> map;
+	for (int i = 0; i < 200; i++) {
+		map.insert(i, i * 2);
+	}
+	for (int i = 0; i < 200; i += 3) {
+		map.erase(i);
+	}
+
+	bool lookups = true;
+	for (int i = 0; i < 200; i++) {
+		const int *value = map.getptr(i);
+		lookups = lookups && (i % 3 == 0 ? value == nullptr : (value && *value == i * 2));
+	}
+	CHECK(lookups);
+}
+
+TEST_CASE("[SwissHashMap] Copy, move and strings") {
+	SwissHashMap<String, int> map;
+	for (int i = 0; i < 500; i++) {
+		map.insert(itos(i), i);
+	}
+
+	SwissHashMap<String, int> copy(map);
+	map.erase("7");
+	CHECK(copy.size() == 500);
+	CHECK(copy["7"] == 7);
+	CHECK(map.size() == 499);
+
+	SwissHashMap<String, int> moved(std::move(copy));
+	CHECK(moved.size() == 500);
+	CHECK(moved.get_index("499") == 499);
+	CHECK(copy.is_empty());
+	copy = map;
+	CHECK(copy.size() == 499);
+	CHECK(!copy.has("7"));
+}
+
+// Lookup-heavy patterns found in the engine. Keys are looked up many times more often than inserted.
+template <typename M, typename K>
+static uint64_t benchmark_map_lookups(const LocalVector<K> &p_keys, const LocalVector<K> &p_misses, int p_rounds) {
+	M map;
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		map.insert(p_keys[i], i);
+	}
+
+	uint64_t sum = 0;
+	const uint64_t usec = TestBenchmark::measure_usec([&]() {
+		for (int round = 0; round < p_rounds; round++) {
+			for (const K &key : p_keys) {
+				const uint32_t *value = map.getptr(key);
+				sum += value ? *value : 0;
+			}
+			for (const K &key : p_misses) {
+				sum += map.has(key) ? 1 : 0;
+			}
+		}
+	});
+	CHECK(sum > 0);
+	return usec;
+}
+
+template <typename K, typename H>
+static uint64_t benchmark_set_lookups(const LocalVector<K> &p_keys, const LocalVector<K> &p_misses, int p_rounds) {
+	HashSet<K, H> set;
+	for (const K &key : p_keys) {
+		set.insert(key);
+	}
+
+	uint64_t sum = 0;
+	const uint64_t usec = TestBenchmark::measure_usec([&]() {
+		for (int round = 0; round < p_rounds; round++) {
+			for (const K &key : p_keys) {
+				sum += set.has(key) ? 1 : 0;
+			}
+			for (const K &key : p_misses) {
+				sum += set.has(key) ? 1 : 0;
+			}
+		}
+	});
+	CHECK(sum > 0);
+	return usec;
+}
+
+template <typename K, typename H = HashMapHasherDefault>
+static void benchmark_lookups(const String &p_name, const LocalVector<K> &p_keys, const LocalVector<K> &p_misses, int p_rounds) {
+	const uint64_t swiss = benchmark_map_lookups<SwissHashMap<K, uint32_t, H>>(p_keys, p_misses, p_rounds);
+	const uint64_t ahash = benchmark_map_lookups<AHashMap<K, uint32_t, H>>(p_keys, p_misses, p_rounds);
+	const uint64_t hash = benchmark_map_lookups<HashMap<K, uint32_t, H>>(p_keys, p_misses, p_rounds);
+	const uint64_t set = benchmark_set_lookups<K, H>(p_keys, p_misses, p_rounds);
+	const double lookups = double(p_keys.size() + p_misses.size()) * p_rounds;
+	TestBenchmark::report(p_name + ", SwissHashMap", swiss, lookups);
+	TestBenchmark::report_comparison(p_name + ", AHashMap versus SwissHashMap", ahash, swiss);
+	TestBenchmark::report_comparison(p_name + ", HashMap versus SwissHashMap", hash, swiss);
+	TestBenchmark::report_comparison(p_name + ", HashSet versus SwissHashMap", set, swiss);
+}
+
+BENCHMARK_CASE("[SwissHashMap][Benchmark] Lookups compared to other hash containers") {
+	// Property lookups on a StringName-keyed table, e.g. a script's member indices.
+	LocalVector<StringName> properties;
+	LocalVector<StringName> missing_properties;
+	for (int i = 0; i < 48; i++) {
+		properties.push_back(StringName("property_" + itos(i)));
+		missing_properties.push_back(StringName("missing_" + itos(i)));
+	}
+	benchmark_lookups("StringName property lookups", properties, missing_properties, 20000);
+
+	// ClassDB method tables: a few hundred names per class, mostly hits.
+	LocalVector<StringName> methods;
+	LocalVector<StringName> missing_methods;
+	for (int i = 0; i < 400; i++) {
+		methods.push_back(StringName("get_method_" + itos(i)));
+	}
+	for (int i = 0; i < 40; i++) {
+		missing_methods.push_back(StringName("_unknown_" + itos(i)));
+	}
+	benchmark_lookups("ClassDB method tables", methods, missing_methods, 5000);
+
+	// AnimationMixer track caches, keyed by 64-bit track cache IDs that are already hashes.
+	LocalVector<uint64_t> tracks;
+	LocalVector<uint64_t> missing_tracks;
+	for (uint64_t i = 0; i < 2000; i++) {
+		tracks.push_back(hash_murmur3_one_64(i));
+		missing_tracks.push_back(hash_murmur3_one_64(i + 1000000));
+	}
+	benchmark_lookups<uint64_t, HashHasher>("AnimationMixer track maps", tracks, missing_tracks, 1000);
+}
+
+} // namespace TestSwissHashMap
@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_work_stealing_deque)
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/work_stealing_deque.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops LIFO, thieves steal FIFO") {
+	WorkStealingDeque<uint64_t, 8> deque;
+	CHECK(deque.is_empty());
+
+	for (uint64_t i = 1; i <= 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK(deque.size() == 4);
+
+	uint64_t value = 0;
+	CHECK(deque.pop(value));
+	CHECK(value == 4);
+	CHECK(deque.steal(value));
+	CHECK(value == 1);
+	CHECK(deque.pop(value));
+	CHECK(value == 3);
+	CHECK(deque.steal(value));
+	CHECK(value == 2);
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<uint64_t, 4> deque;
+	for (uint64_t i = 0; i < deque.get_capacity(); i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.push(100));
+
+	uint64_t value = 0;
+	CHECK(deque.steal(value));
+	CHECK(value == 0);
+	CHECK(deque.push(100));
+	CHECK(deque.pop(value));
+	CHECK(value == 100);
+}
+
+#ifdef THREADS_ENABLED
+TEST_CASE("[WorkStealingDeque] Every element is taken exactly once under contention") {
+	static const uint32_t ELEMENT_COUNT = 100000;
+
+	struct StealTester {
+		WorkStealingDeque<uint32_t, 64> deque;
+		LocalVector<SafeNumeric<uint32_t>> taken;
+		SafeFlag owner_done;
+
+		void take(uint32_t p_value) {
+			taken[p_value].increment();
+		}
+	};
+
+	StealTester tester;
+	tester.taken.resize(ELEMENT_COUNT);
+
+	uint32_t thief_count = MAX(2, OS::get_singleton()->get_processor_count() - 1);
+	TightLocalVector<Thread> thieves;
+	thieves.resize(thief_count);
+	for (uint32_t i = 0; i < thieves.size(); i++) {
+		thieves[i].start(
+				[](void *p_data) {
+					StealTester *st = (StealTester *)p_data;
+					while (true) {
+						uint32_t value = 0;
+						if (st->deque.steal(value)) {
+							st->take(value);
+						} else if (st->owner_done.is_set() && st->deque.is_empty()) {
+							break;
+						} else {
+							Thread::yield();
+						}
+					}
+				},
+				&tester);
+	}
+
+	// The owner interleaves pushes and pops, so races on the last element happen often.
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		while (!tester.deque.push(i)) {
+			uint32_t value = 0;
+			if (tester.deque.pop(value)) {
+				tester.take(value);
+			}
+		}
+		if (i % 3 == 0) {
+			uint32_t value = 0;
+			if (tester.deque.pop(value)) {
+				tester.take(value);
+			}
+		}
+	}
+	tester.owner_done.set();
+
+	for (uint32_t i = 0; i < thieves.size(); i++) {
+		thieves[i].wait_to_finish();
+	}
+
+	bool all_taken_once = true;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		all_taken_once &= tester.taken[i].get() == 1;
+	}
+	CHECK(all_taken_once);
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestWorkStealingDeque
@@ -32,9 +32,12 @@
 
 TEST_FORCE_LINK(test_worker_thread_pool)
 
+#include "core/math/aabb.h"
 #include "core/object/callable_mp.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
+#include "tests/test_benchmark.h"
 
 namespace TestWorkerThreadPool {
 
@@ -108,6 +111,423 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static SafeNumeric<uint32_t> fork_join_count;
+
+static void static_fork_join_task(void *p_arg) {
+	uintptr_t depth = (uintptr_t)p_arg;
+	fork_join_count.increment();
+	if (depth == 0) {
+		return;
+	}
+
+	// Tasks posted from a pool thread go to its local queue, where it or idle threads pick them up.
+	WorkerThreadPool::TaskID children[2];
+	for (int i = 0; i < 2; i++) {
+		children[i] = WorkerThreadPool::get_singleton()->add_native_task(static_fork_join_task, (void *)(depth - 1), true);
+	}
+	for (int i = 0; i < 2; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(children[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Stress tasks posted from pool threads") {
+	const uintptr_t depth = 10;
+	const uint32_t expected_count = (1u << (depth + 1)) - 1;
+
+	for (int iterations = 0; iterations < 20; iterations++) {
+		fork_join_count.set(0);
+
+		// Several roots at once, so threads run out of their own tasks and have to steal.
+		LocalVector<WorkerThreadPool::TaskID> roots;
+		roots.resize(4);
+		for (uint32_t i = 0; i < roots.size(); i++) {
+			roots[i] = WorkerThreadPool::get_singleton()->add_native_task(static_fork_join_task, (void *)depth, true);
+		}
+		for (uint32_t i = 0; i < roots.size(); i++) {
+			CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(roots[i]) == OK);
+		}
+
+		CHECK(fork_join_count.get() == expected_count * roots.size());
+	}
+}
+
+static constexpr uint32_t LOCAL_CHILD_COUNT = 16;
+static SafeNumeric<int> local_child_threads[LOCAL_CHILD_COUNT];
+static SafeNumeric<uint32_t> local_child_runs;
+
+static void static_local_child_task(void *p_arg) {
+	// Slow enough for idle threads to wake up and steal some of the siblings.
+	OS::get_singleton()->delay_usec(2000);
+	local_child_threads[(uintptr_t)p_arg].set(WorkerThreadPool::get_singleton()->get_thread_index());
+	local_child_runs.increment();
+}
+
+static void static_local_parent_task(void *p_arg) {
+	WorkerThreadPool::TaskID children[LOCAL_CHILD_COUNT];
+	for (uint32_t i = 0; i < LOCAL_CHILD_COUNT; i++) {
+		children[i] = WorkerThreadPool::get_singleton()->add_native_task(static_local_child_task, (void *)(uintptr_t)i, true);
+	}
+	for (uint32_t i = 0; i < LOCAL_CHILD_COUNT; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(children[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Idle threads are woken for tasks posted to a local queue") {
+	// The children are pushed to the parent's local queue without the task mutex.
+	// Other threads only help if that push still notifies the ones waiting.
+	local_child_runs.set(0);
+	const WorkerThreadPool::TaskID parent = WorkerThreadPool::get_singleton()->add_native_task(static_local_parent_task, nullptr, true);
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(parent) == OK);
+
+	CHECK(local_child_runs.get() == LOCAL_CHILD_COUNT);
+	bool several_threads = false;
+	for (uint32_t i = 1; i < LOCAL_CHILD_COUNT; i++) {
+		several_threads = several_threads || local_child_threads[i].get() != local_child_threads[0].get();
+	}
+	if (WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		CHECK(several_threads);
+	}
+}
+
+struct TaskGraphTestData {
+	SafeNumeric<uint32_t> sequence;
+	uint32_t stamps[4] = {};
+	LocalVector<SafeNumeric<uint32_t>> group_counter;
+	SafeNumeric<uint32_t> group_stamp_max;
+
+	void stamp(uint32_t p_index) {
+		stamps[p_index] = sequence.increment();
+	}
+	void group_element(uint32_t p_index, void *p_unused) {
+		group_counter[p_index].increment();
+		group_stamp_max.exchange_if_greater(sequence.increment());
+	}
+};
+
+static void static_graph_stamp_0(void *p_arg) {
+	((TaskGraphTestData *)p_arg)->stamp(0);
+}
+static void static_graph_stamp_1(void *p_arg) {
+	((TaskGraphTestData *)p_arg)->stamp(1);
+}
+static void static_graph_stamp_2(void *p_arg) {
+	((TaskGraphTestData *)p_arg)->stamp(2);
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph runs nodes after their dependencies") {
+	TaskGraphTestData data;
+	data.group_counter.resize(64);
+
+	// 0 -> (1, group) -> 2
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID first = graph.add_native_task(static_graph_stamp_0, &data);
+	WorkerThreadPool::TaskGraph::NodeID middle = graph.add_native_task(static_graph_stamp_1, &data);
+	WorkerThreadPool::TaskGraph::NodeID group = graph.add_template_group_task(&data, &TaskGraphTestData::group_element, nullptr, data.group_counter.size());
+	WorkerThreadPool::TaskGraph::NodeID last = graph.add_native_task(static_graph_stamp_2, &data);
+	graph.add_dependency(middle, first);
+	graph.add_dependency(group, first);
+	graph.add_dependency(last, middle);
+	graph.add_dependency(last, group);
+	CHECK(graph.get_node_count() == 4);
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		data.sequence.set(0);
+		data.group_stamp_max.set(0);
+		for (uint32_t i = 0; i < data.group_counter.size(); i++) {
+			data.group_counter[i].set(0);
+		}
+
+		WorkerThreadPool::TaskID id = WorkerThreadPool::get_singleton()->submit_task_graph(&graph, iterations % 2);
+		REQUIRE(id != WorkerThreadPool::INVALID_TASK_ID);
+		CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(id) == OK);
+		CHECK_FALSE(graph.is_running());
+
+		CHECK(data.stamps[0] == 1);
+		CHECK(data.stamps[1] > data.stamps[0]);
+		CHECK(data.stamps[2] > data.stamps[1]);
+		CHECK(data.stamps[2] > data.group_stamp_max.get());
+		CHECK(data.sequence.get() == 3 + data.group_counter.size());
+
+		bool all_run_once = true;
+		for (uint32_t i = 0; i < data.group_counter.size(); i++) {
+			all_run_once &= data.group_counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph edge cases") {
+	TaskGraphTestData data;
+
+	SUBCASE("Empty graph") {
+		WorkerThreadPool::TaskGraph graph;
+		WorkerThreadPool::TaskID id = WorkerThreadPool::get_singleton()->submit_task_graph(&graph);
+		CHECK(WorkerThreadPool::get_singleton()->is_task_completed(id));
+		CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(id) == OK);
+	}
+
+	SUBCASE("Empty group") {
+		WorkerThreadPool::TaskGraph graph;
+		WorkerThreadPool::TaskGraph::NodeID group = graph.add_template_group_task(&data, &TaskGraphTestData::group_element, nullptr, 0);
+		WorkerThreadPool::TaskGraph::NodeID last = graph.add_native_task(static_graph_stamp_2, &data);
+		graph.add_dependency(last, group);
+		WorkerThreadPool::TaskID id = WorkerThreadPool::get_singleton()->submit_task_graph(&graph);
+		CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(id) == OK);
+		CHECK(data.stamps[2] == 1);
+	}
+
+	SUBCASE("Cycles are rejected") {
+		WorkerThreadPool::TaskGraph graph;
+		WorkerThreadPool::TaskGraph::NodeID a = graph.add_native_task(static_graph_stamp_0, &data);
+		WorkerThreadPool::TaskGraph::NodeID b = graph.add_native_task(static_graph_stamp_1, &data);
+		graph.add_dependency(b, a);
+		graph.add_dependency(a, b);
+		ERR_PRINT_OFF;
+		WorkerThreadPool::TaskID id = WorkerThreadPool::get_singleton()->submit_task_graph(&graph);
+		ERR_PRINT_ON;
+		CHECK(id == WorkerThreadPool::INVALID_TASK_ID);
+		CHECK(data.sequence.get() == 0);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Parallel for covers every element once") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	for (uint32_t elements : { 0u, 1u, 7u, 100u, 4096u, 100003u }) {
+		for (uint32_t grain_size : { 0u, 1u, 16u, 1000u }) {
+			LocalVector<SafeNumeric<uint32_t>> visits;
+			visits.resize(elements);
+			uint32_t chunk_count = pool->get_parallel_for_chunk_count(elements, grain_size);
+			LocalVector<SafeNumeric<uint32_t>> chunk_sizes;
+			chunk_sizes.resize(chunk_count);
+
+			pool->parallel_for(elements, grain_size, [&](uint32_t p_from, uint32_t p_to, uint32_t p_chunk) {
+				chunk_sizes[p_chunk].add(p_to - p_from);
+				for (uint32_t i = p_from; i < p_to; i++) {
+					visits[i].increment();
+				}
+			});
+
+			bool all_visited_once = true;
+			for (uint32_t i = 0; i < elements; i++) {
+				all_visited_once &= visits[i].get() == 1;
+			}
+			CHECK(all_visited_once);
+
+			CHECK(chunk_count <= pool->get_parallel_for_max_chunk_count());
+			bool chunks_respect_grain = true;
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				chunks_respect_grain &= chunk_count == 1 || chunk_sizes[i].get() >= grain_size;
+			}
+			CHECK(chunks_respect_grain);
+		}
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Parallel reduce merges deterministically") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	const uint32_t elements = 100000;
+	LocalVector<float> values;
+	values.resize(elements);
+	for (uint32_t i = 0; i < elements; i++) {
+		values[i] = 1.0f / (1.0f + i % 97);
+	}
+
+	auto sum_range = [&](uint32_t p_from, uint32_t p_to, float &r_partial) {
+		float sum = r_partial;
+		for (uint32_t i = p_from; i < p_to; i++) {
+			sum += values[i];
+		}
+		r_partial = sum;
+	};
+	auto join = [](float &r_into, const float &p_partial) {
+		r_into += p_partial;
+	};
+
+	// Floating-point addition isn't associative, so this only holds if the chunks are always the same and merged in order.
+	float expected = pool->parallel_reduce(elements, 64, 0.0f, sum_range, join);
+	bool always_same = true;
+	for (int iterations = 0; iterations < 50; iterations++) {
+		always_same &= pool->parallel_reduce(elements, 64, 0.0f, sum_range, join) == expected;
+	}
+	CHECK(always_same);
+
+	uint64_t count = pool->parallel_reduce(
+			elements, 1, uint64_t(0), [](uint32_t p_from, uint32_t p_to, uint64_t &r_partial) { r_partial += p_to - p_from; }, [](uint64_t &r_into, const uint64_t &p_partial) { r_into += p_partial; });
+	CHECK(count == elements);
+}
+
+#ifdef THREADS_ENABLED
+static SafeNumeric<uint32_t> submitted_task_count;
+
+static void static_submitted_task(void *p_arg) {
+	submitted_task_count.increment();
+}
+
+// Posts `p_arg` small tasks and waits for them. Called from pool threads, the tasks go to the caller's
+// local queue; called from other threads, they go to the shared queue.
+static void static_submitter(void *p_arg) {
+	const uint32_t count = (uintptr_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_submitted_task, nullptr, true);
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+static void submit_from_pool_threads(uint32_t p_submitters, uint32_t p_tasks_per_submitter) {
+	LocalVector<WorkerThreadPool::TaskID> submitters;
+	submitters.resize(p_submitters);
+	for (uint32_t i = 0; i < p_submitters; i++) {
+		submitters[i] = WorkerThreadPool::get_singleton()->add_native_task(static_submitter, (void *)(uintptr_t)p_tasks_per_submitter, true);
+	}
+	for (uint32_t i = 0; i < p_submitters; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(submitters[i]);
+	}
+}
+
+static void submit_from_other_threads(uint32_t p_submitters, uint32_t p_tasks_per_submitter) {
+	LocalVector<Thread> submitters;
+	submitters.resize(p_submitters);
+	for (Thread &thread : submitters) {
+		thread.start(static_submitter, (void *)(uintptr_t)p_tasks_per_submitter);
+	}
+	for (Thread &thread : submitters) {
+		thread.wait_to_finish();
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Stress many submitters posting to local and shared queues at once") {
+	const uint32_t submitters = MAX(2, WorkerThreadPool::get_singleton()->get_thread_count());
+	const uint32_t tasks_per_submitter = 200;
+
+	for (int iterations = 0; iterations < 10; iterations++) {
+		submitted_task_count.set(0);
+
+		// Pool threads fill their local queues while other threads fill the shared one.
+		Thread other_threads;
+		other_threads.start(
+				[](void *p_userdata) {
+					submit_from_other_threads(*(uint32_t *)p_userdata, tasks_per_submitter);
+				},
+				(void *)&submitters);
+		submit_from_pool_threads(submitters, tasks_per_submitter);
+		other_threads.wait_to_finish();
+
+		CHECK(submitted_task_count.get() == 2 * submitters * tasks_per_submitter);
+	}
+}
+
+BENCHMARK_CASE("[WorkerThreadPool][Benchmark] Many submitters, shared queue versus local queues") {
+	const uint32_t submitters = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+	const uint32_t tasks_per_submitter = 5000;
+
+	// The same tasks, posted by as many threads as the pool has. Outside of the pool every post and
+	// every dequeue goes through the task mutex; inside of it they stay in the per-thread queues.
+	const uint64_t shared_usec = TestBenchmark::measure_usec([&]() {
+		submitted_task_count.set(0);
+		submit_from_other_threads(submitters, tasks_per_submitter);
+	});
+	CHECK(submitted_task_count.get() == submitters * tasks_per_submitter);
+
+	const uint64_t local_usec = TestBenchmark::measure_usec([&]() {
+		submitted_task_count.set(0);
+		submit_from_pool_threads(submitters, tasks_per_submitter);
+	});
+	CHECK(submitted_task_count.get() == submitters * tasks_per_submitter);
+
+	TestBenchmark::report_comparison(vformat("%d submitters, shared queue versus local queues", submitters), shared_usec, local_usec);
+	TestBenchmark::report("Local queues", local_usec, double(submitters) * tasks_per_submitter);
+}
+#endif // THREADS_ENABLED
+
+// A synthetic stand-in for RendererSceneCull::_scene_cull(). Visible instances are clustered at the start of the array
+// and cost more than culled ones, like in a scene where most of what is in view was added first.
+struct CullBenchmarkData {
+	LocalVector<AABB> bounds;
+	Plane planes[6];
+	Vector3 camera;
+	LocalVector<real_t> lod;
+};
+
+static void cull_benchmark_range(CullBenchmarkData &p_data, uint32_t p_from, uint32_t p_to) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const AABB &bounds = p_data.bounds[i];
+		bool visible = true;
+		for (const Plane &plane : p_data.planes) {
+			if (plane.distance_to(bounds.get_support(-plane.normal)) > 0) {
+				visible = false;
+				break;
+			}
+		}
+		if (!visible) {
+			p_data.lod[i] = -1;
+			continue;
+		}
+		real_t lod = 0;
+		for (int j = 0; j < 64; j++) {
+			lod += Math::sqrt(bounds.get_center().distance_squared_to(p_data.camera) + j);
+		}
+		p_data.lod[i] = lod;
+	}
+}
+
+static void cull_benchmark_per_thread(void *p_userdata, uint32_t p_thread) {
+	CullBenchmarkData *data = (CullBenchmarkData *)p_userdata;
+	const uint32_t total = data->bounds.size();
+	const uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	const uint32_t from = p_thread * total / total_threads;
+	const uint32_t to = (p_thread + 1 == total_threads) ? total : ((p_thread + 1) * total / total_threads);
+	cull_benchmark_range(*data, from, to);
+}
+
+BENCHMARK_CASE("[WorkerThreadPool][Benchmark] Scene cull dispatch, one slice per thread versus parallel for") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t thread_count = MAX(1, pool->get_thread_count());
+
+	for (uint32_t instances : { 1000u, 10000u, 100000u }) {
+		CullBenchmarkData data;
+		data.bounds.resize(instances);
+		data.lod.resize(instances);
+		for (uint32_t i = 0; i < instances; i++) {
+			// The first quarter lands inside the unit cube the planes enclose, the rest outside of it.
+			const real_t offset = i < instances / 4 ? 0.0 : 10.0;
+			data.bounds[i] = AABB(Vector3(Math::randf() + offset, Math::randf(), Math::randf()) * 0.9, Vector3(0.1, 0.1, 0.1));
+		}
+		data.planes[0] = Plane(Vector3(-1, 0, 0), 0);
+		data.planes[1] = Plane(Vector3(1, 0, 0), 1);
+		data.planes[2] = Plane(Vector3(0, -1, 0), 0);
+		data.planes[3] = Plane(Vector3(0, 1, 0), 1);
+		data.planes[4] = Plane(Vector3(0, 0, -1), 0);
+		data.planes[5] = Plane(Vector3(0, 0, 1), 1);
+		data.camera = Vector3(0.5, 0.5, -2);
+
+		// Same grain size as RendererSceneCull, with the default threaded cull threshold.
+		const uint32_t grain_size = MAX(1u, MAX(1000u, thread_count) / thread_count);
+
+		const uint64_t before_usec = TestBenchmark::measure_usec([&]() {
+			WorkerThreadPool::GroupID group = pool->add_native_group_task(&cull_benchmark_per_thread, &data, thread_count, -1, true);
+			pool->wait_for_group_task_completion(group);
+		});
+		const uint64_t after_usec = TestBenchmark::measure_usec([&]() {
+			pool->parallel_for(instances, grain_size, [&](uint32_t p_from, uint32_t p_to, uint32_t p_chunk) {
+				cull_benchmark_range(data, p_from, p_to);
+			});
+		});
+
+		uint32_t visible = 0;
+		for (uint32_t i = 0; i < instances; i++) {
+			visible += data.lod[i] >= 0;
+		}
+		CHECK(visible == instances / 4);
+		TestBenchmark::report_comparison(vformat("%d instances, %d threads", instances, thread_count), before_usec, after_usec);
+	}
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
@@ -34,6 +34,7 @@ TEST_FORCE_LINK(test_callable)
 
 #include "core/object/callable_mp.h"
 #include "core/object/class_db.h"
+#include "core/object/message_queue.h"
 #include "core/object/object.h"
 
 namespace TestCallable {
@@ -195,4 +196,82 @@ TEST_CASE("[Callable] Bound and unbound argument count") {
 	memdelete(test_instance);
 }
 
+class TypedCallTarget : public Object {
+	GDCLASS(TypedCallTarget, Object);
+
+public:
+	int calls = 0;
+	int64_t last_value = 0;
+	String last_text;
+
+	void set_values(int p_value, const String &p_text) {
+		calls++;
+		last_value = p_value;
+		last_text = p_text;
+	}
+
+	int64_t get_doubled(int64_t p_value) const {
+		return p_value * 2;
+	}
+
+	static inline int static_calls = 0;
+	static void static_method(float p_value) {
+		static_calls++;
+	}
+};
+
+TEST_CASE("[Callable] Typed calls through ptrcall") {
+	TypedCallTarget target;
+	const Callable set_values = callable_mp(&target, &TypedCallTarget::set_values);
+	const Callable get_doubled = callable_mp(&target, &TypedCallTarget::get_doubled);
+
+	CHECK(set_values.get_ptrcall_signature() == CallablePtrcallSignature<int, String>::get());
+	CHECK(get_doubled.get_ptrcall_signature() == CallablePtrcallSignature<int64_t>::get());
+	CHECK(set_values.get_ptrcall_signature() != get_doubled.get_ptrcall_signature());
+	CHECK(Callable(&target, "set_values").get_ptrcall_signature() == nullptr);
+	CHECK(set_values.bind(1).get_ptrcall_signature() == nullptr);
+
+	SUBCASE("Matching native arguments") {
+		const String text = "native";
+		set_values.call_typed(4, text);
+		CHECK(target.calls == 1);
+		CHECK(target.last_value == 4);
+		CHECK(target.last_text == "native");
+
+		int64_t value = 21;
+		int64_t doubled = 0;
+		const void *args[1] = { &value };
+		get_doubled.ptrcallp(args, &doubled);
+		CHECK(doubled == 42);
+
+		callable_mp_static(&TypedCallTarget::static_method).call_typed(1.5f);
+		CHECK(TypedCallTarget::static_calls == 1);
+	}
+
+	SUBCASE("Other native arguments are converted") {
+		set_values.call_typed(int64_t(5), StringName("converted"));
+		CHECK(target.calls == 1);
+		CHECK(target.last_value == 5);
+		CHECK(target.last_text == "converted");
+	}
+
+	SUBCASE("Deferred calls") {
+		CallQueue queue;
+		queue.push_callable(set_values, 6, String("deferred"));
+		queue.push_callable(set_values, 7.0, "converted");
+		CHECK(target.calls == 0);
+
+		queue.flush();
+		CHECK(target.calls == 2);
+		CHECK(target.last_value == 7);
+		CHECK(target.last_text == "converted");
+
+		// Pending typed calls are released with the queue.
+		queue.push_callable(set_values, 8, String("dropped"));
+		queue.clear();
+		queue.flush();
+		CHECK(target.calls == 2);
+	}
+}
+
 } // namespace TestCallable
@@ -0,0 +1,259 @@
+/**************************************************************************/
+/*  test_packed_array_math.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_packed_array_math)
+
+#include "core/variant/packed_array_math.h"
+#include "core/variant/variant.h"
+#include "tests/test_benchmark.h"
+
+namespace TestPackedArrayMath {
+
+TEST_CASE("[PackedArrayMath] Kernels match scalar results for every stride and size") {
+	const float value[4] = { 1.5f, -2.0f, 3.0f, 0.5f };
+	const float min[4] = { -10.0f, -5.0f, 0.0f, -20.0f };
+	const float max[4] = { 10.0f, 5.0f, 20.0f, 0.0f };
+
+	for (int stride : { 1, 3, 4 }) {
+		// Cover sizes below, at and above the SIMD block sizes.
+		for (int elements = 1; elements < 40; elements++) {
+			const int count = elements * stride;
+			Vector<float> a;
+			Vector<float> b;
+			for (int i = 0; i < count; i++) {
+				a.push_back(float((i * 37) % 101) - 50.0f);
+				b.push_back(float((i * 53) % 97) - 48.0f);
+			}
+
+			Vector<float> r = a;
+			PackedArrayMath::add_repeated(r.ptrw(), value, stride, count);
+			Vector<float> m = a;
+			PackedArrayMath::multiply_repeated(m.ptrw(), value, stride, count);
+			Vector<float> c = a;
+			PackedArrayMath::clamp_repeated(c.ptrw(), min, max, stride, count);
+			Vector<float> l = a;
+			PackedArrayMath::lerp(l.ptrw(), b.ptr(), 0.25f, count);
+
+			bool matches = true;
+			for (int i = 0; i < count; i++) {
+				const int k = i % stride;
+				matches = matches && r[i] == a[i] + value[k];
+				matches = matches && m[i] == a[i] * value[k];
+				matches = matches && c[i] == CLAMP(a[i], min[k], max[k]);
+				matches = matches && l[i] == a[i] + (b[i] - a[i]) * 0.25f;
+			}
+			CHECK_MESSAGE(matches, vformat("Element-wise kernels differ for stride %d and %d elements.", stride, elements));
+
+			float lowest[4];
+			float highest[4];
+			double sum[4];
+			PackedArrayMath::min_repeated(a.ptr(), stride, count, lowest);
+			PackedArrayMath::max_repeated(a.ptr(), stride, count, highest);
+			PackedArrayMath::sum_repeated(a.ptr(), stride, count, sum);
+			for (int k = 0; k < stride; k++) {
+				float expected_lowest = a[k];
+				float expected_highest = a[k];
+				double expected_sum = 0.0;
+				for (int i = k; i < count; i += stride) {
+					expected_lowest = MIN(expected_lowest, a[i]);
+					expected_highest = MAX(expected_highest, a[i]);
+					expected_sum += a[i];
+				}
+				CHECK(lowest[k] == expected_lowest);
+				CHECK(highest[k] == expected_highest);
+				CHECK(sum[k] == expected_sum);
+			}
+		}
+	}
+}
+
+TEST_CASE("[PackedArrayMath] Transform kernel matches Transform3D::xform for every size") {
+	const Transform3D transform(Basis(Vector3(0.5, -1.25, 2), Vector3(3, 0.1, -0.7), Vector3(1.1, 2.2, -3.3)), Vector3(10, -20, 0.25));
+	const float matrix[12] = {
+		0.5f, -1.25f, 2.0f,
+		3.0f, 0.1f, -0.7f,
+		1.1f, 2.2f, -3.3f,
+		10.0f, -20.0f, 0.25f
+	};
+
+	for (int elements = 0; elements < 20; elements++) {
+		Vector<float> a;
+		for (int i = 0; i < elements * 3; i++) {
+			a.push_back(float((i * 37) % 101) - 50.0f + 0.25f * i);
+		}
+		Vector<float> r = a;
+		PackedArrayMath::transform_3d(r.ptrw(), matrix, r.size());
+
+		bool matches = true;
+		for (int i = 0; i < elements; i++) {
+			const Vector3 expected = transform.xform(Vector3(a[3 * i], a[3 * i + 1], a[3 * i + 2]));
+			matches = matches && Vector3(r[3 * i], r[3 * i + 1], r[3 * i + 2]).is_equal_approx(expected);
+		}
+		CHECK_MESSAGE(matches, vformat("Transform kernel differs for %d elements.", elements));
+	}
+}
+
+static bool is_same_float(float p_a, float p_b) {
+	return (Math::is_nan(p_a) && Math::is_nan(p_b)) || p_a == p_b;
+}
+
+TEST_CASE("[PackedArrayMath] Kernels handle NaN like the scalar code wherever it is") {
+	const float min[4] = { -10.0f, NAN, 0.0f, -20.0f };
+	const float max[4] = { 10.0f, 5.0f, NAN, 0.0f };
+
+	for (int stride : { 1, 3, 4 }) {
+		for (int elements = 1; elements < 20; elements++) {
+			const int count = elements * stride;
+			bool matches = true;
+			for (int nan_index = 0; nan_index < count; nan_index++) {
+				Vector<float> a;
+				for (int i = 0; i < count; i++) {
+					a.push_back(i == nan_index ? NAN : float((i * 37) % 101) - 50.0f);
+				}
+
+				Vector<float> c = a;
+				PackedArrayMath::clamp_repeated(c.ptrw(), min, max, stride, count);
+				for (int i = 0; i < count; i++) {
+					matches = matches && is_same_float(c[i], CLAMP(a[i], min[i % stride], max[i % stride]));
+				}
+
+				float lowest[4];
+				float highest[4];
+				PackedArrayMath::min_repeated(a.ptr(), stride, count, lowest);
+				PackedArrayMath::max_repeated(a.ptr(), stride, count, highest);
+				for (int k = 0; k < stride; k++) {
+					float expected_lowest = a[k];
+					float expected_highest = a[k];
+					for (int i = k; i < count; i += stride) {
+						expected_lowest = MIN(expected_lowest, a[i]);
+						expected_highest = MAX(expected_highest, a[i]);
+					}
+					matches = matches && is_same_float(lowest[k], expected_lowest);
+					matches = matches && is_same_float(highest[k], expected_highest);
+				}
+			}
+			CHECK_MESSAGE(matches, vformat("NaN handling differs for stride %d and %d elements.", stride, elements));
+		}
+	}
+}
+
+TEST_CASE("[PackedArrayMath] Bulk methods on packed arrays") {
+	SUBCASE("PackedFloat32Array") {
+		Variant array = PackedFloat32Array({ 1, 2, 3, 4, 5 });
+		array.call("add_value", 1.0);
+		array.call("multiply_array", PackedFloat32Array({ 1, 2, 1, 2, 1 }));
+		CHECK(array == Variant(PackedFloat32Array({ 2, 6, 4, 10, 6 })));
+		array.call("clamp", 3.0, 8.0);
+		CHECK(array == Variant(PackedFloat32Array({ 3, 6, 4, 8, 6 })));
+		CHECK(array.call("min") == Variant(3.0));
+		CHECK(array.call("max") == Variant(8.0));
+		CHECK(array.call("sum") == Variant(27.0));
+		array.call("lerp_array", PackedFloat32Array({ 5, 6, 8, 8, 0 }), 0.5);
+		CHECK(array == Variant(PackedFloat32Array({ 4, 6, 6, 8, 3 })));
+
+		ERR_PRINT_OFF;
+		array.call("add_array", PackedFloat32Array({ 1 }));
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(array == Variant(PackedFloat32Array({ 4, 6, 6, 8, 3 })), "Arrays of different sizes should be left untouched.");
+
+		Variant empty = PackedFloat32Array();
+		CHECK(empty.call("min") == Variant(0.0));
+		CHECK(empty.call("sum") == Variant(0.0));
+	}
+
+	SUBCASE("PackedVector3Array") {
+		Variant array = PackedVector3Array({ Vector3(1, 2, 3), Vector3(-1, 0, 4) });
+		array.call("multiply_value", Vector3(2, 2, 1));
+		array.call("add_value", Vector3(0, 1, 0));
+		CHECK(array == Variant(PackedVector3Array({ Vector3(2, 5, 3), Vector3(-2, 1, 4) })));
+		CHECK(array.call("min") == Variant(Vector3(-2, 1, 3)));
+		CHECK(array.call("max") == Variant(Vector3(2, 5, 4)));
+		CHECK(array.call("sum") == Variant(Vector3(0, 6, 7)));
+
+		const Transform3D transform(Basis().scaled(Vector3(2, 2, 2)), Vector3(1, 0, 0));
+		array.call("transform", transform);
+		CHECK(array == Variant(PackedVector3Array({ Vector3(5, 10, 6), Vector3(-3, 2, 8) })));
+
+		array.call("multiply_scalar", 0.5);
+		CHECK(array == Variant(PackedVector3Array({ Vector3(2.5, 5, 3), Vector3(-1.5, 1, 4) })));
+	}
+
+	SUBCASE("PackedColorArray") {
+		Variant array = PackedColorArray({ Color(0.5, 0.5, 0.5, 1), Color(1, 0, 0.25, 0.5) });
+		array.call("multiply_value", Color(2, 2, 2, 1));
+		array.call("clamp", Color(0, 0, 0, 0), Color(1, 1, 1, 1));
+		CHECK(array == Variant(PackedColorArray({ Color(1, 1, 1, 1), Color(1, 0, 0.5, 0.5) })));
+		CHECK(array.call("min") == Variant(Color(1, 0, 0.5, 0.5)));
+		CHECK(array.call("sum") == Variant(Color(2, 1, 1.5, 1.5)));
+
+		array.call("multiply_scalar", 2.0);
+		CHECK(array == Variant(PackedColorArray({ Color(2, 2, 2, 2), Color(2, 0, 1, 1) })));
+	}
+}
+
+BENCHMARK_CASE("[PackedArrayMath][Benchmark] Bulk operations per second") {
+	const int size = 1 << 20;
+	PackedVector3Array vectors;
+	vectors.resize(size);
+	Vector3 *w = vectors.ptrw();
+	for (int i = 0; i < size; i++) {
+		w[i] = Vector3(i, -i, i * 0.5);
+	}
+	const Vector3 offset(1, 2, 3);
+	const Transform3D transform(Basis(Vector3(0, 1, 0), 0.5), Vector3(1, 2, 3));
+
+	const uint64_t loop_add = TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < size; i++) {
+			w[i] += offset;
+		}
+	});
+	const uint64_t loop_transform = TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < size; i++) {
+			w[i] = transform.xform(w[i]);
+		}
+	});
+
+	Variant array = vectors;
+	vectors = PackedVector3Array();
+	const uint64_t add = TestBenchmark::measure_usec([&]() { array.call("add_value", offset); });
+	TestBenchmark::report_comparison("Element loop versus add_value()", loop_add, add);
+	const uint64_t transformed = TestBenchmark::measure_usec([&]() { array.call("transform", transform); });
+	TestBenchmark::report_comparison("Element loop versus transform()", loop_transform, transformed);
+
+	Vector3 sum;
+	const uint64_t summed = TestBenchmark::measure_usec([&]() { sum = array.call("sum"); });
+	TestBenchmark::report("sum()", summed, size);
+	CHECK(sum.is_finite());
+}
+
+} // namespace TestPackedArrayMath
@@ -32,8 +32,12 @@
 
 TEST_FORCE_LINK(test_variant)
 
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
+#include "tests/test_benchmark.h"
 
 namespace TestVariant {
 
@@ -2466,4 +2470,80 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+#ifdef THREADS_ENABLED
+struct VariantPoolWorkers {
+	int rounds = 0;
+	SafeNumeric<uint32_t> errors;
+	// Variants created on the main thread and destroyed by the workers, one slice each.
+	LocalVector<Variant> handed_over;
+	SafeNumeric<uint32_t> next_slice;
+	uint32_t slice_size = 0;
+
+	void work() {
+		const uint32_t slice = next_slice.postincrement();
+		for (uint32_t i = slice * slice_size; i < (slice + 1) * slice_size; i++) {
+			handed_over[i] = Variant();
+		}
+
+		Variant live[16];
+		for (int i = 0; i < rounds; i++) {
+			Variant &v = live[i % 16];
+			if (v.get_type() == Variant::TRANSFORM3D && Transform3D(v).origin.x != i - 16) {
+				errors.increment();
+			}
+			v = Transform3D(Basis(), Vector3(i, 0, 0));
+			Variant aabb = AABB(Vector3(i, i, i), Vector3(1, 1, 1));
+			Variant projection = Projection();
+			if (AABB(aabb).position.y != i || projection.get_type() != Variant::PROJECTION) {
+				errors.increment();
+			}
+		}
+	}
+
+	static void work_thread(void *p_userdata) {
+		((VariantPoolWorkers *)p_userdata)->work();
+	}
+
+	void run(int p_thread_count) {
+		next_slice.set(0);
+		slice_size = 1000;
+		handed_over.resize(slice_size * p_thread_count);
+		for (uint32_t i = 0; i < handed_over.size(); i++) {
+			handed_over[i] = Transform3D(Basis(), Vector3(i, 0, 0));
+		}
+
+		TightLocalVector<Thread> threads;
+		threads.resize(p_thread_count);
+		for (Thread &thread : threads) {
+			thread.start(&VariantPoolWorkers::work_thread, this);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+};
+
+TEST_CASE("[Variant] Pooled types created and destroyed from several threads") {
+	VariantPoolWorkers workers;
+	workers.rounds = 20000;
+	workers.run(4);
+	CHECK(workers.errors.get() == 0);
+	for (const Variant &v : workers.handed_over) {
+		CHECK(v.get_type() == Variant::NIL);
+	}
+}
+
+BENCHMARK_CASE("[Variant][Benchmark] Pooled Transform3D construction from several threads") {
+	VariantPoolWorkers workers;
+	workers.rounds = 1000000;
+	const uint32_t max_threads = OS::get_singleton()->get_processor_count();
+	for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		const uint64_t usec = TestBenchmark::measure_usec([&]() { workers.run(thread_count); });
+		// Each round creates and destroys a Transform3D, an AABB and a Projection.
+		TestBenchmark::report(vformat("%d threads", thread_count), usec, double(workers.rounds) * 3 * thread_count);
+	}
+	CHECK(workers.errors.get() == 0);
+}
+#endif // THREADS_ENABLED
+
 } // namespace TestVariant
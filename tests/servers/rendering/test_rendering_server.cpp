@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_rendering_server.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_rendering_server)
+
+#include "servers/rendering/rendering_server.h"
+#include "tests/test_tools.h"
+
+namespace TestRenderingServer {
+
+// Returns the IDs of the instances whose bounds overlap a small box around `p_position`.
+static Vector<ObjectID> instances_around(RID p_scenario, const Vector3 &p_position) {
+	return RenderingServer::get_singleton()->instances_cull_aabb(AABB(p_position - Vector3(1, 1, 1), Vector3(2, 2, 2)), p_scenario);
+}
+
+TEST_CASE("[RenderingServer] Bulk instance transforms") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	const RID scenario = rs->scenario_create();
+	const RID mesh = rs->mesh_create();
+
+	// Unit-sized instances at the origin, found by culling around the positions they are moved to.
+	Vector<RID> instances;
+	for (int i = 0; i < 3; i++) {
+		const RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		rs->instance_attach_object_instance_id(instance, ObjectID(uint64_t(i + 1)));
+		instances.push_back(instance);
+	}
+	REQUIRE(instances_around(scenario, Vector3()).size() == 3);
+
+	Vector<Transform3D> transforms;
+	for (int i = 0; i < 3; i++) {
+		transforms.push_back(Transform3D(Basis(), Vector3(10 * (i + 1), 0, 0)));
+	}
+
+	ErrorDetector ed;
+
+	SUBCASE("Transforms are applied per instance") {
+		rs->instances_set_transforms(instances, transforms);
+		CHECK_FALSE(ed.has_error);
+
+		CHECK(instances_around(scenario, Vector3()).is_empty());
+		for (int i = 0; i < 3; i++) {
+			const Vector<ObjectID> found = instances_around(scenario, transforms[i].origin);
+			REQUIRE(found.size() == 1);
+			CHECK(found[0] == ObjectID(uint64_t(i + 1)));
+		}
+	}
+
+	SUBCASE("Arrays of different sizes are rejected") {
+		transforms.resize(2);
+		ERR_PRINT_OFF;
+		rs->instances_set_transforms(instances, transforms);
+		ERR_PRINT_ON;
+		CHECK(ed.has_error);
+		CHECK_MESSAGE(instances_around(scenario, Vector3()).size() == 3, "No instance should have moved.");
+	}
+
+	SUBCASE("Invalid instances are skipped with an error") {
+		Vector<RID> with_invalid = instances;
+		with_invalid.set(1, RID());
+		ERR_PRINT_OFF;
+		rs->instances_set_transforms(with_invalid, transforms);
+		ERR_PRINT_ON;
+		CHECK(ed.has_error);
+
+		const Vector<ObjectID> at_origin = instances_around(scenario, Vector3());
+		REQUIRE(at_origin.size() == 1);
+		CHECK_MESSAGE(at_origin[0] == ObjectID(uint64_t(2)), "The instance left out should not have moved.");
+		CHECK(instances_around(scenario, transforms[0].origin).size() == 1);
+		CHECK(instances_around(scenario, transforms[1].origin).is_empty());
+		CHECK_MESSAGE(instances_around(scenario, transforms[2].origin).size() == 1, "Instances after the invalid one should still be moved.");
+	}
+
+	for (const RID &instance : instances) {
+		rs->free_rid(instance);
+	}
+	rs->free_rid(mesh);
+	rs->free_rid(scenario);
+}
+
+} // namespace TestRenderingServer
@@ -0,0 +1,64 @@
+/**************************************************************************/
+/*  test_benchmark.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "tests/test_macros.h"
+
+#include "core/os/os.h"
+
+// Benchmarks report timings instead of checking behavior, so they are skipped in regular test runs.
+// Run them with `--test --no-skip --test-suite=Benchmark`, preferably on an optimized build.
+#define BENCHMARK_CASE(m_name) TEST_CASE(m_name *doctest::skip() * doctest::test_suite("Benchmark"))
+
+namespace TestBenchmark {
+
+// Runs `p_function` once to warm up, then `p_repeats` more times, and returns the fastest run in microseconds.
+template <typename F>
+uint64_t measure_usec(F &&p_function, int p_repeats = 5) {
+	p_function();
+	uint64_t best = UINT64_MAX;
+	for (int i = 0; i < p_repeats; i++) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		p_function();
+		best = MIN(best, OS::get_singleton()->get_ticks_usec() - begin);
+	}
+	return best;
+}
+
+inline void report(const String &p_label, uint64_t p_usec, double p_operations) {
+	MESSAGE(vformat("%s: %d usec, %.2f million operations per second.", p_label, p_usec, p_operations / MAX(p_usec, (uint64_t)1)));
+}
+
+inline void report_comparison(const String &p_label, uint64_t p_baseline_usec, uint64_t p_usec) {
+	MESSAGE(vformat("%s: %d usec before, %d usec after (%.2fx).", p_label, p_baseline_usec, p_usec, double(p_baseline_usec) / MAX(p_usec, (uint64_t)1)));
+}
+
+} // namespace TestBenchmark